@@ -0,0 +1,24 @@
+#ifndef BENCH_UTIL_HPP
+#define BENCH_UTIL_HPP
+
+#include <chrono>
+#include <cstddef>
+
+// Keeps results alive so the optimizer cannot drop the measured work
+inline volatile long long g_bench_sink = 0;
+
+// Runs fn 'repeat' times and returns the fastest run in seconds
+template <typename Fn>
+double best_of(std::size_t repeat, Fn&& fn) {
+    double best = 1e300;
+    for (std::size_t r = 0; r < repeat; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        best = seconds < best ? seconds : best;
+    }
+    return best;
+}
+
+#endif /* BENCH_UTIL_HPP */
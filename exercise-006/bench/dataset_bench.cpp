@@ -0,0 +1,130 @@
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "point_dataset.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+std::vector<Point<double>> random_points(std::size_t n) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(-1e6, 1e6);
+  std::vector<Point<double>> points(n);
+  for (auto& p : points) p = Point<double>{coord(gen), coord(gen)};
+  return points;
+}
+
+std::string read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+// NDJSON through nlohmann::json documents, one per line
+std::vector<Point<double>> load_ndjson(const std::string& path) {
+  std::ifstream in(path);
+  std::vector<Point<double>> points;
+  for (std::string line; std::getline(in, line);) {
+    const auto j = nlohmann::json::parse(line);
+    points.push_back({j["x"].get<double>(), j["y"].get<double>()});
+  }
+  return points;
+}
+
+// x,y lines with std::from_chars, the fastest text parser at hand
+std::vector<Point<double>> load_csv(const std::string& path) {
+  const std::string text = read_file(path);
+  std::vector<Point<double>> points;
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  while (p < end) {
+    Point<double> point;
+    p = std::from_chars(p, end, point.x).ptr + 1;
+    p = std::from_chars(p, end, point.y).ptr + 1;
+    points.push_back(point);
+  }
+  return points;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Loading points: NDJSON and CSV parsing vs. a memory-mapped dataset"};
+
+  std::size_t count = 1 << 20;
+  std::size_t repeat = 3;
+  app.add_option("-n,--points", count, "Number of points");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  const auto points = random_points(count);
+  const auto dir = std::filesystem::temp_directory_path();
+  const std::string ndjson_path = (dir / "exercise-006-bench.ndjson").string();
+  const std::string csv_path = (dir / "exercise-006-bench.csv").string();
+  const std::string dataset_path = (dir / "exercise-006-bench.pts").string();
+  {
+    std::ofstream ndjson(ndjson_path);
+    std::ofstream csv(csv_path);
+    for (const auto& p : points) {
+      ndjson << fmt::format("{{\"x\":{},\"y\":{}}}\n", p.x, p.y);
+      csv << fmt::format("{},{}\n", p.x, p.y);
+    }
+  }
+  point_dataset::write(dataset_path, points);
+
+  // Every loader ends with the sum of all x, so the mapping is actually read
+  auto sum_x = [](const auto& range) {
+    double sum = 0.0;
+    for (const auto& p : range) sum += p.x;
+    return sum;
+  };
+  const double ndjson_seconds = best_of(repeat, [&] {
+    g_bench_sink = static_cast<long long>(sum_x(load_ndjson(ndjson_path)));
+  });
+  const double csv_seconds = best_of(repeat, [&] {
+    g_bench_sink = static_cast<long long>(sum_x(load_csv(csv_path)));
+  });
+  const double open_seconds = best_of(repeat, [&] {
+    const point_dataset::Dataset data(dataset_path);
+    g_bench_sink = static_cast<long long>(data.points<double>().size());
+  });
+  const double mmap_seconds = best_of(repeat, [&] {
+    const point_dataset::Dataset data(dataset_path);
+    g_bench_sink = static_cast<long long>(sum_x(data.points<double>()));
+  });
+
+  fmt::println("{} points, files in the page cache, best of {} runs\n", count, repeat);
+  fmt::println("{:<22} {:>12} {:>12} {:>10}", "loader", "file MB", "ms", "speedup");
+  auto row = [&](const char* name, const std::string& path, double seconds) {
+    fmt::println("{:<22} {:>12.1f} {:>12.3f} {:>9.1f}x", name,
+                 static_cast<double>(std::filesystem::file_size(path)) / 1e6, seconds * 1e3, ndjson_seconds / seconds);
+  };
+  row("NDJSON (nlohmann)", ndjson_path, ndjson_seconds);
+  row("CSV (from_chars)", csv_path, csv_seconds);
+  row("Dataset open", dataset_path, open_seconds);
+  row("Dataset open + scan", dataset_path, mmap_seconds);
+
+  std::remove(ndjson_path.c_str());
+  std::remove(csv_path.c_str());
+  std::remove(dataset_path.c_str());
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <fmt/format.h>
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "distance_matrix.hpp"
+#include "bench_util.hpp"
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Pairwise distance matrix benchmark"};
+
+  std::size_t points = 4096;
+  std::size_t repeat = 3;
+  std::size_t threads = 0;
+  app.add_option("-n,--points", points, "Number of points, the matrix has n * n entries");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+  app.add_option("-t,--threads", threads, "Worker threads, 0 = one per hardware thread");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+  std::vector<Point<double>> set;
+  set.reserve(points);
+  for (std::size_t i = 0; i < points; ++i) {
+    set.emplace_back(coord(gen), coord(gen));
+  }
+  std::vector<double> matrix(points * points);
+  const double cells = static_cast<double>(points) * static_cast<double>(points);
+
+  const double naive = best_of(repeat, [&] {
+    for (std::size_t i = 0; i < points; ++i) {
+      for (std::size_t j = 0; j < points; ++j) {
+        matrix[i * points + j] = set[i].distance_to(set[j]);
+      }
+    }
+    g_bench_sink = static_cast<long long>(matrix[points + 1]);
+  });
+
+  ThreadPool single(1);
+  ThreadPool all(threads);
+  fmt::println("{} x {} matrix, best of {} runs, million distances per second\n", points, points, repeat);
+  fmt::println("{:<28} {:>12} {:>10}", "variant", "Mdist/s", "speedup");
+  fmt::println("{:<28} {:>12.1f} {:>10.1f}", "distance_to loop", cells / naive / 1e6, 1.0);
+
+  for (bool squared : {false, true}) {
+    for (ThreadPool* pool : {&single, &all}) {
+      DistanceMatrixOptions options;
+      options.squared = squared;
+      options.pool = pool;
+      const double tiled = best_of(repeat, [&] {
+        pairwise_distances(set, matrix.data(), options);
+        g_bench_sink = static_cast<long long>(matrix[points + 1]);
+      });
+      const std::string name =
+        fmt::format("tiled{} {} thread(s)", squared ? " squared" : "", pool->size());
+      fmt::println("{:<28} {:>12.1f} {:>10.1f}", name, cells / tiled / 1e6, naive / tiled);
+    }
+  }
+
+  // Streaming: reduce each tile to its minimum off-diagonal distance, nothing is stored
+  DistanceMatrixOptions options;
+  options.pool = &all;
+  options.upper_triangle = true;
+  const double streamed = best_of(repeat, [&] {
+    std::atomic<long long> tiles{0};
+    for_each_distance_tile(set, [&](const DistanceTile& tile) {
+      double best = 1e300;
+      for (std::size_t i = 0; i < tile.rows; ++i) {
+        for (std::size_t j = 0; j < tile.cols; ++j) {
+          if (tile.row + i < tile.col + j && tile.value(i, j) < best) best = tile.value(i, j);
+        }
+      }
+      tiles += best < 1e300 ? 1 : 0;
+    }, options);
+    g_bench_sink = tiles;
+  });
+  fmt::println("{:<28} {:>12.1f} {:>10.1f}", "streamed upper triangle", cells / streamed / 1e6, naive / streamed);
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "point_expr.hpp"
+#include "thread_pool.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+using Points = std::vector<Point<double>>;
+
+Points random_points(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+  Points points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    points.emplace_back(coord(gen), coord(gen));
+  }
+  return points;
+}
+
+void consume(const Points& points) {
+  g_bench_sink = static_cast<long long>(points.front().x + points.back().y);
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Eager vs. fused Point<T> arithmetic"};
+
+  std::size_t points = 1 << 22;
+  std::size_t repeat = 5;
+  std::size_t threads = 0;
+  app.add_option("-n,--points", points, "Number of points per input batch");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+  app.add_option("-t,--threads", threads, "Threads for parallel_apply (0 = hardware threads)");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  points = points < 1 ? 1 : points;
+  const Points a = random_points(points, 1);
+  const Points b = random_points(points, 2);
+  const Point<double> offset{1.5, -2.0};
+  const Point<double> origin{100.0, 50.0};
+  Points out(points);
+  Points tmp(points);
+
+  // Six operations per point: ((a + b) * 2.5 - offset) * 0.5 + a - origin
+  // Staged: one pass per operation with a buffer in between, as a chain of batch transforms does
+  const double staged = best_of(repeat, [&] {
+    for (std::size_t i = 0; i < points; ++i) tmp[i] = a[i] + b[i];
+    for (std::size_t i = 0; i < points; ++i) out[i] = tmp[i] * 2.5;
+    for (std::size_t i = 0; i < points; ++i) tmp[i] = out[i] - offset;
+    for (std::size_t i = 0; i < points; ++i) out[i] = tmp[i] * 0.5;
+    for (std::size_t i = 0; i < points; ++i) tmp[i] = out[i] + a[i];
+    for (std::size_t i = 0; i < points; ++i) out[i] = tmp[i] - origin;
+    consume(out);
+  });
+
+  // Eager operators per point: a temporary Point per operation
+  const double eager = best_of(repeat, [&] {
+    for (std::size_t i = 0; i < points; ++i) {
+      out[i] = ((a[i] + b[i]) * 2.5 - offset) * 0.5 + a[i] - origin;
+    }
+    consume(out);
+  });
+
+  using namespace expr::placeholders;
+  const auto transform = ((_1 + _2) * 2.5 - offset) * 0.5 + _1 - origin;
+
+  const double fused = best_of(repeat, [&] {
+    expr::apply(transform, out, a, b);
+    consume(out);
+  });
+
+  ThreadPool pool(threads);
+  const double parallel = best_of(repeat, [&] {
+    expr::parallel_apply(pool, transform, out, a, b);
+    consume(out);
+  });
+
+  const double n = static_cast<double>(points);
+  fmt::println("{} points, best of {} runs, {} threads\n", points, repeat, pool.size());
+  fmt::println("{:<24} {:>12} {:>10}", "variant", "ns/point", "speedup");
+  fmt::println("{:<24} {:>12.3f} {:>9.1f}x", "staged (6 passes)", staged / n * 1e9, 1.0);
+  fmt::println("{:<24} {:>12.3f} {:>9.1f}x", "eager operators", eager / n * 1e9, staged / eager);
+  fmt::println("{:<24} {:>12.3f} {:>9.1f}x", "expr::apply", fused / n * 1e9, staged / fused);
+  fmt::println("{:<24} {:>12.3f} {:>9.1f}x", "expr::parallel_apply", parallel / n * 1e9, staged / parallel);
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "json_writer.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+struct Result {
+  Point<int> a;
+  Point<int> b;
+  Point<double> scaled;
+  double distance;
+};
+
+std::vector<Result> random_results(std::size_t n) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> coord(-1000000, 1000000);
+  std::vector<Result> results(n);
+  for (Result& r : results) {
+    r.a = Point<int>{coord(gen), coord(gen)};
+    r.b = Point<int>{coord(gen), coord(gen)};
+    r.scaled = r.a * 2.5;
+    r.distance = r.a.distance_to(r.b);
+  }
+  return results;
+}
+
+// One NDJSON line per result via a nlohmann::json document, as main.cpp used to
+void write_dom(const std::vector<Result>& results, std::string& out) {
+  out.clear();
+  for (const Result& r : results) {
+    nlohmann::json j;
+    j["pointA"] = {{"x", r.a.x}, {"y", r.a.y}};
+    j["pointB"] = {{"x", r.b.x}, {"y", r.b.y}};
+    j["distance"] = r.distance;
+    j["scaled"] = {{"x", r.scaled.x}, {"y", r.scaled.y}};
+    out += j.dump();
+    out += '\n';
+  }
+}
+
+void write_stream(const std::vector<Result>& results, fmt::memory_buffer& out) {
+  out.clear();
+  for (const Result& r : results) {
+    JsonWriter json(out);
+    json.begin_object().field("distance", r.distance).field("pointA", r.a).field("pointB", r.b);
+    json.field("scaled", r.scaled).end_object();
+    out.push_back('\n');
+  }
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"nlohmann::json documents vs. streaming JsonWriter"};
+
+  std::size_t count = 1 << 18;
+  std::size_t repeat = 5;
+  app.add_option("-n,--results", count, "Number of results, one NDJSON line each");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  const auto results = random_results(count);
+  std::string dom;
+  fmt::memory_buffer stream;
+  const double dom_seconds = best_of(repeat, [&] {
+    write_dom(results, dom);
+    g_bench_sink = static_cast<long long>(dom.size());
+  });
+  const double stream_seconds = best_of(repeat, [&] {
+    write_stream(results, stream);
+    g_bench_sink = static_cast<long long>(stream.size());
+  });
+  if (fmt::to_string(stream) != dom) {
+    fmt::println("output differs");
+    return 1;
+  }
+
+  const double n = static_cast<double>(count);
+  fmt::println("{} results, {} bytes, best of {} runs, output identical\n", count, dom.size(), repeat);
+  fmt::println("{:<18} {:>12} {:>14} {:>10}", "writer", "ns/result", "MB/s", "speedup");
+  fmt::println("{:<18} {:>12.1f} {:>14.1f} {:>9.1f}x", "nlohmann dump", dom_seconds / n * 1e9,
+               static_cast<double>(dom.size()) / dom_seconds / 1e6, 1.0);
+  fmt::println("{:<18} {:>12.1f} {:>14.1f} {:>9.1f}x", "JsonWriter", stream_seconds / n * 1e9,
+               static_cast<double>(dom.size()) / stream_seconds / 1e6, dom_seconds / stream_seconds);
+
+  return 0;
+}
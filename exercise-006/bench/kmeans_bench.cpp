@@ -0,0 +1,119 @@
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "kmeans.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Textbook Lloyd iterations: Point::distance_to to every center, then the means
+double naive_lloyd(const std::vector<Point<double>>& points, std::vector<Point<double>> centers,
+                   std::size_t iterations) {
+  std::vector<Point<double>> sums(centers.size());
+  std::vector<std::size_t> counts(centers.size());
+  for (std::size_t it = 0; it < iterations; ++it) {
+    std::fill(sums.begin(), sums.end(), Point<double>{});
+    std::fill(counts.begin(), counts.end(), 0);
+    for (const auto& p : points) {
+      std::size_t best = 0;
+      for (std::size_t j = 1; j < centers.size(); ++j) {
+        if (p.distance_to(centers[j]) < p.distance_to(centers[best])) best = j;
+      }
+      sums[best] = sums[best] + p;
+      ++counts[best];
+    }
+    for (std::size_t j = 0; j < centers.size(); ++j) {
+      if (counts[j] > 0) centers[j] = sums[j] * (1.0 / static_cast<double>(counts[j]));
+    }
+  }
+  return centers[0].x;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"distance_to Lloyd loop vs. kmeans(): ms per iteration per thread count, full and mini-batch"};
+
+  std::size_t count = 1 << 20;
+  std::size_t k = 16;
+  std::size_t iterations = 20;
+  std::size_t batch = 4096;
+  std::size_t repeat = 3;
+  app.add_option("-n,--points", count, "Number of points");
+  app.add_option("-k,--clusters", k, "Number of clusters");
+  app.add_option("-i,--iterations", iterations, "Iterations per run");
+  app.add_option("-b,--batch-size", batch, "Points per mini-batch");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::normal_distribution<double> noise(0.0, 30.0);
+  std::vector<Point<double>> centers(k);
+  for (auto& c : centers) c = {coordinate(gen), coordinate(gen)};
+  std::vector<Point<double>> points(count);
+  for (std::size_t i = 0; i < count; ++i) points[i] = centers[i % k] + Point<double>{noise(gen), noise(gen)};
+  const PointCloud<double> cloud(points.begin(), points.end());
+
+  fmt::println("{} points, k = {}, {} iterations, best of {} runs, kernels: {}\n", count, k, iterations, repeat,
+               cloud_simd::isa_name(cloud_simd::active_isa()));
+  fmt::println("{:<32} {:>8} {:>14} {:>14} {:>10}", "variant", "threads", "ms/iteration", "Mpoints/s", "speedup");
+
+  const std::vector<Point<double>> start(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(k));
+  const double loop_seconds = best_of(repeat, [&] {
+    g_bench_sink = static_cast<long long>(naive_lloyd(points, start, iterations));
+  });
+  const double loop_per_iteration = loop_seconds / static_cast<double>(iterations);
+  auto row = [&](const std::string& name, std::size_t threads, double per_iteration) {
+    fmt::println("{:<32} {:>8} {:>14.3f} {:>14.1f} {:>9.1f}x", name, threads, per_iteration * 1e3,
+                 static_cast<double>(count) / per_iteration / 1e6, loop_per_iteration / per_iteration);
+  };
+  row("Point::distance_to loop", 1, loop_per_iteration);
+
+  // Fixed iteration count; seeding is left out, the final assignment pass is counted (slightly pessimistic)
+  auto cluster = [&](ThreadPool& pool, std::size_t batch_size, KMeansResult& result) {
+    KMeansOptions options;
+    options.k = k;
+    options.max_iterations = iterations;
+    options.tolerance = 0.0;
+    options.max_no_improvement = iterations;
+    options.batch_size = batch_size;
+    options.pool = &pool;
+    double per_iteration = 1e300;
+    for (std::size_t r = 0; r < repeat; ++r) {
+      result = kmeans(cloud, options);
+      per_iteration = std::min(per_iteration, (result.seconds - result.init_seconds) / static_cast<double>(result.iterations));
+    }
+    return per_iteration;
+  };
+
+  const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  KMeansResult full;
+  for (std::size_t threads = 1;; threads = std::min(2 * threads, hardware)) {
+    ThreadPool pool(threads);
+    row("kmeans, Lloyd", threads, cluster(pool, 0, full));
+    if (threads == hardware) break;
+  }
+  ThreadPool pool(hardware);
+  KMeansResult mini;
+  // Mpoints/s counts the whole data set, so it reads as the rate of an equally long Lloyd iteration
+  row(fmt::format("kmeans, mini-batch of {}", batch), hardware, cluster(pool, batch, mini));
+  fmt::println("\nInertia: Lloyd {:.6e}, mini-batch {:.6e} ({:+.2f}%)", full.inertia, mini.inertia,
+               (mini.inertia / full.inertia - 1.0) * 100.0);
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "metric.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Nanoseconds per distance call of Metric over consecutive point pairs
+template <typename Metric, typename T>
+double ns_per_call(const std::vector<Point<T>>& points, std::size_t repeat) {
+  const double seconds = best_of(repeat, [&] {
+    double total = 0;
+    for (std::size_t i = 1; i < points.size(); ++i) {
+      total += distance<Metric>(points[i - 1], points[i]);
+    }
+    g_bench_sink = static_cast<long long>(total);
+  });
+  return seconds / static_cast<double>(points.size() - 1) * 1e9;
+}
+
+template <typename T>
+std::vector<Point<T>> random_points(std::size_t n) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> coord(-1000000, 1000000);
+  std::vector<Point<T>> points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    points.emplace_back(static_cast<T>(coord(gen)), static_cast<T>(coord(gen)));
+  }
+  return points;
+}
+
+template <typename Metric>
+void row(const std::vector<Point<int>>& ints, const std::vector<Point<double>>& doubles, double hypot_int,
+         double hypot_double, std::size_t repeat) {
+  const double i = ns_per_call<Metric>(ints, repeat);
+  const double d = ns_per_call<Metric>(doubles, repeat);
+  fmt::println("{:<12} {:>10.2f} {:>8.1f}x {:>10.2f} {:>8.1f}x", Metric::name, i, hypot_int / i, d, hypot_double / d);
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Distance metric benchmark"};
+
+  std::size_t points = 1 << 22;
+  std::size_t repeat = 5;
+  app.add_option("-n,--points", points, "Number of points, distances are taken between neighbours");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  const auto ints = random_points<int>(points < 2 ? 2 : points);
+  const auto doubles = random_points<double>(points < 2 ? 2 : points);
+  const double hypot_int = ns_per_call<metric::Hypot>(ints, repeat);
+  const double hypot_double = ns_per_call<metric::Hypot>(doubles, repeat);
+
+  fmt::println("{} points, best of {} runs, ns per distance and speedup over hypot\n", points, repeat);
+  fmt::println("{:<12} {:>10} {:>9} {:>10} {:>9}", "metric", "int", "", "double", "");
+  fmt::println("{:<12} {:>10.2f} {:>8.1f}x {:>10.2f} {:>8.1f}x", metric::Hypot::name, hypot_int, 1.0, hypot_double, 1.0);
+  row<metric::Euclidean>(ints, doubles, hypot_int, hypot_double, repeat);
+  row<metric::SquaredEuclidean>(ints, doubles, hypot_int, hypot_double, repeat);
+  row<metric::Manhattan>(ints, doubles, hypot_int, hypot_double, repeat);
+  row<metric::Chebyshev>(ints, doubles, hypot_int, hypot_double, repeat);
+
+  return 0;
+}
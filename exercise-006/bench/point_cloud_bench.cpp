@@ -0,0 +1,78 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "point_cloud.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Per-point Point<T> calls vs. PointCloud<T> batch kernels on both instruction sets
+template <typename T>
+void run(const char* type, std::size_t n, std::size_t repeat) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> coord(-1000000, 1000000);
+  std::vector<Point<T>> points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    points.emplace_back(static_cast<T>(coord(gen)), static_cast<T>(coord(gen)));
+  }
+  PointCloud<T> cloud(points.begin(), points.end());
+  const Point<T> target{T{1}, T{2}};
+  std::vector<double> out(n);
+
+  const double aos_move = best_of(repeat, [&] {
+    for (auto& p : points) p.move(T{1}, T{-1});
+    g_bench_sink = static_cast<long long>(points[n / 2].x);
+  });
+  const double aos_distance = best_of(repeat, [&] {
+    for (std::size_t i = 0; i < n; ++i) out[i] = points[i].distance_to(target);
+    g_bench_sink = static_cast<long long>(out[n / 2]);
+  });
+  fmt::println("{:<8} {:<14} {:>10.1f} {:>12.1f}", type, "Point<T> loop", n / aos_move / 1e6, n / aos_distance / 1e6);
+
+  for (cloud_simd::Isa isa : {cloud_simd::Isa::Scalar, cloud_simd::Isa::AVX2}) {
+    if (cloud_simd::force_isa(isa) != isa) continue;
+    const double move = best_of(repeat, [&] {
+      cloud.move(T{1}, T{-1});
+      g_bench_sink = static_cast<long long>(cloud.xs()[n / 2]);
+    });
+    const double distance = best_of(repeat, [&] {
+      cloud.distances_to(target, out.data());
+      g_bench_sink = static_cast<long long>(out[n / 2]);
+    });
+    fmt::println("{:<8} {:<14} {:>10.1f} {:>12.1f}", type, fmt::format("cloud {}", cloud_simd::isa_name(isa)),
+                 n / move / 1e6, n / distance / 1e6);
+  }
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"PointCloud<T> benchmark"};
+
+  std::size_t points = 1 << 22;
+  std::size_t repeat = 10;
+  app.add_option("-n,--points", points, "Number of points");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  fmt::println("{} points, best of {} runs, million points per second\n", points, repeat);
+  fmt::println("{:<8} {:<14} {:>10} {:>12}", "type", "variant", "move", "distance");
+  run<int>("int", points, repeat);
+  run<float>("float", points, repeat);
+  run<double>("double", points, repeat);
+
+  return 0;
+}
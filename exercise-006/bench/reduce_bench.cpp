@@ -0,0 +1,121 @@
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "point_reduce.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// The hand-rolled loops the reductions replace
+
+Point<double> serial_centroid(const std::vector<Point<double>>& points) {
+  Point<double> sum{};
+  for (const auto& p : points) sum = sum + p;
+  return sum * (1.0 / static_cast<double>(points.size()));
+}
+
+double serial_box(const std::vector<Point<double>>& points) {
+  Point<double> lo = points[0], hi = points[0];
+  for (const auto& p : points) {
+    lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+    hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+  }
+  return hi.x - lo.x;
+}
+
+std::size_t serial_farthest(const std::vector<Point<double>>& points, const Point<double>& from) {
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    if (points[i].distance_to(from) > points[best].distance_to(from)) best = i;
+  }
+  return best;
+}
+
+// All pairs with distance_to; only feasible for small n
+double serial_closest(const std::vector<Point<double>>& points) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = i + 1; j < points.size(); ++j) best = std::min(best, points[i].distance_to(points[j]));
+  }
+  return best;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Serial operator+ / distance_to loops vs. parallel reductions per thread count"};
+
+  std::size_t count = 1 << 22;
+  std::size_t pairs = 1 << 14;
+  std::size_t repeat = 3;
+  app.add_option("-n,--points", count, "Number of points");
+  app.add_option("-p,--pair-points", pairs, "Number of points for the O(n^2) closest pair loop");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coordinate(-1e6, 1e6);
+  std::vector<Point<double>> points(count);
+  for (auto& p : points) p = {coordinate(gen), coordinate(gen)};
+  const std::vector<Point<double>> few(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(std::min(pairs, count)));
+  const Point<double> from{2e6, 0.0};
+
+  fmt::println("{} points ({} for closest pair), best of {} runs\n", count, few.size(), repeat);
+  fmt::println("{:<28} {:>8} {:>12} {:>10}", "reduction", "threads", "ms", "speedup");
+
+  auto row = [&](const std::string& name, std::size_t threads, double seconds, double baseline) {
+    fmt::println("{:<28} {:>8} {:>12.3f} {:>9.1f}x", name, threads, seconds * 1e3, baseline / seconds);
+  };
+
+  const double centroid_loop = best_of(repeat, [&] { g_bench_sink = static_cast<long long>(serial_centroid(points).x); });
+  const double box_loop = best_of(repeat, [&] { g_bench_sink = static_cast<long long>(serial_box(points)); });
+  const double farthest_loop = best_of(repeat, [&] { g_bench_sink = static_cast<long long>(serial_farthest(points, from)); });
+  const double closest_loop = best_of(1, [&] { g_bench_sink = static_cast<long long>(serial_closest(few)); });
+  row("centroid, operator+ loop", 1, centroid_loop, centroid_loop);
+  row("bounding box, loop", 1, box_loop, box_loop);
+  row("farthest, distance_to loop", 1, farthest_loop, farthest_loop);
+  row("closest pair, all pairs", 1, closest_loop, closest_loop);
+
+  const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1;; threads = std::min(2 * threads, hardware)) {
+    ThreadPool pool(threads);
+    ReduceOptions options;
+    options.pool = &pool;
+    fmt::println("");
+    row("centroid", threads, best_of(repeat, [&] {
+          g_bench_sink = static_cast<long long>(centroid(points.begin(), points.end(), options).x);
+        }), centroid_loop);
+    row("bounding_box", threads, best_of(repeat, [&] {
+          g_bench_sink = static_cast<long long>(bounding_box(points.begin(), points.end(), options).max.x);
+        }), box_loop);
+    row("farthest_point", threads, best_of(repeat, [&] {
+          g_bench_sink = static_cast<long long>(farthest_point(points.begin(), points.end(), from, options).index);
+        }), farthest_loop);
+    row("closest_pair", threads, best_of(repeat, [&] {
+          g_bench_sink = static_cast<long long>(closest_pair(few.begin(), few.end(), options).distance);
+        }), closest_loop);
+    // No all-pairs loop finishes at this size, so no speedup
+    const double all = best_of(repeat, [&] {
+      g_bench_sink = static_cast<long long>(closest_pair(points.begin(), points.end(), options).distance);
+    });
+    fmt::println("{:<28} {:>8} {:>12.3f} {:>10}", fmt::format("closest_pair, {} points", count), threads, all * 1e3, "-");
+    if (threads == hardware) break;
+  }
+
+  return 0;
+}
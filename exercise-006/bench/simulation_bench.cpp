@@ -0,0 +1,104 @@
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "particle_simulation.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// The demo's stability test scaled up: Point::move on every point, then wrap into the box
+double move_loop(std::vector<Point<double>>& points, const std::vector<Point<double>>& velocities,
+                 std::size_t steps, double size) {
+  for (std::size_t s = 0; s < steps; ++s) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      points[i].move(velocities[i].x, velocities[i].y);
+      for (std::size_t d = 0; d < 2; ++d) {
+        if (points[i][d] < 0.0) points[i][d] += size;
+        if (points[i][d] >= size) points[i][d] -= size;
+      }
+    }
+  }
+  return points[0].x;
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Point::move loop vs. ParticleSimulation: steps/s and points/s per thread count"};
+
+  std::size_t count = 1 << 20;
+  std::size_t steps = 100;
+  std::size_t repeat = 3;
+  app.add_option("-n,--points", count, "Number of points");
+  app.add_option("-s,--steps", steps, "Steps per run");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  const double size = 1000.0;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coordinate(0.0, size);
+  std::uniform_real_distribution<double> speed(-1.0, 1.0);
+  std::vector<Point<double>> points(count);
+  std::vector<Point<double>> velocities(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    points[i] = {coordinate(gen), coordinate(gen)};
+    velocities[i] = {speed(gen), speed(gen)};
+  }
+  const PointCloud<double> cloud(points.begin(), points.end());
+  const PointCloud<double> cloud_velocities(velocities.begin(), velocities.end());
+
+  fmt::println("{} points, {} steps, wrap boundary, best of {} runs, kernels: {}\n", count, steps, repeat,
+               cloud_simd::isa_name(cloud_simd::active_isa()));
+  fmt::println("{:<28} {:>8} {:>12} {:>14} {:>10}", "variant", "threads", "steps/s", "Mpoints/s", "speedup");
+
+  const double loop_seconds = best_of(repeat, [&] {
+    std::vector<Point<double>> copy = points;
+    g_bench_sink = static_cast<long long>(move_loop(copy, velocities, steps, size));
+  });
+  const double n = static_cast<double>(count);
+  const double s = static_cast<double>(steps);
+  auto row = [&](const char* name, std::size_t threads, double seconds) {
+    fmt::println("{:<28} {:>8} {:>12.1f} {:>14.1f} {:>9.1f}x", name, threads, s / seconds, n * s / seconds / 1e6,
+                 loop_seconds / seconds);
+  };
+  row("Point::move loop", 1, loop_seconds);
+
+  auto simulate = [&](ThreadPool& pool, std::size_t steps_per_pass) {
+    SimulationOptions<double> options;
+    options.boundary = Boundary::Wrap;
+    options.max = {size, size};
+    options.steps_per_pass = steps_per_pass;
+    options.pool = &pool;
+    return best_of(repeat, [&] {
+      ParticleSimulation<double> sim(cloud, cloud_velocities, options);
+      sim.run(steps);
+      g_bench_sink = static_cast<long long>(sim.positions()[0].x);
+    });
+  };
+
+  const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  {
+    ThreadPool pool(1);
+    row("simulation, 1 step per pass", pool.size(), simulate(pool, 1));
+  }
+  for (std::size_t threads = 1;; threads = std::min(2 * threads, hardware)) {
+    ThreadPool pool(threads);
+    row("simulation, 32 steps/pass", threads, simulate(pool, 32));
+    if (threads == hardware) break;
+  }
+
+  return 0;
+}
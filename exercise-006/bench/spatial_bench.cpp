@@ -0,0 +1,98 @@
+#include <fmt/format.h>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "kd_tree.hpp"
+#include "point_cloud.hpp"
+#include "uniform_grid.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+void row(const char* name, double build, double nearest, double knn, double radius, std::size_t queries) {
+  const auto rate = [queries](double seconds) { return static_cast<double>(queries) / seconds / 1e3; };
+  fmt::println("{:<14} {:>10.1f} {:>14.1f} {:>14.1f} {:>14.1f}", name, build * 1e3, rate(nearest), rate(knn),
+               rate(radius));
+}
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int
+{
+  CLI::App app{"Spatial index benchmark"};
+
+  std::size_t points = 1000000;
+  std::size_t queries = 10000;
+  std::size_t brute_queries = 200;
+  std::size_t k = 8;
+  std::size_t repeat = 3;
+  app.add_option("-n,--points", points, "Number of indexed points");
+  app.add_option("-q,--queries", queries, "Queries per index and query type");
+  app.add_option("-b,--brute-queries", brute_queries, "Queries for the brute-force scan");
+  app.add_option("-k", k, "Neighbours per k-NN query");
+  app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+  try
+  {
+    app.parse(argc, argv);
+  }
+  catch (const CLI::ParseError &e)
+  {
+    return app.exit(e);
+  }
+
+  // Uniform points in a square with about one point per unit area; radius 3 finds ~28 points
+  const double side = std::sqrt(static_cast<double>(points));
+  const double radius = 3.0;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0.0, side);
+  std::vector<Point<double>> set(points);
+  for (auto& p : set) p = Point<double>{coord(gen), coord(gen)};
+  std::vector<Point<double>> probes(queries);
+  for (auto& p : probes) p = Point<double>{coord(gen), coord(gen)};
+
+  fmt::println("{} points, {} queries, k = {}, radius = {}, best of {} runs", points, queries, k, radius, repeat);
+  fmt::println("{:<14} {:>10} {:>14} {:>14} {:>14}", "index", "build ms", "nearest k/s", "knn k/s", "radius k/s");
+
+  // Brute force: one batch distance kernel over a PointCloud per query
+  const PointCloud<double> cloud(set.begin(), set.end());
+  std::vector<double> d2(points);
+  const std::vector<Point<double>> brute_probes(probes.begin(), probes.begin() + std::min(brute_queries, queries));
+  const double brute = best_of(repeat, [&] {
+    for (const auto& q : brute_probes) {
+      cloud.squared_distances_to(q, d2.data());
+      std::size_t best = 0;
+      for (std::size_t i = 1; i < points; ++i) best = d2[i] < d2[best] ? i : best;
+      g_bench_sink = static_cast<long long>(best);
+    }
+  });
+  fmt::println("{:<14} {:>10} {:>14.1f} {:>14} {:>14}", "brute force", "-",
+               static_cast<double>(brute_probes.size()) / brute / 1e3, "-", "-");
+
+  ThreadPool single(1);
+  KdTree<double> tree;
+  const double tree_build = best_of(repeat, [&] { tree = KdTree<double>(set); });
+  row("kd-tree", tree_build,
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(tree.nearest(probes, &single).back().index); }),
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(tree.k_nearest(probes, k, &single).size()); }),
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(tree.within_radius(probes, radius, &single).size()); }),
+      queries);
+
+  UniformGrid<double> grid(radius);
+  const double grid_build = best_of(repeat, [&] { grid = UniformGrid<double>(radius, set); });
+  row("uniform grid", grid_build,
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(grid.nearest(probes, &single).back().index); }),
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(grid.k_nearest(probes, k, &single).size()); }),
+      best_of(repeat, [&] { g_bench_sink = static_cast<long long>(grid.within_radius(probes, radius, &single).size()); }),
+      queries);
+
+  const double parallel = best_of(repeat, [&] {
+    g_bench_sink = static_cast<long long>(tree.k_nearest(probes, k).size());
+  });
+  fmt::println("\nkd-tree k-NN on {} threads: {:.1f} k/s", ThreadPool::shared().size(),
+               static_cast<double>(queries) / parallel / 1e3);
+
+  return 0;
+}
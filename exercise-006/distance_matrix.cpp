@@ -0,0 +1,92 @@
+// distance_matrix.cpp
+#include "distance_matrix.hpp"
+
+#include <stdexcept>
+
+namespace distance_matrix_detail {
+namespace {
+
+// Tile grid over the A x B matrix; tile u covers row block u / col_tiles, column block u % col_tiles
+struct Grid {
+  std::size_t rows;
+  std::size_t cols;
+  std::size_t tile_rows;
+  std::size_t tile_cols;
+  std::size_t row_tiles;
+  std::size_t col_tiles;
+
+  Grid(std::size_t na, std::size_t nb, const DistanceMatrixOptions& options)
+      : rows(na), cols(nb), tile_rows(options.tile_rows), tile_cols(options.tile_cols) {
+    if (tile_rows == 0 || tile_cols == 0) {
+      throw std::invalid_argument("distance matrix: tile sizes must be positive");
+    }
+    row_tiles = (rows + tile_rows - 1) / tile_rows;
+    col_tiles = (cols + tile_cols - 1) / tile_cols;
+  }
+
+  std::size_t tiles() const noexcept { return row_tiles * col_tiles; }
+
+  DistanceTile tile(std::size_t u) const noexcept {
+    DistanceTile t;
+    t.row = (u / col_tiles) * tile_rows;
+    t.col = (u % col_tiles) * tile_cols;
+    t.rows = rows - t.row < tile_rows ? rows - t.row : tile_rows;
+    t.cols = cols - t.col < tile_cols ? cols - t.col : tile_cols;
+    return t;
+  }
+};
+
+ThreadPool& pool_of(const DistanceMatrixOptions& options) {
+  return options.pool ? *options.pool : ThreadPool::shared();
+}
+
+// Row i of the tile goes to out + i * ld; the B block is reused from L1 for every row
+void fill_tile(const Coordinates& a, const Coordinates& b, const DistanceTile& t, bool squared, double* out,
+               std::size_t ld) noexcept {
+  const double* bx = b.x.data() + t.col;
+  const double* by = b.y.data() + t.col;
+  for (std::size_t i = 0; i < t.rows; ++i) {
+    const double ax = a.x[t.row + i];
+    const double ay = a.y[t.row + i];
+    if (squared) {
+      cloud_simd::squared_distances(bx, by, t.cols, ax, ay, out + i * ld);
+    } else {
+      cloud_simd::distances(bx, by, t.cols, ax, ay, out + i * ld);
+    }
+  }
+}
+
+}  // namespace
+
+void compute(const Coordinates& a, const Coordinates& b, double* out, std::size_t ld,
+             const DistanceMatrixOptions& options) {
+  const Grid grid(a.x.size(), b.x.size(), options);
+  if (grid.tiles() == 0) return;
+  if (out == nullptr) throw std::invalid_argument("distance matrix: output buffer is null");
+
+  pool_of(options).parallel_for(grid.tiles(), [&](std::size_t u) {
+    const DistanceTile t = grid.tile(u);
+    fill_tile(a, b, t, options.squared, out + t.row * ld + t.col, ld);
+  });
+}
+
+void for_each_tile(const Coordinates& a, const Coordinates& b, bool all_pairs, const DistanceTileCallback& fn,
+                   const DistanceMatrixOptions& options) {
+  const Grid grid(a.x.size(), b.x.size(), options);
+  const bool skip_lower = all_pairs && options.upper_triangle;
+
+  pool_of(options).parallel_for(grid.tiles(), [&](std::size_t u) {
+    DistanceTile t = grid.tile(u);
+    if (skip_lower && t.col + t.cols <= t.row) return;
+
+    // One buffer per worker, so streaming needs no allocation per tile
+    thread_local std::vector<double> buffer;
+    if (buffer.size() < t.rows * t.cols) buffer.resize(t.rows * t.cols);
+    fill_tile(a, b, t, options.squared, buffer.data(), t.cols);
+    t.data = buffer.data();
+    t.stride = t.cols;
+    fn(t);
+  });
+}
+
+}  // namespace distance_matrix_detail
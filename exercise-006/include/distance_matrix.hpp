@@ -0,0 +1,155 @@
+// distance_matrix.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Tuning and output options for pairwise distance matrices
+ */
+struct DistanceMatrixOptions {
+  bool squared = false;          // dx * dx + dy * dy, skips the square root
+  std::size_t tile_rows = 64;    // points of A per tile
+  std::size_t tile_cols = 1024;  // points of B per tile; x and y of a B tile stay in L1
+  bool upper_triangle = false;   // all-pairs tile callback only: skip tiles entirely below the diagonal
+  ThreadPool* pool = nullptr;    // nullptr uses ThreadPool::shared()
+};
+
+/**
+ * @brief One rectangular block of a distance matrix, handed to tile callbacks
+ *
+ * value(i, j) is the distance between A[row + i] and B[col + j]. The storage
+ * belongs to the calling worker thread and is reused after the callback returns.
+ */
+struct DistanceTile {
+  std::size_t row = 0;
+  std::size_t col = 0;
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  const double* data = nullptr;
+  std::size_t stride = 0;  // elements between the starts of two rows
+
+  double value(std::size_t i, std::size_t j) const noexcept { return data[i * stride + j]; }
+};
+
+using DistanceTileCallback = std::function<void(const DistanceTile&)>;
+
+namespace distance_matrix_detail {
+
+// Coordinates of one point set, widened to double like in Point<T>::distance_to
+struct Coordinates {
+  std::vector<double> x;
+  std::vector<double> y;
+};
+
+template <typename T>
+Coordinates coordinates(const Point<T>* points, std::size_t n) {
+  static_assert(std::is_same<typename Point<T>::dist_t, double>::value,
+                "distance matrices are computed in double precision");
+  Coordinates c;
+  c.x.resize(n);
+  c.y.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    c.x[i] = static_cast<double>(points[i].x);
+    c.y[i] = static_cast<double>(points[i].y);
+  }
+  return c;
+}
+
+template <typename T>
+Coordinates coordinates(const PointCloud<T>& cloud) {
+  static_assert(std::is_same<typename Point<T>::dist_t, double>::value,
+                "distance matrices are computed in double precision");
+  Coordinates c;
+  c.x.assign(cloud.xs(), cloud.xs() + cloud.size());
+  c.y.assign(cloud.ys(), cloud.ys() + cloud.size());
+  return c;
+}
+
+// Writes the |A| x |B| matrix row-major into out with row stride ld
+void compute(const Coordinates& a, const Coordinates& b, double* out, std::size_t ld,
+             const DistanceMatrixOptions& options);
+
+// Streams the matrix tile by tile; 'all_pairs' marks A and B as the same set
+void for_each_tile(const Coordinates& a, const Coordinates& b, bool all_pairs, const DistanceTileCallback& fn,
+                   const DistanceMatrixOptions& options);
+
+}  // namespace distance_matrix_detail
+
+/**
+ * @brief A x B distance matrix into a caller-provided buffer
+ *
+ * Element (i, j) = a[i].distance_to(b[j]) (to within one ulp) is stored at
+ * out[i * b.size() + j]. Tiles are computed in parallel with SIMD inner loops.
+ *
+ * @param out Buffer of at least a.size() * b.size() doubles
+ */
+template <typename T>
+void pairwise_distances(const std::vector<Point<T>>& a, const std::vector<Point<T>>& b, double* out,
+                        const DistanceMatrixOptions& options = {}) {
+  distance_matrix_detail::compute(distance_matrix_detail::coordinates(a.data(), a.size()),
+                                  distance_matrix_detail::coordinates(b.data(), b.size()), out, b.size(),
+                                  options);
+}
+
+// All pairs of one set, an n x n matrix in out
+template <typename T>
+void pairwise_distances(const std::vector<Point<T>>& points, double* out, const DistanceMatrixOptions& options = {}) {
+  const auto c = distance_matrix_detail::coordinates(points.data(), points.size());
+  distance_matrix_detail::compute(c, c, out, points.size(), options);
+}
+
+template <typename T>
+void pairwise_distances(const PointCloud<T>& a, const PointCloud<T>& b, double* out,
+                        const DistanceMatrixOptions& options = {}) {
+  distance_matrix_detail::compute(distance_matrix_detail::coordinates(a), distance_matrix_detail::coordinates(b),
+                                  out, b.size(), options);
+}
+
+template <typename T>
+void pairwise_distances(const PointCloud<T>& points, double* out, const DistanceMatrixOptions& options = {}) {
+  const auto c = distance_matrix_detail::coordinates(points);
+  distance_matrix_detail::compute(c, c, out, points.size(), options);
+}
+
+/**
+ * @brief Stream the A x B distance matrix tile by tile, without materializing it
+ *
+ * fn runs concurrently on the worker threads, once per tile, in no particular
+ * order; it has to be thread-safe. Memory use is one tile per thread.
+ */
+template <typename T>
+void for_each_distance_tile(const std::vector<Point<T>>& a, const std::vector<Point<T>>& b,
+                            const DistanceTileCallback& fn, const DistanceMatrixOptions& options = {}) {
+  distance_matrix_detail::for_each_tile(distance_matrix_detail::coordinates(a.data(), a.size()),
+                                        distance_matrix_detail::coordinates(b.data(), b.size()), false, fn,
+                                        options);
+}
+
+// All pairs of one set; honours DistanceMatrixOptions::upper_triangle
+template <typename T>
+void for_each_distance_tile(const std::vector<Point<T>>& points, const DistanceTileCallback& fn,
+                            const DistanceMatrixOptions& options = {}) {
+  const auto c = distance_matrix_detail::coordinates(points.data(), points.size());
+  distance_matrix_detail::for_each_tile(c, c, true, fn, options);
+}
+
+template <typename T>
+void for_each_distance_tile(const PointCloud<T>& a, const PointCloud<T>& b, const DistanceTileCallback& fn,
+                            const DistanceMatrixOptions& options = {}) {
+  distance_matrix_detail::for_each_tile(distance_matrix_detail::coordinates(a),
+                                        distance_matrix_detail::coordinates(b), false, fn, options);
+}
+
+template <typename T>
+void for_each_distance_tile(const PointCloud<T>& points, const DistanceTileCallback& fn,
+                            const DistanceMatrixOptions& options = {}) {
+  const auto c = distance_matrix_detail::coordinates(points);
+  distance_matrix_detail::for_each_tile(c, c, true, fn, options);
+}
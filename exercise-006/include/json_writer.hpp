@@ -0,0 +1,108 @@
+// json_writer.hpp
+#pragma once
+
+#include "point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+/**
+ * @brief Streaming JSON writer that appends to a reusable fmt::memory_buffer
+ *
+ * Writes the same bytes as nlohmann::json::dump(indent) (compact for
+ * indent < 0, as used for NDJSON) without building a document: no allocation
+ * beyond the growth of the buffer. nlohmann::json sorts object keys, so for
+ * identical output the keys of every object must be written in ascending
+ * order. Numbers follow nlohmann as well: the same round-trip digits, ".0" on
+ * integral floating-point values, null for NaN and infinity. Keys and strings
+ * must be valid UTF-8: where dump() throws json::type_error 316, the writer
+ * throws std::invalid_argument.
+ *
+ * Usage:
+ *   fmt::memory_buffer buffer;
+ *   JsonWriter json(buffer, 2);
+ *   json.begin_object().field("distance", 5.0).field("point", p).end_object();
+ */
+class JsonWriter {
+public:
+  // Maximum nesting of objects and arrays
+  static constexpr std::size_t max_depth = 64;
+
+  explicit JsonWriter(fmt::memory_buffer& out, int indent = -1) noexcept : m_out(out), m_indent(indent) {}
+
+  // Containers; throw std::length_error beyond max_depth, std::logic_error when closing at depth 0
+  JsonWriter& begin_object() { return open('{'); }
+  JsonWriter& end_object() { return close('}'); }
+  JsonWriter& begin_array() { return open('['); }
+  JsonWriter& end_array() { return close(']'); }
+
+  // Key of the next value inside an object; keys and strings throw std::invalid_argument if not UTF-8
+  JsonWriter& key(std::string_view name);
+
+  JsonWriter& value(double v);
+  JsonWriter& value(bool v);
+  JsonWriter& value(std::string_view v);
+  JsonWriter& value(const char* v) { return value(std::string_view(v)); }
+  JsonWriter& null();
+
+  // float is widened to double, like nlohmann::json stores it
+  JsonWriter& value(float v) { return value(static_cast<double>(v)); }
+
+  template <typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+  JsonWriter& value(T v) {
+    separate();
+    const fmt::format_int digits(v);
+    m_out.append(digits.data(), digits.data() + digits.size());
+    return *this;
+  }
+
+  // A point as {"x": ..., "y": ...}; with z and w for 3D and 4D, keys in ascending order
+  template <typename T, std::size_t N>
+  JsonWriter& value(const Point<T, N>& p) {
+    static_assert(N >= 2 && N <= 4, "JsonWriter: points with 2 to 4 dimensions");
+    begin_object();
+    if constexpr (N == 4) field("w", p.w);
+    field("x", p.x).field("y", p.y);
+    if constexpr (N >= 3) field("z", p.z);
+    return end_object();
+  }
+
+  // key(name).value(v)
+  template <typename V>
+  JsonWriter& field(std::string_view name, const V& v) {
+    key(name);
+    return value(v);
+  }
+
+  // Nesting depth, 0 once the top-level value is complete
+  std::size_t depth() const noexcept { return m_depth; }
+
+private:
+  JsonWriter& open(char bracket);
+  JsonWriter& close(char bracket);
+
+  // Comma and line break before a key or a value, none directly after a key
+  void separate();
+  void newline();
+
+  fmt::memory_buffer& m_out;
+  int m_indent;
+  std::size_t m_depth = 0;
+  std::uint64_t m_filled = 0;  // bit d: the container at depth d + 1 has an element
+  bool m_after_key = false;
+};
+
+namespace json_detail {
+
+// Appends v formatted like nlohmann::json::dump()
+void append_double(fmt::memory_buffer& out, double v);
+
+// Appends s as a quoted JSON string with nlohmann's escapes; throws std::invalid_argument
+// if s is not valid UTF-8 (where dump() throws type_error 316)
+void append_string(fmt::memory_buffer& out, std::string_view s);
+
+}  // namespace json_detail
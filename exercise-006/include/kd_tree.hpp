@@ -0,0 +1,176 @@
+// kd_tree.hpp
+#pragma once
+
+#include "neighbor.hpp"
+#include "point.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Static 2-d tree over a set of Point<T> for nearest-neighbour, k-NN and radius queries
+ *
+ * The tree is built once from all points (median splits, alternating x/y) and
+ * stored implicitly: the points are reordered so that every subtree is a
+ * contiguous range whose middle element is the splitting point. Queries take
+ * O(log n) on average. The two halves of large ranges are built in parallel.
+ * All queries are const and may run concurrently.
+ *
+ * @tparam T Arithmetic type of the point coordinates
+ */
+template <typename T>
+class KdTree {
+public:
+  using size_type = std::size_t;
+
+  // Ranges up to this size are scanned linearly
+  static constexpr size_type leaf_size = 8;
+
+  // Ranges from this size on build their halves on two threads
+  static constexpr size_type parallel_threshold = 1 << 15;
+
+  KdTree() = default;
+
+  /**
+   * @brief Bulk build from a point set; Neighbor::index refers to positions in points
+   * @param pool Threads for the parallel build, nullptr uses ThreadPool::shared()
+   */
+  explicit KdTree(const std::vector<Point<T>>& points, ThreadPool* pool = nullptr) {
+    spatial_detail::check_coordinate_type<T>();
+    const size_type n = points.size();
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    for (size_type i = 0; i < n; ++i) {
+      x[i] = static_cast<double>(points[i].x);
+      y[i] = static_cast<double>(points[i].y);
+    }
+    m_index.resize(n);
+    std::iota(m_index.begin(), m_index.end(), size_type{0});
+    build(x, y, 0, n, 0, pool ? *pool : ThreadPool::shared());
+
+    m_x.resize(n);
+    m_y.resize(n);
+    m_position.resize(n);
+    for (size_type i = 0; i < n; ++i) {
+      m_x[i] = x[m_index[i]];
+      m_y[i] = y[m_index[i]];
+      m_position[m_index[i]] = i;
+    }
+  }
+
+  size_type size() const noexcept { return m_index.size(); }
+  bool empty() const noexcept { return m_index.empty(); }
+
+  // Closest point; index == size() and an infinite distance for an empty tree
+  Neighbor nearest(const Point<T>& q) const {
+    const std::vector<Neighbor> best = k_nearest(q, 1);
+    return best.empty() ? Neighbor{size(), std::numeric_limits<double>::infinity()} : best.front();
+  }
+
+  // The k closest points, ascending by distance (ties by index)
+  std::vector<Neighbor> k_nearest(const Point<T>& q, size_type k) const {
+    const double qx = static_cast<double>(q.x);
+    const double qy = static_cast<double>(q.y);
+    spatial_detail::KBest best(std::min(k, size()));
+    search(0, size(), 0, qx, qy, best);
+    return finish(best.take_sorted(), qx, qy);
+  }
+
+  // All points with distance <= radius, ascending by distance (ties by index)
+  std::vector<Neighbor> within_radius(const Point<T>& q, double radius) const {
+    if (!(radius >= 0)) return {};
+    const double qx = static_cast<double>(q.x);
+    const double qy = static_cast<double>(q.y);
+    spatial_detail::RadiusCollector found{radius * radius, {}};
+    search(0, size(), 0, qx, qy, found);
+    std::sort(found.found.begin(), found.found.end());
+    return finish(std::move(found.found), qx, qy);
+  }
+
+  // Batch versions: one result per query, computed in parallel
+  std::vector<Neighbor> nearest(const std::vector<Point<T>>& queries, ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<Neighbor>(queries.size(), pool, [&](size_type i) { return nearest(queries[i]); });
+  }
+
+  std::vector<std::vector<Neighbor>> k_nearest(const std::vector<Point<T>>& queries, size_type k,
+                                               ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<std::vector<Neighbor>>(queries.size(), pool,
+                                                        [&](size_type i) { return k_nearest(queries[i], k); });
+  }
+
+  std::vector<std::vector<Neighbor>> within_radius(const std::vector<Point<T>>& queries, double radius,
+                                                   ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<std::vector<Neighbor>>(
+      queries.size(), pool, [&](size_type i) { return within_radius(queries[i], radius); });
+  }
+
+private:
+  // Median split of m_index[lo, hi) on axis depth % 2, then both halves
+  void build(const std::vector<double>& x, const std::vector<double>& y, size_type lo, size_type hi,
+             unsigned depth, ThreadPool& pool) {
+    if (hi - lo <= leaf_size) return;
+    const size_type mid = lo + (hi - lo) / 2;
+    const std::vector<double>& axis = depth % 2 ? y : x;
+    std::nth_element(m_index.begin() + static_cast<std::ptrdiff_t>(lo),
+                     m_index.begin() + static_cast<std::ptrdiff_t>(mid),
+                     m_index.begin() + static_cast<std::ptrdiff_t>(hi),
+                     [&axis](size_type a, size_type b) { return axis[a] < axis[b]; });
+
+    if (hi - lo >= parallel_threshold) {
+      pool.parallel_for(2, [&](size_type half) {
+        if (half == 0) {
+          build(x, y, lo, mid, depth + 1, pool);
+        } else {
+          build(x, y, mid + 1, hi, depth + 1, pool);
+        }
+      });
+    } else {
+      build(x, y, lo, mid, depth + 1, pool);
+      build(x, y, mid + 1, hi, depth + 1, pool);
+    }
+  }
+
+  double squared_distance(size_type i, double qx, double qy) const noexcept {
+    const double dx = m_x[i] - qx;
+    const double dy = m_y[i] - qy;
+    return dx * dx + dy * dy;
+  }
+
+  // Visits the near half first; the far half only if the splitting line is within the current bound
+  template <typename Collector>
+  void search(size_type lo, size_type hi, unsigned depth, double qx, double qy, Collector& out) const {
+    if (hi - lo <= leaf_size) {
+      for (size_type i = lo; i < hi; ++i) {
+        out.offer(squared_distance(i, qx, qy), m_index[i]);
+      }
+      return;
+    }
+    const size_type mid = lo + (hi - lo) / 2;
+    const double diff = depth % 2 ? qy - m_y[mid] : qx - m_x[mid];
+    out.offer(squared_distance(mid, qx, qy), m_index[mid]);
+    if (diff < 0) {
+      search(lo, mid, depth + 1, qx, qy, out);
+      if (diff * diff <= out.bound()) search(mid + 1, hi, depth + 1, qx, qy, out);
+    } else {
+      search(mid + 1, hi, depth + 1, qx, qy, out);
+      if (diff * diff <= out.bound()) search(lo, mid, depth + 1, qx, qy, out);
+    }
+  }
+
+  std::vector<Neighbor> finish(std::vector<spatial_detail::Candidate> candidates, double qx, double qy) const {
+    return spatial_detail::to_neighbors(std::move(candidates), qx, qy, [this](size_type index) {
+      const size_type pos = m_position[index];
+      return std::make_pair(m_x[pos], m_y[pos]);
+    });
+  }
+
+  std::vector<size_type> m_index;  // input index of the point at each tree position
+  std::vector<double> m_x;         // coordinates in tree order
+  std::vector<double> m_y;
+  std::vector<size_type> m_position;  // tree position of each input index
+};
@@ -0,0 +1,396 @@
+// kmeans.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Parameters of kmeans()
+ */
+struct KMeansOptions {
+  std::size_t k = 8;
+  std::size_t max_iterations = 100;
+  double tolerance = 1e-4;               // converged once no center moves farther than this
+  std::size_t batch_size = 0;            // 0: full Lloyd iterations; else mini-batch with this many random points
+  std::size_t max_no_improvement = 10;   // mini-batch: batches without a lower smoothed inertia before stopping
+  std::uint64_t seed = 42;               // k-means++ seeding and mini-batch sampling
+  std::size_t chunk_size = 1 << 14;      // points per task and per partial sum
+  ThreadPool* pool = nullptr;            // nullptr uses ThreadPool::shared()
+};
+
+/**
+ * @brief Clusters found by kmeans()
+ */
+struct KMeansResult {
+  std::vector<Point<double>> centers;
+  std::vector<std::size_t> sizes;     // points per cluster
+  std::vector<std::uint32_t> labels;  // cluster of every point
+  double inertia = 0.0;               // sum of the squared distances to the own center
+  std::size_t iterations = 0;
+  bool converged = false;
+  double init_seconds = 0.0;          // k-means++ seeding
+  double seconds = 0.0;               // everything, seeding included
+};
+
+namespace kmeans_detail {
+
+using clock = std::chrono::steady_clock;
+
+inline double seconds_since(clock::time_point start) {
+  return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// Sums of the points of one cluster within one chunk
+struct Partial {
+  double x = 0.0;
+  double y = 0.0;
+  std::size_t count = 0;
+};
+
+// What one chunk of an assignment pass found, merged in chunk order so the
+// result does not depend on the number of threads
+struct ChunkResult {
+  std::vector<Partial> sums;  // one per center
+  double inertia = 0.0;
+  double farthest = -1.0;     // largest squared distance to the own center
+  std::size_t farthest_index = 0;
+};
+
+/**
+ * @brief Centers as two coordinate arrays, the layout nearest_center() reads
+ */
+struct Centers {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  std::size_t size() const noexcept { return x.size(); }
+};
+
+/**
+ * @brief Greedy k-means++ seeding
+ *
+ * Each further center is chosen among 2 + ln(k) candidate points, each drawn
+ * with probability proportional to its squared distance to the nearest center
+ * so far; the candidate that lowers the sum of these distances the most wins.
+ * Plain k-means++ (one candidate) often puts two seeds into one cluster,
+ * which Lloyd iterations repair only slowly and mini-batch iterations not at all.
+ */
+template <typename T>
+Centers seed(const PointCloud<T>& points, const KMeansOptions& options, ThreadPool& pool, std::mt19937_64& gen) {
+  const std::size_t n = points.size();
+  const std::size_t chunk = options.chunk_size;
+  const std::size_t chunks = (n + chunk - 1) / chunk;
+  const std::size_t trials = 2 + static_cast<std::size_t>(std::log(static_cast<double>(options.k)));
+  std::vector<double> nearest(n, std::numeric_limits<double>::infinity());
+  std::vector<double> chunk_sums(chunks);
+  std::vector<double> trial_sums(chunks * trials);
+
+  // Squared distances of chunk c to point p; returns the index of the first point of the chunk
+  auto distances = [&](std::size_t c, std::size_t p, std::vector<double>& squared) {
+    const std::size_t begin = c * chunk;
+    squared.resize(std::min(chunk, n - begin));
+    cloud_simd::squared_distances(points.xs() + begin, points.ys() + begin, squared.size(), points.xs()[p],
+                                  points.ys()[p], squared.data());
+    return begin;
+  };
+
+  // Point where the running sum of the distances passes r, r in [0, total)
+  auto draw = [&](double total) {
+    double r = std::uniform_real_distribution<double>(0.0, total)(gen);
+    std::size_t c = 0;
+    while (c + 1 < chunks && r >= chunk_sums[c]) r -= chunk_sums[c++];
+    const std::size_t end = std::min(n, (c + 1) * chunk);
+    std::size_t index = end - 1;
+    for (std::size_t i = c * chunk; i < end; ++i) {
+      if (nearest[i] > 0.0) index = i;  // rounding must not select a point that is already a center
+      if (r < nearest[i]) break;
+      r -= nearest[i];
+    }
+    return index;
+  };
+
+  Centers centers;
+  std::size_t index = std::uniform_int_distribution<std::size_t>(0, n - 1)(gen);
+  for (;;) {
+    centers.x.push_back(static_cast<double>(points.xs()[index]));
+    centers.y.push_back(static_cast<double>(points.ys()[index]));
+    if (centers.size() == options.k) return centers;
+
+    pool.parallel_for(chunks, [&](std::size_t c) {
+      std::vector<double> squared;
+      const std::size_t begin = distances(c, index, squared);
+      double sum = 0.0;
+      for (std::size_t i = 0; i < squared.size(); ++i) {
+        double& d = nearest[begin + i];
+        d = std::min(d, squared[i]);
+        sum += d;
+      }
+      chunk_sums[c] = sum;
+    });
+
+    double total = 0.0;
+    for (double sum : chunk_sums) total += sum;
+    if (!(total > 0.0)) {
+      // Every point coincides with a center already
+      index = std::uniform_int_distribution<std::size_t>(0, n - 1)(gen);
+      continue;
+    }
+    std::vector<std::size_t> candidates(trials);
+    for (std::size_t& candidate : candidates) candidate = draw(total);
+
+    // Sum of the distances if a candidate became the next center
+    pool.parallel_for(chunks, [&](std::size_t c) {
+      std::vector<double> squared;
+      for (std::size_t t = 0; t < trials; ++t) {
+        const std::size_t begin = distances(c, candidates[t], squared);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < squared.size(); ++i) sum += std::min(nearest[begin + i], squared[i]);
+        trial_sums[c * trials + t] = sum;
+      }
+    });
+    double best = std::numeric_limits<double>::infinity();
+    for (std::size_t t = 0; t < trials; ++t) {
+      double sum = 0.0;
+      for (std::size_t c = 0; c < chunks; ++c) sum += trial_sums[c * trials + t];
+      if (sum < best) {
+        best = sum;
+        index = candidates[t];
+      }
+    }
+  }
+}
+
+// Nearest center of points [begin, begin + count) with the per-cluster sums of the chunk
+template <typename T>
+void assign_chunk(const T* xs, const T* ys, std::size_t begin, std::size_t count, const Centers& centers,
+                  std::uint32_t* labels, ChunkResult& out) {
+  std::vector<double> squared(count);
+  cloud_simd::nearest_center(xs + begin, ys + begin, count, centers.x.data(), centers.y.data(), centers.size(),
+                             labels + begin, squared.data());
+  out.sums.assign(centers.size(), Partial{});
+  out.inertia = 0.0;
+  out.farthest = -1.0;
+  for (std::size_t i = 0; i < count; ++i) {
+    Partial& p = out.sums[labels[begin + i]];
+    p.x += static_cast<double>(xs[begin + i]);
+    p.y += static_cast<double>(ys[begin + i]);
+    ++p.count;
+    out.inertia += squared[i];
+    if (squared[i] > out.farthest) {
+      out.farthest = squared[i];
+      out.farthest_index = begin + i;
+    }
+  }
+}
+
+// Assigns all n points; one ChunkResult per chunk
+template <typename T>
+void assign(const T* xs, const T* ys, std::size_t n, const Centers& centers, std::uint32_t* labels,
+            std::size_t chunk, ThreadPool& pool, std::vector<ChunkResult>& results) {
+  const std::size_t chunks = (n + chunk - 1) / chunk;
+  results.resize(chunks);
+  pool.parallel_for(chunks, [&](std::size_t c) {
+    const std::size_t begin = c * chunk;
+    assign_chunk(xs, ys, begin, std::min(chunk, n - begin), centers, labels, results[c]);
+  });
+}
+
+// Per-cluster totals of all chunks
+inline std::vector<Partial> merge(const std::vector<ChunkResult>& results, std::size_t k) {
+  std::vector<Partial> total(k);
+  for (const ChunkResult& r : results) {
+    for (std::size_t j = 0; j < k; ++j) {
+      total[j].x += r.sums[j].x;
+      total[j].y += r.sums[j].y;
+      total[j].count += r.sums[j].count;
+    }
+  }
+  return total;
+}
+
+inline double squared_shift(double x0, double y0, double x1, double y1) noexcept {
+  return (x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0);
+}
+
+/**
+ * @brief Lloyd iterations: assign every point, move every center to the mean of its points
+ *
+ * An empty cluster takes over the point that is farthest from its own center
+ * (one candidate per chunk, the farthest ones first).
+ */
+template <typename T>
+void lloyd(const PointCloud<T>& points, const KMeansOptions& options, ThreadPool& pool, Centers& centers,
+           KMeansResult& result) {
+  const std::size_t k = centers.size();
+  const double tolerance = options.tolerance * options.tolerance;
+  std::vector<ChunkResult> chunks;
+  std::vector<std::uint32_t> labels(points.size());
+  for (result.iterations = 0; result.iterations < options.max_iterations;) {
+    assign(points.xs(), points.ys(), points.size(), centers, labels.data(), options.chunk_size, pool, chunks);
+    ++result.iterations;
+    const std::vector<Partial> total = merge(chunks, k);
+
+    std::sort(chunks.begin(), chunks.end(),
+              [](const ChunkResult& a, const ChunkResult& b) { return a.farthest > b.farthest; });
+    std::size_t donor = 0;
+    double shift = 0.0;
+    for (std::size_t j = 0; j < k; ++j) {
+      double x = centers.x[j];
+      double y = centers.y[j];
+      if (total[j].count > 0) {
+        x = total[j].x / static_cast<double>(total[j].count);
+        y = total[j].y / static_cast<double>(total[j].count);
+      } else if (donor < chunks.size()) {
+        const std::size_t i = chunks[donor++].farthest_index;
+        x = static_cast<double>(points.xs()[i]);
+        y = static_cast<double>(points.ys()[i]);
+      }
+      shift = std::max(shift, squared_shift(centers.x[j], centers.y[j], x, y));
+      centers.x[j] = x;
+      centers.y[j] = y;
+    }
+    if (shift <= tolerance) {
+      result.converged = true;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Mini-batch k-means (Sculley 2010): each iteration assigns batch_size
+ *        random points and moves every center towards the mean of its share
+ *
+ * A center moves by (batch mean - center) * m / v, where m is the number of
+ * its points in this batch and v in all batches so far, so the steps shrink
+ * as the center settles. Only the sampled points are read per iteration.
+ * The centers of a batch never stop moving entirely, so besides the
+ * tolerance the run also ends once the moving average of the batch inertia
+ * has not improved for max_no_improvement batches.
+ */
+template <typename T>
+void mini_batch(const PointCloud<T>& points, const KMeansOptions& options, ThreadPool& pool, std::mt19937_64& gen,
+                Centers& centers, KMeansResult& result) {
+  const std::size_t k = centers.size();
+  const std::size_t batch = options.batch_size;
+  const double tolerance = options.tolerance * options.tolerance;
+  std::uniform_int_distribution<std::size_t> pick(0, points.size() - 1);
+  std::vector<std::size_t> indices(batch);
+  std::vector<T> xs(batch);
+  std::vector<T> ys(batch);
+  std::vector<std::uint32_t> labels(batch);
+  std::vector<std::size_t> seen(k, 0);
+  std::vector<ChunkResult> chunks;
+  // Weight of a batch in the moving average, as if about two batches covered the data
+  const double alpha = std::min(1.0, 2.0 * static_cast<double>(batch) / static_cast<double>(points.size() + 1));
+  double average = 0.0;
+  double best = std::numeric_limits<double>::infinity();
+  std::size_t no_improvement = 0;
+
+  for (result.iterations = 0; result.iterations < options.max_iterations;) {
+    for (std::size_t& index : indices) index = pick(gen);
+    const std::size_t chunk = options.chunk_size;
+    pool.parallel_for((batch + chunk - 1) / chunk, [&](std::size_t c) {
+      const std::size_t end = std::min(batch, (c + 1) * chunk);
+      for (std::size_t b = c * chunk; b < end; ++b) {
+        xs[b] = points.xs()[indices[b]];
+        ys[b] = points.ys()[indices[b]];
+      }
+    });
+    assign(xs.data(), ys.data(), batch, centers, labels.data(), chunk, pool, chunks);
+    ++result.iterations;
+    const std::vector<Partial> total = merge(chunks, k);
+
+    double inertia = 0.0;
+    for (const ChunkResult& chunk_result : chunks) inertia += chunk_result.inertia;
+    inertia /= static_cast<double>(batch);
+    average = result.iterations == 1 ? inertia : average * (1.0 - alpha) + inertia * alpha;
+    if (average < best) {
+      best = average;
+      no_improvement = 0;
+    } else if (++no_improvement >= options.max_no_improvement) {
+      result.converged = true;
+      return;
+    }
+
+    double shift = 0.0;
+    for (std::size_t j = 0; j < k; ++j) {
+      if (total[j].count == 0) continue;
+      seen[j] += total[j].count;
+      const double m = static_cast<double>(total[j].count);
+      const double rate = m / static_cast<double>(seen[j]);
+      const double x = centers.x[j] + (total[j].x / m - centers.x[j]) * rate;
+      const double y = centers.y[j] + (total[j].y / m - centers.y[j]) * rate;
+      shift = std::max(shift, squared_shift(centers.x[j], centers.y[j], x, y));
+      centers.x[j] = x;
+      centers.y[j] = y;
+    }
+    if (shift <= tolerance) {
+      result.converged = true;
+      return;
+    }
+  }
+}
+
+}  // namespace kmeans_detail
+
+/**
+ * @brief Partitions points into options.k clusters with k-means
+ *
+ * Seeds with greedy k-means++, then runs Lloyd iterations, or mini-batch iterations
+ * if options.batch_size > 0, until no center moves farther than
+ * options.tolerance (or mini-batch stops improving) or max_iterations is reached. A final pass assigns every
+ * point to the nearest of the returned centers. Points are assigned with the
+ * cloud_simd::nearest_center kernel in parallel chunks; each chunk keeps its
+ * own per-cluster sums, merged in chunk order without locks, so the result
+ * does not depend on the number of threads.
+ *
+ * @throws std::invalid_argument if k is 0, k exceeds the number of points, or chunk_size is 0
+ */
+template <typename T>
+KMeansResult kmeans(const PointCloud<T>& points, const KMeansOptions& options = {}) {
+  static_assert(cloud_simd::has_kernels<T>, "kmeans: coordinates must be int, float or double");
+  if (options.k == 0 || options.k > points.size()) {
+    throw std::invalid_argument("kmeans: k must be between 1 and the number of points");
+  }
+  if (options.k > std::numeric_limits<std::uint32_t>::max() || options.chunk_size == 0) {
+    throw std::invalid_argument("kmeans: k too large or chunk_size 0");
+  }
+  const auto start = kmeans_detail::clock::now();
+  ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+  std::mt19937_64 gen(options.seed);
+  KMeansResult result;
+
+  kmeans_detail::Centers centers = kmeans_detail::seed(points, options, pool, gen);
+  result.init_seconds = kmeans_detail::seconds_since(start);
+  if (options.batch_size > 0) {
+    kmeans_detail::mini_batch(points, options, pool, gen, centers, result);
+  } else {
+    kmeans_detail::lloyd(points, options, pool, centers, result);
+  }
+
+  std::vector<kmeans_detail::ChunkResult> chunks;
+  result.labels.resize(points.size());
+  kmeans_detail::assign(points.xs(), points.ys(), points.size(), centers, result.labels.data(), options.chunk_size,
+                        pool, chunks);
+  for (const auto& chunk : chunks) result.inertia += chunk.inertia;
+  for (const auto& total : kmeans_detail::merge(chunks, options.k)) result.sizes.push_back(total.count);
+  for (std::size_t j = 0; j < options.k; ++j) result.centers.push_back({centers.x[j], centers.y[j]});
+  result.seconds = kmeans_detail::seconds_since(start);
+  return result;
+}
+
+template <typename T>
+KMeansResult kmeans(const std::vector<Point<T>>& points, const KMeansOptions& options = {}) {
+  return kmeans(PointCloud<T>(points.begin(), points.end()), options);
+}
@@ -0,0 +1,147 @@
+// metric.hpp
+#pragma once
+
+#include "point.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Distance metrics for Point<T, N>, selected at compile time
+ *
+ * Every policy provides a static distance(a, b) for points of any dimension
+ * that computes in Point<T, N>::dist_t, like Point<T, N>::distance_to(). The
+ * constexpr policies can be used in constant expressions. std::sqrt and
+ * std::hypot are not constexpr in C++17, so the two Euclidean policies are
+ * only noexcept.
+ *
+ * Usage:
+ *   auto d = distance<metric::SquaredEuclidean>(a, b);  // ranking without sqrt
+ */
+namespace metric {
+
+namespace detail {
+
+// std::abs is not constexpr in C++17. Unlike std::abs, -0.0 stays -0.0, which compares equal
+// to 0.0 and vanishes in the sums and maxima of the policies below.
+template <typename T>
+constexpr T abs(T v) noexcept {
+  return v < 0 ? -v : v;
+}
+
+// Coordinate differences in the wider distance type, so integer inputs cannot overflow
+template <typename T, std::size_t N>
+struct Delta {
+  using dist_t = typename Point<T, N>::dist_t;
+  dist_t d[N]{};
+
+  constexpr Delta(const Point<T, N>& a, const Point<T, N>& b) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      d[i] = static_cast<dist_t>(a[i]) - static_cast<dist_t>(b[i]);
+    }
+  }
+
+  constexpr dist_t squared_sum() const noexcept {
+    dist_t sum{};
+    for (std::size_t i = 0; i < N; ++i) {
+      sum += d[i] * d[i];
+    }
+    return sum;
+  }
+};
+
+}  // namespace detail
+
+// Euclidean distance via std::hypot: no intermediate overflow or underflow (same as distance_to)
+struct Hypot {
+  static constexpr const char* name = "hypot";
+  static constexpr bool preserves_euclidean_order = true;
+
+  template <typename T, std::size_t N>
+  static auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept -> typename Point<T, N>::dist_t {
+    return a.distance_to(b);
+  }
+};
+
+// Euclidean distance as sqrt(dx * dx + dy * dy + ...); overflows once a difference exceeds ~1e154
+struct Euclidean {
+  static constexpr const char* name = "euclidean";
+  static constexpr bool preserves_euclidean_order = true;
+
+  template <typename T, std::size_t N>
+  static auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept -> typename Point<T, N>::dist_t {
+    return std::sqrt(detail::Delta<T, N>(a, b).squared_sum());
+  }
+};
+
+// dx * dx + dy * dy + ...; orders points like the Euclidean distance, without any sqrt
+struct SquaredEuclidean {
+  static constexpr const char* name = "squared";
+  static constexpr bool preserves_euclidean_order = true;
+
+  template <typename T, std::size_t N>
+  static constexpr auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept
+    -> typename Point<T, N>::dist_t {
+    return detail::Delta<T, N>(a, b).squared_sum();
+  }
+};
+
+// |dx| + |dy| + ... (taxicab distance)
+struct Manhattan {
+  static constexpr const char* name = "manhattan";
+  static constexpr bool preserves_euclidean_order = false;
+
+  template <typename T, std::size_t N>
+  static constexpr auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept
+    -> typename Point<T, N>::dist_t {
+    const detail::Delta<T, N> delta(a, b);
+    typename Point<T, N>::dist_t sum{};
+    for (std::size_t i = 0; i < N; ++i) {
+      sum += detail::abs(delta.d[i]);
+    }
+    return sum;
+  }
+};
+
+// max(|dx|, |dy|, ...) (chessboard distance)
+struct Chebyshev {
+  static constexpr const char* name = "chebyshev";
+  static constexpr bool preserves_euclidean_order = false;
+
+  template <typename T, std::size_t N>
+  static constexpr auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept
+    -> typename Point<T, N>::dist_t {
+    const detail::Delta<T, N> delta(a, b);
+    typename Point<T, N>::dist_t largest{};
+    for (std::size_t i = 0; i < N; ++i) {
+      largest = std::max(largest, detail::abs(delta.d[i]));
+    }
+    return largest;
+  }
+};
+
+}  // namespace metric
+
+/**
+ * @brief Distance between two points under Metric
+ * @tparam Metric One of the policies in namespace metric (or a compatible type)
+ */
+template <typename Metric, typename T, std::size_t N>
+constexpr auto distance(const Point<T, N>& a, const Point<T, N>& b) noexcept(noexcept(Metric::distance(a, b)))
+  -> decltype(Metric::distance(a, b)) {
+  return Metric::distance(a, b);
+}
+
+/**
+ * @brief True if a is strictly closer to q than b is, under Metric
+ *
+ * For ranking, metric::SquaredEuclidean gives the same answer as the
+ * Euclidean metrics without computing a square root.
+ */
+template <typename Metric, typename T, std::size_t N>
+constexpr bool closer(const Point<T, N>& q, const Point<T, N>& a, const Point<T, N>& b) noexcept(
+  noexcept(Metric::distance(q, a))) {
+  return Metric::distance(q, a) < Metric::distance(q, b);
+}
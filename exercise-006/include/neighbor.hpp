@@ -0,0 +1,123 @@
+// neighbor.hpp
+#pragma once
+
+#include "point.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Result of a spatial query: which point, and how far away it is
+ *
+ * index refers to the input order of KdTree or to the id returned by
+ * UniformGrid::insert(); distance equals Point<T>::distance_to().
+ */
+struct Neighbor {
+  std::size_t index = 0;
+  double distance = 0.0;
+
+  bool operator==(const Neighbor& rhs) const { return index == rhs.index && distance == rhs.distance; }
+  bool operator!=(const Neighbor& rhs) const { return !(*this == rhs); }
+};
+
+namespace spatial_detail {
+
+template <typename T>
+constexpr void check_coordinate_type() {
+  static_assert(std::is_same<typename Point<T>::dist_t, double>::value,
+                "spatial indexes compute distances in double precision");
+}
+
+// Candidates are ranked by (squared distance, index), so ties resolve the same way as in a brute-force scan
+struct Candidate {
+  double d2;
+  std::size_t index;
+
+  bool operator<(const Candidate& rhs) const noexcept {
+    return d2 < rhs.d2 || (d2 == rhs.d2 && index < rhs.index);
+  }
+};
+
+/**
+ * @brief The k best candidates seen so far, kept in a max-heap
+ */
+class KBest {
+public:
+  explicit KBest(std::size_t k) : m_k(k) { m_heap.reserve(k); }
+
+  // Squared distance a candidate has to beat; infinite until k candidates are known
+  double bound() const noexcept {
+    if (m_k == 0) return -std::numeric_limits<double>::infinity();
+    return m_heap.size() < m_k ? std::numeric_limits<double>::infinity() : m_heap.front().d2;
+  }
+
+  bool full() const noexcept { return m_heap.size() == m_k; }
+
+  void offer(double d2, std::size_t index) {
+    const Candidate c{d2, index};
+    if (m_heap.size() < m_k) {
+      m_heap.push_back(c);
+      std::push_heap(m_heap.begin(), m_heap.end());
+    } else if (m_k > 0 && c < m_heap.front()) {
+      std::pop_heap(m_heap.begin(), m_heap.end());
+      m_heap.back() = c;
+      std::push_heap(m_heap.begin(), m_heap.end());
+    }
+  }
+
+  // Candidates in ascending order; empties the heap
+  std::vector<Candidate> take_sorted() {
+    std::sort_heap(m_heap.begin(), m_heap.end());
+    return std::move(m_heap);
+  }
+
+private:
+  std::size_t m_k;
+  std::vector<Candidate> m_heap;
+};
+
+// Every candidate within a fixed squared radius
+struct RadiusCollector {
+  double r2;
+  std::vector<Candidate> found;
+
+  double bound() const noexcept { return r2; }
+  void offer(double d2, std::size_t index) {
+    if (d2 <= r2) found.push_back({d2, index});
+  }
+};
+
+// Turns ranked candidates into neighbours; coord(index) yields the (x, y) of a point
+template <typename Coord>
+std::vector<Neighbor> to_neighbors(std::vector<Candidate> candidates, double qx, double qy, Coord&& coord) {
+  std::vector<Neighbor> result;
+  result.reserve(candidates.size());
+  for (const Candidate& c : candidates) {
+    const std::pair<double, double> p = coord(c.index);
+    result.push_back({c.index, std::hypot(p.first - qx, p.second - qy)});
+  }
+  return result;
+}
+
+// Runs query(i) for every query in parallel, in chunks so small queries amortize the hand-out
+template <typename Result, typename Query>
+std::vector<Result> batch(std::size_t count, ThreadPool* pool, Query&& query) {
+  constexpr std::size_t chunk = 64;
+  std::vector<Result> results(count);
+  ThreadPool& workers = pool ? *pool : ThreadPool::shared();
+  workers.parallel_for((count + chunk - 1) / chunk, [&](std::size_t c) {
+    const std::size_t end = std::min(count, (c + 1) * chunk);
+    for (std::size_t i = c * chunk; i < end; ++i) {
+      results[i] = query(i);
+    }
+  });
+  return results;
+}
+
+}  // namespace spatial_detail
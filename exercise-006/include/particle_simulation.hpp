@@ -0,0 +1,171 @@
+// particle_simulation.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// What happens to points that leave the box after a step
+enum class Boundary { None, Wrap, Clamp };
+
+/**
+ * @brief Box, tuning and thread pool of a ParticleSimulation
+ */
+template <typename T>
+struct SimulationOptions {
+  Boundary boundary = Boundary::None;
+  Point<T> min{};                    // lower corner of the box
+  Point<T> max{};                    // upper corner; Wrap maps into [min, max), Clamp into [min, max]
+  std::size_t chunk_size = 4096;     // points per task; a chunk of one axis stays in L1/L2
+  std::size_t steps_per_pass = 32;   // steps a chunk advances before the next one is loaded
+  ThreadPool* pool = nullptr;        // nullptr uses ThreadPool::shared()
+};
+
+/**
+ * @brief Timing of ParticleSimulation::run()
+ */
+struct SimulationStats {
+  std::size_t points = 0;
+  std::size_t steps = 0;
+  std::size_t threads = 0;        // workers of the pool; the calling thread helps as well
+  double seconds = 0.0;           // stepping only
+  double snapshot_seconds = 0.0;  // spent in the snapshot callback
+
+  double steps_per_second() const noexcept { return seconds > 0 ? static_cast<double>(steps) / seconds : 0.0; }
+
+  // Point updates per second
+  double points_per_second() const noexcept { return steps_per_second() * static_cast<double>(points); }
+};
+
+/**
+ * @brief Moves a population of points by per-point velocities, step after step
+ *
+ * One step is Point::move(velocity) on every point, followed by the boundary.
+ * Positions are double buffered: a pass reads the front PointCloud and writes
+ * the back one, then the two swap, so positions() always shows a complete
+ * step. Each pass advances every chunk of each axis by up to steps_per_pass
+ * steps while it is in cache, with the cloud_simd kernels, and the chunks are
+ * spread over a ThreadPool. The result is the same as stepping one at a time;
+ * int coordinates wrap around on overflow like the kernels do.
+ *
+ * Usage:
+ *   ParticleSimulation<double> sim(positions, velocities, options);
+ *   const auto stats = sim.run(1000, [](std::size_t step, const PointCloud<double>& p) { ... }, 100);
+ */
+template <typename T>
+class ParticleSimulation {
+  static_assert(cloud_simd::has_kernels<T>, "ParticleSimulation<T>: T must be int, float or double");
+
+public:
+  using Snapshot = std::function<void(std::size_t step, const PointCloud<T>& positions)>;
+
+  /**
+   * @throws std::invalid_argument if the sizes differ, the box is empty or a tuning value is 0
+   */
+  ParticleSimulation(PointCloud<T> positions, PointCloud<T> velocities, SimulationOptions<T> options = {})
+      : m_front(std::move(positions)), m_back(m_front.size()), m_velocities(std::move(velocities)),
+        m_options(options) {
+    if (m_front.size() != m_velocities.size()) {
+      throw std::invalid_argument("ParticleSimulation: positions and velocities differ in size");
+    }
+    if (m_options.chunk_size == 0 || m_options.steps_per_pass == 0) {
+      throw std::invalid_argument("ParticleSimulation: chunk_size and steps_per_pass must be positive");
+    }
+    const bool wrap = m_options.boundary == Boundary::Wrap;
+    for (std::size_t d = 0; d < 2 && m_options.boundary != Boundary::None; ++d) {
+      const T lo = m_options.min[d];
+      const T hi = m_options.max[d];
+      if (wrap ? !(lo < hi) : !(lo <= hi)) throw std::invalid_argument("ParticleSimulation: empty box");
+    }
+  }
+
+  const PointCloud<T>& positions() const noexcept { return m_front; }
+  const PointCloud<T>& velocities() const noexcept { return m_velocities; }
+  std::size_t size() const noexcept { return m_front.size(); }
+
+  // Steps taken so far
+  std::size_t step_count() const noexcept { return m_steps; }
+
+  void step() { run(1); }
+
+  /**
+   * @brief Takes 'steps' steps
+   * @param snapshot Called with the positions after every step that is a multiple of snapshot_every
+   * @param snapshot_every 0 disables snapshots
+   */
+  SimulationStats run(std::size_t steps, const Snapshot& snapshot = {}, std::size_t snapshot_every = 0) {
+    using clock = std::chrono::steady_clock;
+    ThreadPool& pool = m_options.pool ? *m_options.pool : ThreadPool::shared();
+    const bool snapshots = snapshot && snapshot_every > 0;
+
+    SimulationStats stats;
+    stats.points = size();
+    stats.steps = steps;
+    stats.threads = pool.size();
+    for (std::size_t done = 0; done < steps;) {
+      std::size_t pass = std::min(steps - done, m_options.steps_per_pass);
+      if (snapshots) pass = std::min(pass, snapshot_every - m_steps % snapshot_every);
+
+      const auto start = clock::now();
+      advance(pool, pass);
+      stats.seconds += std::chrono::duration<double>(clock::now() - start).count();
+      done += pass;
+      m_steps += pass;
+
+      if (snapshots && m_steps % snapshot_every == 0) {
+        const auto taken = clock::now();
+        snapshot(m_steps, m_front);
+        stats.snapshot_seconds += std::chrono::duration<double>(clock::now() - taken).count();
+      }
+    }
+    return stats;
+  }
+
+private:
+  // 'steps' steps from the front into the back buffer, then swap
+  void advance(ThreadPool& pool, std::size_t steps) {
+    const std::size_t n = size();
+    const std::size_t chunk = m_options.chunk_size;
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+    // Both axes move independently, so x and y chunks are separate tasks
+    pool.parallel_for(2 * chunks, [&](std::size_t task) {
+      const std::size_t axis = task / chunks;
+      const std::size_t begin = (task % chunks) * chunk;
+      const std::size_t count = std::min(chunk, n - begin);
+      const T* from = (axis == 0 ? m_front.xs() : m_front.ys()) + begin;
+      const T* velocity = (axis == 0 ? m_velocities.xs() : m_velocities.ys()) + begin;
+      T* to = (axis == 0 ? m_back.xs() : m_back.ys()) + begin;
+
+      cloud_simd::add(from, velocity, count, to);
+      bound(to, count, axis);
+      for (std::size_t s = 1; s < steps; ++s) {
+        cloud_simd::add(to, velocity, count);
+        bound(to, count, axis);
+      }
+    });
+    m_front.swap(m_back);
+  }
+
+  void bound(T* data, std::size_t count, std::size_t axis) const noexcept {
+    const T lo = m_options.min[axis];
+    const T hi = m_options.max[axis];
+    switch (m_options.boundary) {
+      case Boundary::Wrap: cloud_simd::wrap(data, count, lo, hi); break;
+      case Boundary::Clamp: cloud_simd::clamp(data, count, lo, hi); break;
+      case Boundary::None: break;
+    }
+  }
+
+  PointCloud<T> m_front;
+  PointCloud<T> m_back;
+  PointCloud<T> m_velocities;
+  SimulationOptions<T> m_options;
+  std::size_t m_steps = 0;
+};
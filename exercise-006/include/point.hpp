@@ -3,37 +3,129 @@
 
 #include <type_traits>
 #include <cmath>
+#include <cstddef>
 #include <utility>
 
+namespace point_detail {
+
+// Alignment of Point<T, N>: the storage rounded up to a power of two, at most
+// one AVX register, so that whole points load and store as packed vectors
+template <typename T, std::size_t N>
+constexpr std::size_t alignment() {
+  std::size_t align = alignof(T);
+  while (align < sizeof(T) * N && align < 32) {
+    align *= 2;
+  }
+  return align;
+}
+
+template <std::size_t, typename T>
+using repeat_t = T;
+
 /**
- * @brief Generic Point class template for arithmetic types
- * @tparam T Arithmetic type (int, float, double, etc.)
+ * @brief Coordinate storage; 2, 3 and 4 dimensions get named members
  */
+template <typename T, std::size_t N>
+struct Storage {
+  T v[N]{};
+
+  constexpr T& at(std::size_t i) noexcept { return v[i]; }
+  constexpr const T& at(std::size_t i) const noexcept { return v[i]; }
+};
+
 template <typename T>
-class Point {
-  // Ensure T is an arithmetic type (int, float, double, etc.)
-  static_assert(std::is_arithmetic<T>::value, 
-                "Point<T>: T must be an arithmetic type");
+struct Storage<T, 2> {
+  T x{};
+  T y{};
 
-public:
-  // Member variables
+  constexpr T& at(std::size_t i) noexcept { return i == 0 ? x : y; }
+  constexpr const T& at(std::size_t i) const noexcept { return i == 0 ? x : y; }
+};
+
+template <typename T>
+struct Storage<T, 3> {
+  T x{};
+  T y{};
+  T z{};
+
+  constexpr T& at(std::size_t i) noexcept { return i == 0 ? x : (i == 1 ? y : z); }
+  constexpr const T& at(std::size_t i) const noexcept { return i == 0 ? x : (i == 1 ? y : z); }
+};
+
+template <typename T>
+struct Storage<T, 4> {
   T x{};
   T y{};
+  T z{};
+  T w{};
 
-  // Default constructor: initializes x and y to T{}
-  Point() = default;
+  constexpr T& at(std::size_t i) noexcept { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+  constexpr const T& at(std::size_t i) const noexcept { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+};
+
+/**
+ * @brief Storage plus the members whose signature takes one T per dimension
+ */
+template <typename T, std::size_t N, typename Seq = std::make_index_sequence<N>>
+struct Coordinates;
 
-  // Value constructor: initializes with given coordinates
-  Point(T x_, T y_) : x{x_}, y{y_} {}
+template <typename T, std::size_t N, std::size_t... I>
+struct Coordinates<T, N, std::index_sequence<I...>> : Storage<T, N> {
+  constexpr Coordinates() = default;
+
+  // Value constructor: one coordinate per dimension
+  constexpr Coordinates(repeat_t<I, T>... coords) noexcept : Storage<T, N>{coords...} {}
 
   /**
-   * @brief Move the point by dx and dy
-   * @param dx Delta x
-   * @param dy Delta y
+   * @brief Move the point by one delta per dimension
    */
-  void move(T dx, T dy) {
-    x += dx;
-    y += dy;
+  constexpr void move(repeat_t<I, T>... deltas) noexcept {
+    ((this->at(I) += deltas), ...);
+  }
+};
+
+}  // namespace point_detail
+
+/**
+ * @brief Generic point class template for arithmetic types
+ *
+ * Point<T> is the 2D point with members x and y; 3D and 4D points add z and w.
+ * The storage is aligned (see point_detail::alignment) so that the
+ * component-wise operations compile to packed SIMD instructions.
+ *
+ * @tparam T Arithmetic type (int, float, double, etc.)
+ * @tparam N Number of dimensions (default 2)
+ */
+template <typename T, std::size_t N = 2>
+class alignas(point_detail::alignment<T, N>()) Point : public point_detail::Coordinates<T, N> {
+  // Ensure T is an arithmetic type (int, float, double, etc.)
+  static_assert(std::is_arithmetic<T>::value,
+                "Point<T>: T must be an arithmetic type");
+  static_assert(N > 0, "Point<T, N>: N must be positive");
+
+  using Base = point_detail::Coordinates<T, N>;
+  using Indices = std::make_index_sequence<N>;
+
+public:
+  using value_type = T;
+  static constexpr std::size_t dimension = N;
+
+  // Default constructor: initializes all coordinates to T{}
+  constexpr Point() = default;
+
+  // Value constructor Point(x, y, ...) and move(dx, dy, ...) take one T per dimension
+  using Base::Base;
+  using Base::move;
+
+  // Coordinate i (0 = x, 1 = y, ...)
+  constexpr T& operator[](std::size_t i) noexcept { return this->at(i); }
+  constexpr const T& operator[](std::size_t i) const noexcept { return this->at(i); }
+
+  // Move the point by the coordinates of delta
+  constexpr void move(const Point& delta) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      (*this)[i] += delta[i];
+    }
   }
 
   // Return type for distance calculation
@@ -45,32 +137,53 @@ public:
    * @param other The other point
    * @return Distance as common_type of T and double
    */
-  auto distance_to(const Point& other) const -> dist_t {
+  auto distance_to(const Point& other) const noexcept -> dist_t {
     // Cast to wider type before subtraction to avoid overflow
-    const auto dx = static_cast<dist_t>(x) - static_cast<dist_t>(other.x);
-    const auto dy = static_cast<dist_t>(y) - static_cast<dist_t>(other.y);
+    dist_t d[N];
+    for (std::size_t i = 0; i < N; ++i) {
+      d[i] = static_cast<dist_t>((*this)[i]) - static_cast<dist_t>(other[i]);
+    }
     // Use std::hypot for numerical stability
-    return std::hypot(dx, dy);
+    if constexpr (N == 1) {
+      return std::fabs(d[0]);
+    } else if constexpr (N == 2) {
+      return std::hypot(d[0], d[1]);
+    } else if constexpr (N == 3) {
+      return std::hypot(d[0], d[1], d[2]);
+    } else {
+      // Scaled by the largest component, like hypot, so squares cannot overflow
+      dist_t scale{};
+      for (std::size_t i = 0; i < N; ++i) {
+        scale = std::fmax(scale, std::fabs(d[i]));
+      }
+      if (scale == dist_t{} || std::isinf(scale)) return scale;
+      dist_t sum{};
+      for (std::size_t i = 0; i < N; ++i) {
+        const dist_t r = d[i] / scale;
+        sum += r * r;
+      }
+      return scale * std::sqrt(sum);
+    }
   }
 
   // Equality comparison
-  bool operator==(const Point& rhs) const {
-    return x == rhs.x && y == rhs.y;
+  constexpr bool operator==(const Point& rhs) const noexcept {
+    return equal(rhs, Indices{});
   }
 
   // Inequality comparison
-  bool operator!=(const Point& rhs) const {
+  constexpr bool operator!=(const Point& rhs) const noexcept {
     return !(*this == rhs);
   }
 
   // Point addition
-  Point operator+(const Point& rhs) const {
-    return Point{x + rhs.x, y + rhs.y};
+  constexpr Point operator+(const Point& rhs) const noexcept {
+    return add(rhs, Indices{});
   }
 
   // Point subtraction
-  Point operator-(const Point& rhs) const {
-    return Point{x - rhs.x, y - rhs.y};
+  constexpr Point operator-(const Point& rhs) const noexcept {
+    return subtract(rhs, Indices{});
   }
 
   /**
@@ -80,11 +193,40 @@ public:
    * @return New point with promoted type
    */
   template <typename U>
-  auto operator*(U scalar) const -> Point<std::common_type_t<T, U>> {
+  constexpr auto operator*(U scalar) const noexcept -> Point<std::common_type_t<T, U>, N> {
+    return scale(scalar, Indices{});
+  }
+
+private:
+  template <std::size_t... I>
+  constexpr bool equal(const Point& rhs, std::index_sequence<I...>) const noexcept {
+    return (((*this)[I] == rhs[I]) && ...);
+  }
+
+  template <std::size_t... I>
+  constexpr Point add(const Point& rhs, std::index_sequence<I...>) const noexcept {
+    return Point{static_cast<T>((*this)[I] + rhs[I])...};
+  }
+
+  template <std::size_t... I>
+  constexpr Point subtract(const Point& rhs, std::index_sequence<I...>) const noexcept {
+    return Point{static_cast<T>((*this)[I] - rhs[I])...};
+  }
+
+  template <typename U, std::size_t... I>
+  constexpr auto scale(U scalar, std::index_sequence<I...>) const noexcept -> Point<std::common_type_t<T, U>, N> {
     using result_t = std::common_type_t<T, U>;
-    return Point<result_t>{
-      static_cast<result_t>(x) * static_cast<result_t>(scalar),
-      static_cast<result_t>(y) * static_cast<result_t>(scalar)
-    };
+    return Point<result_t, N>{static_cast<result_t>(static_cast<result_t>((*this)[I]) *
+                                                    static_cast<result_t>(scalar))...};
   }
 };
+
+// Fixed-dimension aliases; Point<T> is the same type as Point2<T>
+template <typename T>
+using Point2 = Point<T, 2>;
+
+template <typename T>
+using Point3 = Point<T, 3>;
+
+template <typename T>
+using Point4 = Point<T, 4>;
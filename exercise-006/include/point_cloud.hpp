@@ -0,0 +1,361 @@
+// point_cloud.hpp
+#pragma once
+
+#include "point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Batch kernels over coordinate arrays of a PointCloud
+ *
+ * Each kernel has an AVX2 and a portable scalar implementation for int, float
+ * and double coordinates. The variant is chosen once at runtime from the CPU
+ * feature flags; force_isa() overrides the choice (tests, benchmarks).
+ * Integer arithmetic wraps around on overflow in both variants.
+ */
+namespace cloud_simd {
+
+// Instruction set used by the kernels
+enum class Isa { Scalar, AVX2 };
+
+// Best instruction set supported by this CPU
+Isa detected_isa() noexcept;
+
+// Instruction set currently used by the kernels
+Isa active_isa() noexcept;
+
+// Uses 'isa' from now on if the CPU supports it; returns the active instruction set
+Isa force_isa(Isa isa) noexcept;
+
+// Name of an instruction set for log output ("scalar", "avx2")
+const char* isa_name(Isa isa) noexcept;
+
+// data[i] += value
+void add(int* data, std::size_t n, int value) noexcept;
+void add(float* data, std::size_t n, float value) noexcept;
+void add(double* data, std::size_t n, double value) noexcept;
+
+// data[i] += values[i]
+void add(int* data, const int* values, std::size_t n) noexcept;
+void add(float* data, const float* values, std::size_t n) noexcept;
+void add(double* data, const double* values, std::size_t n) noexcept;
+
+// data[i] *= factor
+void mul(int* data, std::size_t n, int factor) noexcept;
+void mul(float* data, std::size_t n, float factor) noexcept;
+void mul(double* data, std::size_t n, double factor) noexcept;
+
+// out[i] = a[i] + b[i]; out may be a or b
+void add(const int* a, const int* b, std::size_t n, int* out) noexcept;
+void add(const float* a, const float* b, std::size_t n, float* out) noexcept;
+void add(const double* a, const double* b, std::size_t n, double* out) noexcept;
+
+// data[i] = min(max(data[i], lo), hi); NaN stays NaN
+void clamp(int* data, std::size_t n, int lo, int hi) noexcept;
+void clamp(float* data, std::size_t n, float lo, float hi) noexcept;
+void clamp(double* data, std::size_t n, double lo, double hi) noexcept;
+
+/**
+ * @brief data[i] = lo + (data[i] - lo) mod (hi - lo), i.e. into [lo, hi) as on a torus
+ *
+ * Requires lo < hi. Exact for int. Float and double values less than one
+ * width outside take a single add or subtract, others a floor() division in
+ * the coordinate type; a result that rounds up to hi becomes lo, as does NaN.
+ */
+void wrap(int* data, std::size_t n, int lo, int hi) noexcept;
+void wrap(float* data, std::size_t n, float lo, float hi) noexcept;
+void wrap(double* data, std::size_t n, double lo, double hi) noexcept;
+
+/**
+ * @brief out[i] = distance from (xs[i], ys[i]) to (px, py)
+ *
+ * Computes sqrt(dx * dx + dy * dy) in double precision, which agrees with the
+ * std::hypot of Point<T>::distance_to() to within one ulp. Differences whose
+ * squares would overflow or underflow fall back to std::hypot. Both instruction
+ * sets produce identical results.
+ */
+void distances(const int* xs, const int* ys, std::size_t n, int px, int py, double* out) noexcept;
+void distances(const float* xs, const float* ys, std::size_t n, float px, float py, double* out) noexcept;
+void distances(const double* xs, const double* ys, std::size_t n, double px, double py, double* out) noexcept;
+
+// out[i] = dx * dx + dy * dy in double precision, without the square root
+void squared_distances(const int* xs, const int* ys, std::size_t n, int px, int py, double* out) noexcept;
+void squared_distances(const float* xs, const float* ys, std::size_t n, float px, float py, double* out) noexcept;
+void squared_distances(const double* xs, const double* ys, std::size_t n, double px, double py,
+                       double* out) noexcept;
+
+/**
+ * @brief Nearest of k centers for every point (xs[i], ys[i])
+ *
+ * labels[i] is the index of the center with the smallest squared distance,
+ * the lowest index on ties; squared[i] is that squared distance, computed as
+ * in squared_distances. Requires k >= 1.
+ */
+void nearest_center(const int* xs, const int* ys, std::size_t n, const double* cx, const double* cy, std::size_t k,
+                    std::uint32_t* labels, double* squared) noexcept;
+void nearest_center(const float* xs, const float* ys, std::size_t n, const double* cx, const double* cy, std::size_t k,
+                    std::uint32_t* labels, double* squared) noexcept;
+void nearest_center(const double* xs, const double* ys, std::size_t n, const double* cx, const double* cy,
+                    std::size_t k, std::uint32_t* labels, double* squared) noexcept;
+
+// Coordinate types with vectorized kernels
+template <typename T>
+constexpr bool has_kernels =
+  std::is_same<T, int>::value || std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+}  // namespace cloud_simd
+
+/**
+ * @brief Structure-of-arrays container for Point<T>
+ *
+ * The x and y coordinates live in two separate arrays aligned to 64 bytes, so
+ * batch operations stream through memory and map directly onto SIMD registers.
+ * Elements are read and written as Point<T> values; xs()/ys() expose the raw
+ * coordinate arrays. The batch operations give the same results as calling the
+ * corresponding Point<T> member on every point.
+ *
+ * @tparam T Arithmetic type (int, float, double, etc.)
+ */
+template <typename T>
+class PointCloud {
+  static_assert(std::is_arithmetic<T>::value,
+                "PointCloud<T>: T must be an arithmetic type");
+
+public:
+  using value_type = T;
+  using point_type = Point<T>;
+  using dist_t = typename Point<T>::dist_t;
+  using size_type = std::size_t;
+
+  // Alignment of both coordinate arrays (one cache line, two AVX2 registers)
+  static constexpr size_type alignment = 64;
+
+  PointCloud() = default;
+
+  // n points at the origin
+  explicit PointCloud(size_type n) { resize(n); }
+
+  PointCloud(std::initializer_list<Point<T>> points) : PointCloud(points.begin(), points.end()) {}
+
+  // Copies a range of Point<T>
+  template <typename It>
+  PointCloud(It first, It last) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  PointCloud(const PointCloud& other) {
+    reserve(other.m_size);
+    copy_coordinates(other.m_x, other.m_y, other.m_size);
+  }
+
+  PointCloud(PointCloud&& other) noexcept { swap(other); }
+
+  PointCloud& operator=(PointCloud other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~PointCloud() {
+    release(m_x);
+    release(m_y);
+  }
+
+  void swap(PointCloud& other) noexcept {
+    std::swap(m_x, other.m_x);
+    std::swap(m_y, other.m_y);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+  }
+
+  size_type size() const noexcept { return m_size; }
+  size_type capacity() const noexcept { return m_capacity; }
+  bool empty() const noexcept { return m_size == 0; }
+
+  // Raw coordinate arrays, aligned to 'alignment'
+  T* xs() noexcept { return m_x; }
+  T* ys() noexcept { return m_y; }
+  const T* xs() const noexcept { return m_x; }
+  const T* ys() const noexcept { return m_y; }
+
+  // Point i (unchecked)
+  Point<T> operator[](size_type i) const noexcept { return Point<T>{m_x[i], m_y[i]}; }
+
+  // Point i; throws std::out_of_range
+  Point<T> at(size_type i) const {
+    if (i >= m_size) throw std::out_of_range("PointCloud::at");
+    return (*this)[i];
+  }
+
+  // Overwrites point i (unchecked)
+  void set(size_type i, const Point<T>& p) noexcept {
+    m_x[i] = p.x;
+    m_y[i] = p.y;
+  }
+
+  void push_back(const Point<T>& p) {
+    if (m_size == m_capacity) {
+      reserve(m_capacity ? 2 * m_capacity : alignment / sizeof(T));
+    }
+    set(m_size++, p);
+  }
+
+  void reserve(size_type new_cap) {
+    if (new_cap <= m_capacity) return;
+    PointCloud grown;
+    grown.m_x = allocate(new_cap);
+    grown.m_y = allocate(new_cap);
+    grown.m_capacity = new_cap;
+    grown.copy_coordinates(m_x, m_y, m_size);
+    swap(grown);
+  }
+
+  // New points are placed at the origin
+  void resize(size_type n) {
+    reserve(n);
+    for (size_type i = m_size; i < n; ++i) {
+      m_x[i] = T{};
+      m_y[i] = T{};
+    }
+    m_size = n;
+  }
+
+  void clear() noexcept { m_size = 0; }
+
+  // Copies the points back into array-of-structs form
+  std::vector<Point<T>> to_points() const {
+    std::vector<Point<T>> points;
+    points.reserve(m_size);
+    for (size_type i = 0; i < m_size; ++i) {
+      points.push_back((*this)[i]);
+    }
+    return points;
+  }
+
+  /**
+   * @brief Move every point by dx and dy (batch Point::move)
+   * @param dx Delta x
+   * @param dy Delta y
+   */
+  void move(T dx, T dy) noexcept {
+    if constexpr (cloud_simd::has_kernels<T>) {
+      cloud_simd::add(m_x, m_size, dx);
+      cloud_simd::add(m_y, m_size, dy);
+    } else {
+      for (size_type i = 0; i < m_size; ++i) {
+        m_x[i] += dx;
+        m_y[i] += dy;
+      }
+    }
+  }
+
+  // Same as move(offset.x, offset.y)
+  void translate(const Point<T>& offset) noexcept { move(offset.x, offset.y); }
+
+  /**
+   * @brief Move point i by offsets[i] (batch Point::operator+)
+   * @throws std::invalid_argument if the sizes differ
+   */
+  void translate(const PointCloud& offsets) {
+    if (offsets.size() != m_size) {
+      throw std::invalid_argument("PointCloud::translate: size mismatch");
+    }
+    if constexpr (cloud_simd::has_kernels<T>) {
+      cloud_simd::add(m_x, offsets.m_x, m_size);
+      cloud_simd::add(m_y, offsets.m_y, m_size);
+    } else {
+      for (size_type i = 0; i < m_size; ++i) {
+        m_x[i] += offsets.m_x[i];
+        m_y[i] += offsets.m_y[i];
+      }
+    }
+  }
+
+  /**
+   * @brief Multiply all coordinates by factor (batch Point::operator* with a T scalar)
+   * @param factor Scale factor relative to the origin
+   */
+  void scale(T factor) noexcept { scale(factor, factor); }
+
+  // Scales x and y independently
+  void scale(T fx, T fy) noexcept {
+    if constexpr (cloud_simd::has_kernels<T>) {
+      cloud_simd::mul(m_x, m_size, fx);
+      cloud_simd::mul(m_y, m_size, fy);
+    } else {
+      for (size_type i = 0; i < m_size; ++i) {
+        m_x[i] *= fx;
+        m_y[i] *= fy;
+      }
+    }
+  }
+
+  /**
+   * @brief Distances from every point to p (batch Point::distance_to)
+   * @param p Reference point
+   * @param out Array of at least size() results
+   */
+  void distances_to(const Point<T>& p, dist_t* out) const noexcept {
+    if constexpr (cloud_simd::has_kernels<T>) {
+      cloud_simd::distances(m_x, m_y, m_size, p.x, p.y, out);
+    } else {
+      for (size_type i = 0; i < m_size; ++i) {
+        out[i] = (*this)[i].distance_to(p);
+      }
+    }
+  }
+
+  std::vector<dist_t> distances_to(const Point<T>& p) const {
+    std::vector<dist_t> out(m_size);
+    distances_to(p, out.data());
+    return out;
+  }
+
+  /**
+   * @brief Squared distances from every point to p, for comparisons that need no sqrt
+   * @param p Reference point
+   * @param out Array of at least size() results
+   */
+  void squared_distances_to(const Point<T>& p, dist_t* out) const noexcept {
+    if constexpr (cloud_simd::has_kernels<T>) {
+      cloud_simd::squared_distances(m_x, m_y, m_size, p.x, p.y, out);
+    } else {
+      for (size_type i = 0; i < m_size; ++i) {
+        const auto dx = static_cast<dist_t>(m_x[i]) - static_cast<dist_t>(p.x);
+        const auto dy = static_cast<dist_t>(m_y[i]) - static_cast<dist_t>(p.y);
+        out[i] = dx * dx + dy * dy;
+      }
+    }
+  }
+
+private:
+  static T* allocate(size_type n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+  }
+
+  static void release(T* data) noexcept {
+    if (data) ::operator delete(data, std::align_val_t{alignment});
+  }
+
+  // Requires enough capacity; arithmetic types are trivially copyable
+  void copy_coordinates(const T* xs, const T* ys, size_type n) noexcept {
+    if (n) {
+      std::memcpy(m_x, xs, n * sizeof(T));
+      std::memcpy(m_y, ys, n * sizeof(T));
+    }
+    m_size = n;
+  }
+
+  T* m_x = nullptr;
+  T* m_y = nullptr;
+  size_type m_size = 0;
+  size_type m_capacity = 0;
+};
@@ -0,0 +1,340 @@
+// point_dataset.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Versioned binary file format for Point<T, N> collections, read through mmap
+ *
+ * A file is a 64-byte Header followed by the coordinates at data_offset:
+ *  - Layout::Interleaved: count packed records of 'stride' = dimension *
+ *    element_size bytes (x, y, ...), without the alignment padding that
+ *    Point<T, N> may carry in memory (Point<double, 3> is 32 bytes, its
+ *    record 24), so files are reproducible byte for byte. Where Point<T, N>
+ *    has no padding (2 and 4 dimensions) the mapping is a Point<T, N> array
+ *  - Layout::Columns: one column of count coordinates per dimension (x, y, ...),
+ *    each starting at a multiple of 'alignment', like the arrays of PointCloud<T>
+ *
+ * Coordinates are stored in the byte order of the writer; a reader on a machine
+ * with the other byte order rejects the file instead of swapping, so views
+ * never copy. Dataset opens a file without parsing: coordinates<T>(),
+ * points<T, N>() and column<T>() return spans into the mapping.
+ *
+ * Usage:
+ *   point_dataset::write("points.pts", cloud);                  // columns
+ *   point_dataset::Dataset data("points.pts");
+ *   const double* xs = data.column<double>(0).data();
+ */
+namespace point_dataset {
+
+inline constexpr char magic[8] = {'P', 'O', 'I', 'N', 'T', 'S', '\0', '\0'};
+inline constexpr std::uint16_t version = 1;
+inline constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+enum class ElementType : std::uint8_t { Int32 = 1, Int64 = 2, Float32 = 3, Float64 = 4 };
+enum class Layout : std::uint8_t { Interleaved = 1, Columns = 2 };
+
+/**
+ * @brief On-disk header, 64 bytes at offset 0
+ */
+struct Header {
+  char magic[8];
+  std::uint32_t byte_order;   // byte_order_mark as written by the producer
+  std::uint16_t version;
+  std::uint8_t element_type;  // ElementType
+  std::uint8_t dimension;     // coordinates per point (1 to 255)
+  std::uint8_t layout;        // Layout
+  std::uint8_t element_size;  // bytes per coordinate
+  std::uint16_t reserved0;
+  std::uint32_t alignment;    // of data_offset and of every column; a power of two, >= element_size
+  std::uint64_t count;        // number of points
+  std::uint64_t stride;       // bytes per record (Interleaved) or per column (Columns)
+  std::uint64_t data_offset;  // first byte of the coordinates
+  std::uint8_t reserved[16];
+};
+
+static_assert(sizeof(Header) == 64, "point_dataset::Header must be 64 bytes");
+static_assert(std::is_trivially_copyable<Header>::value, "point_dataset::Header is written as raw bytes");
+
+// Element type of a coordinate type; fails to compile for unsupported types
+template <typename T>
+constexpr ElementType element_type_of() noexcept {
+  if constexpr (std::is_same<T, std::int32_t>::value) {
+    return ElementType::Int32;
+  } else if constexpr (std::is_same<T, std::int64_t>::value) {
+    return ElementType::Int64;
+  } else if constexpr (std::is_same<T, float>::value) {
+    return ElementType::Float32;
+  } else {
+    static_assert(std::is_same<T, double>::value, "point_dataset: coordinates must be int32, int64, float or double");
+    return ElementType::Float64;
+  }
+}
+
+// "int32", "int64", "float32", "float64"
+const char* element_type_name(ElementType type) noexcept;
+// Inverse of element_type_name; throws std::invalid_argument
+ElementType parse_element_type(const std::string& name);
+
+// "interleaved", "columns"
+const char* layout_name(Layout layout) noexcept;
+Layout parse_layout(const std::string& name);
+
+/**
+ * @brief Contiguous read-only range inside a mapping (C++17 has no std::span)
+ */
+template <typename T>
+class Span {
+public:
+  Span() = default;
+  Span(const T* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+
+  const T* data() const noexcept { return m_data; }
+  std::size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  const T& operator[](std::size_t i) const noexcept { return m_data[i]; }
+  const T* begin() const noexcept { return m_data; }
+  const T* end() const noexcept { return m_data + m_size; }
+
+private:
+  const T* m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+namespace detail {
+
+// Header for count points of the given type, with data_offset and stride filled in
+Header make_header(ElementType type, std::size_t element_size, std::size_t dimension, Layout layout,
+                   std::uint64_t count, std::size_t alignment);
+
+// Checks a header against the size of its file; throws std::runtime_error
+void validate(const Header& header, std::uint64_t file_size);
+
+/**
+ * @brief Output file with the header at the front and zero padding support
+ */
+class OutputFile {
+public:
+  explicit OutputFile(const std::string& path);
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
+  ~OutputFile();
+
+  void write(const void* data, std::size_t bytes);
+  void pad_to(std::uint64_t offset);
+  std::uint64_t offset() const noexcept { return m_offset; }
+
+  // Rewrites the header at offset 0 and closes the file; throws std::runtime_error
+  void finish(const Header& header);
+
+private:
+  std::FILE* m_file = nullptr;
+  std::string m_path;
+  std::uint64_t m_offset = 0;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Streams points into an interleaved dataset; the count is patched in on close()
+ */
+template <typename T, std::size_t N = 2>
+class Writer {
+public:
+  explicit Writer(const std::string& path, std::size_t alignment = 64)
+      : m_file(path), m_header(header(0, alignment)) {
+    m_file.write(&m_header, sizeof(m_header));
+    m_file.pad_to(m_header.data_offset);
+  }
+
+  void write(const Point<T, N>& p) { write(&p, 1); }
+
+  void write(const Point<T, N>* points, std::size_t n) {
+    if constexpr (sizeof(Point<T, N>) == N * sizeof(T)) {
+      m_file.write(points, n * sizeof(Point<T, N>));
+    } else {
+      // Copy the coordinates only, the padding bytes of Point<T, N> are indeterminate
+      for (std::size_t begin = 0; begin < n; begin += records_per_write) {
+        const std::size_t count = std::min(records_per_write, n - begin);
+        m_buffer.resize(count * N);
+        for (std::size_t i = 0; i < count; ++i) {
+          for (std::size_t d = 0; d < N; ++d) m_buffer[i * N + d] = points[begin + i][d];
+        }
+        m_file.write(m_buffer.data(), m_buffer.size() * sizeof(T));
+      }
+    }
+    m_count += n;
+  }
+
+  std::size_t size() const noexcept { return m_count; }
+
+  // Finishes the file; without close() the destructor leaves an empty dataset
+  void close() {
+    m_header.count = m_count;
+    m_file.finish(m_header);
+  }
+
+private:
+  static Header header(std::uint64_t count, std::size_t alignment) {
+    return detail::make_header(element_type_of<T>(), sizeof(T), N, Layout::Interleaved, count, alignment);
+  }
+
+  static constexpr std::size_t records_per_write = 4096;
+
+  detail::OutputFile m_file;
+  Header m_header;
+  std::size_t m_count = 0;
+  std::vector<T> m_buffer;  // packed records of padded points
+};
+
+// Writes points as an interleaved or column dataset; throws std::runtime_error on I/O errors
+template <typename T, std::size_t N>
+void write(const std::string& path, const std::vector<Point<T, N>>& points, Layout layout = Layout::Interleaved,
+           std::size_t alignment = 64) {
+  if (layout == Layout::Interleaved) {
+    Writer<T, N> writer(path, alignment);
+    writer.write(points.data(), points.size());
+    writer.close();
+    return;
+  }
+  const Header header =
+    detail::make_header(element_type_of<T>(), sizeof(T), N, Layout::Columns, points.size(), alignment);
+  detail::OutputFile file(path);
+  file.write(&header, sizeof(header));
+  std::vector<T> column(points.size());
+  for (std::size_t d = 0; d < N; ++d) {
+    file.pad_to(header.data_offset + d * header.stride);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      column[i] = points[i][d];
+    }
+    file.write(column.data(), column.size() * sizeof(T));
+  }
+  file.pad_to(header.data_offset + N * header.stride);
+  file.finish(header);
+}
+
+// Writes the x and y arrays of a PointCloud as a column dataset
+template <typename T>
+void write(const std::string& path, const PointCloud<T>& cloud, std::size_t alignment = 64) {
+  const Header header =
+    detail::make_header(element_type_of<T>(), sizeof(T), 2, Layout::Columns, cloud.size(), alignment);
+  detail::OutputFile file(path);
+  file.write(&header, sizeof(header));
+  file.pad_to(header.data_offset);
+  file.write(cloud.xs(), cloud.size() * sizeof(T));
+  file.pad_to(header.data_offset + header.stride);
+  file.write(cloud.ys(), cloud.size() * sizeof(T));
+  file.pad_to(header.data_offset + 2 * header.stride);
+  file.finish(header);
+}
+
+/**
+ * @brief Read-only memory mapping of a dataset file
+ *
+ * Opening validates the header only; the coordinates are paged in by the OS
+ * on first access. Views stay valid as long as the Dataset lives.
+ */
+class Dataset {
+public:
+  // Maps the file; throws std::runtime_error if it cannot be opened or is not a valid dataset
+  explicit Dataset(const std::string& path);
+  Dataset(Dataset&& other) noexcept;
+  Dataset& operator=(Dataset&& other) noexcept;
+  Dataset(const Dataset&) = delete;
+  Dataset& operator=(const Dataset&) = delete;
+  ~Dataset();
+
+  const Header& header() const noexcept { return *static_cast<const Header*>(m_data); }
+  ElementType element_type() const noexcept { return static_cast<ElementType>(header().element_type); }
+  Layout layout() const noexcept { return static_cast<Layout>(header().layout); }
+  std::size_t dimension() const noexcept { return header().dimension; }
+  std::size_t size() const noexcept { return static_cast<std::size_t>(header().count); }
+
+  /**
+   * @brief All coordinates of an interleaved dataset, record after record
+   *        (point i starts at i * dimension()), without copying
+   * @throws std::invalid_argument if T or the layout do not match the file
+   */
+  template <typename T>
+  Span<T> coordinates() const {
+    check(element_type_of<T>(), dimension(), Layout::Interleaved, "coordinates");
+    if (header().stride != dimension() * sizeof(T)) {
+      throw std::invalid_argument("point_dataset: records are not packed");
+    }
+    return {reinterpret_cast<const T*>(bytes() + header().data_offset), size() * dimension()};
+  }
+
+  /**
+   * @brief The points of an interleaved dataset, without copying
+   *
+   * Only possible where Point<T, N> has no padding, i.e. its size equals the
+   * record size (2 and 4 dimensions); use coordinates<T>() otherwise.
+   *
+   * @throws std::invalid_argument if T, N or the layout do not match the file
+   */
+  template <typename T, std::size_t N = 2>
+  Span<Point<T, N>> points() const {
+    check(element_type_of<T>(), N, Layout::Interleaved, "points");
+    if (header().stride != sizeof(Point<T, N>) || header().data_offset % alignof(Point<T, N>) != 0) {
+      throw std::invalid_argument("point_dataset: point stride or alignment differs from Point<T, N>");
+    }
+    return {reinterpret_cast<const Point<T, N>*>(bytes() + header().data_offset), size()};
+  }
+
+  /**
+   * @brief Coordinate d (0 = x, 1 = y, ...) of all points of a column dataset, without copying
+   * @throws std::invalid_argument if T or the layout do not match the file, std::out_of_range for d
+   */
+  template <typename T>
+  Span<T> column(std::size_t d) const {
+    check(element_type_of<T>(), dimension(), Layout::Columns, "column");
+    if (d >= dimension()) throw std::out_of_range("point_dataset: column index out of range");
+    return {reinterpret_cast<const T*>(bytes() + header().data_offset + d * header().stride), size()};
+  }
+
+private:
+  const unsigned char* bytes() const noexcept { return static_cast<const unsigned char*>(m_data); }
+  void check(ElementType type, std::size_t dimension, Layout layout, const char* what) const;
+  void release() noexcept;
+
+  void* m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+/**
+ * @brief Options of convert_json()
+ */
+struct ConvertOptions {
+  ElementType type = ElementType::Float64;
+  std::size_t dimension = 2;  // 2 to 4: objects need x, y and then z and w
+  Layout layout = Layout::Interleaved;
+  std::size_t alignment = 64;
+};
+
+/**
+ * @brief Converts the JSON the exercise-006 CLI emits into a dataset
+ *
+ * Accepts one document, NDJSON or concatenated documents. Every object with
+ * numeric "x" and "y" members (plus "z" and "w" for more dimensions) becomes
+ * one point, in the order in which the objects close, so {"pointA": {"x": 1,
+ * "y": 2}, ...} and {"points": [{"name": ..., "x": ..., "y": ...}]} both work.
+ * The input is read with a SAX parser; interleaved output is streamed, column
+ * output is collected in memory first.
+ *
+ * @return Number of points written
+ * @throws std::runtime_error on malformed JSON, values that do not fit the element type and I/O errors
+ */
+std::size_t convert_json(std::istream& in, const std::string& path, const ConvertOptions& options = {});
+
+}  // namespace point_dataset
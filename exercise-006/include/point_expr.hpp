@@ -0,0 +1,373 @@
+// point_expr.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lazy expression templates for Point<T, N> arithmetic
+ *
+ * The operators of Point<T, N> evaluate eagerly, so (a + b) * 2.5 - c builds
+ * a temporary point at every step. Wrapping one operand with expr::lazy()
+ * records the whole chain instead; it is evaluated once, component by
+ * component, by expr::eval() or by converting to the result point type.
+ * Types promote like the eager operators (same-type + and - keep T, scalar
+ * multiplication yields std::common_type_t<T, U>); unlike them, lazy
+ * expressions may also mix coordinate types.
+ *
+ * The placeholders _1 ... _4 stand for the i-th point of a batch, so one
+ * expression can be applied to whole std::vector<Point<T, N>> or PointCloud<T>
+ * inputs in a single pass without intermediate buffers:
+ *
+ *   using namespace expr::placeholders;
+ *   expr::apply((_1 + _2) * 2.5 - offset, out, a, b);  // out[i] = (a[i] + b[i]) * 2.5 - offset
+ *
+ * Every component of the result only depends on the same component of the
+ * inputs, so the output may be one of the inputs (in-place transform).
+ */
+namespace expr {
+
+/**
+ * @brief Common base of all expression nodes
+ *
+ * A node E provides 'dimension' (0 if it only depends on placeholders, whose
+ * dimension comes from the batch) and component<D>(args...), the D-th
+ * coordinate of the result for the batch elements args.
+ */
+template <typename E>
+struct Expression {
+  // Implicit conversion to exactly the result type, e.g. Point<double> r = expr::lazy(a) * 2.5;
+  template <typename T, std::size_t N, typename Self = E,
+            typename = std::enable_if_t<std::is_same<T, typename Self::template value_t<>>::value>>
+  constexpr operator Point<T, N>() const noexcept {
+    static_assert(N == E::dimension, "expr: result has a different dimension");
+    return eval(*this);
+  }
+};
+
+namespace detail {
+
+template <typename E>
+struct is_expr : std::is_base_of<Expression<E>, E> {};
+
+template <typename T>
+struct is_point : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_point<Point<T, N>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_operand = is_expr<T>::value || is_point<T>::value;
+
+// Dimension of a binary node; 0 means "taken from the batch"
+template <std::size_t L, std::size_t R>
+constexpr std::size_t common_dimension() noexcept {
+  static_assert(L == 0 || R == 0 || L == R, "expr: points of different dimension");
+  return L != 0 ? L : R;
+}
+
+// One element of a PointCloud batch, read in place
+template <typename T>
+struct CloudElement {
+  const T* x;
+  const T* y;
+  std::size_t i;
+};
+
+template <std::size_t D, typename T, std::size_t N>
+constexpr const T& get(const Point<T, N>& p) noexcept {
+  return p[D];
+}
+
+template <std::size_t D, typename T>
+constexpr const T& get(const CloudElement<T>& e) noexcept {
+  static_assert(D < 2, "expr: PointCloud has two dimensions");
+  if constexpr (D == 0) {
+    return e.x[e.i];
+  } else {
+    return e.y[e.i];
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief A point stored in the expression (by value, so expressions may outlive it)
+ */
+template <typename T, std::size_t N>
+struct Constant : Expression<Constant<T, N>> {
+  static constexpr std::size_t dimension = N;
+  template <typename... Args>
+  using value_t = T;
+
+  Point<T, N> point;
+
+  constexpr explicit Constant(const Point<T, N>& p) noexcept : point(p) {}
+
+  template <std::size_t D, typename... Args>
+  constexpr T component(const Args&...) const noexcept {
+    return point[D];
+  }
+};
+
+/**
+ * @brief The I-th input of a batch (zero-based); see expr::placeholders
+ */
+template <std::size_t I>
+struct Placeholder : Expression<Placeholder<I>> {
+  static constexpr std::size_t dimension = 0;
+  template <typename... Args>
+  using value_t = std::decay_t<decltype(detail::get<0>(std::get<I>(std::declval<std::tuple<const Args&...>>())))>;
+
+  template <std::size_t D, typename... Args>
+  constexpr auto component(const Args&... args) const noexcept {
+    static_assert(I < sizeof...(Args), "expr: placeholder without matching input");
+    return detail::get<D>(std::get<I>(std::forward_as_tuple(args...)));
+  }
+};
+
+namespace placeholders {
+
+inline constexpr Placeholder<0> _1{};
+inline constexpr Placeholder<1> _2{};
+inline constexpr Placeholder<2> _3{};
+inline constexpr Placeholder<3> _4{};
+
+}  // namespace placeholders
+
+// l + r and l - r, computed in the common type of both sides
+template <typename L, typename R, bool Subtract>
+struct Sum : Expression<Sum<L, R, Subtract>> {
+  static constexpr std::size_t dimension = detail::common_dimension<L::dimension, R::dimension>();
+  template <typename... Args>
+  using value_t = std::common_type_t<typename L::template value_t<Args...>, typename R::template value_t<Args...>>;
+
+  L lhs;
+  R rhs;
+
+  constexpr Sum(const L& l, const R& r) noexcept : lhs(l), rhs(r) {}
+
+  template <std::size_t D, typename... Args>
+  constexpr auto component(const Args&... args) const noexcept -> value_t<Args...> {
+    using result_t = value_t<Args...>;
+    const auto l = static_cast<result_t>(lhs.template component<D>(args...));
+    const auto r = static_cast<result_t>(rhs.template component<D>(args...));
+    if constexpr (Subtract) {
+      return static_cast<result_t>(l - r);
+    } else {
+      return static_cast<result_t>(l + r);
+    }
+  }
+};
+
+// e * scalar with the promotion of Point::operator*
+template <typename E, typename U>
+struct Scaled : Expression<Scaled<E, U>> {
+  static constexpr std::size_t dimension = E::dimension;
+  template <typename... Args>
+  using value_t = std::common_type_t<typename E::template value_t<Args...>, U>;
+
+  E inner;
+  U scalar;
+
+  constexpr Scaled(const E& e, U s) noexcept : inner(e), scalar(s) {}
+
+  template <std::size_t D, typename... Args>
+  constexpr auto component(const Args&... args) const noexcept -> value_t<Args...> {
+    using result_t = value_t<Args...>;
+    return static_cast<result_t>(static_cast<result_t>(inner.template component<D>(args...)) *
+                                 static_cast<result_t>(scalar));
+  }
+};
+
+template <typename E>
+struct Negated : Expression<Negated<E>> {
+  static constexpr std::size_t dimension = E::dimension;
+  template <typename... Args>
+  using value_t = typename E::template value_t<Args...>;
+
+  E inner;
+
+  constexpr explicit Negated(const E& e) noexcept : inner(e) {}
+
+  template <std::size_t D, typename... Args>
+  constexpr auto component(const Args&... args) const noexcept -> value_t<Args...> {
+    return static_cast<value_t<Args...>>(-inner.template component<D>(args...));
+  }
+};
+
+// Starts a lazy expression from a point
+template <typename T, std::size_t N>
+constexpr Constant<T, N> lazy(const Point<T, N>& p) noexcept {
+  return Constant<T, N>(p);
+}
+
+namespace detail {
+
+template <typename E>
+constexpr const E& as_expr(const Expression<E>& e) noexcept {
+  return static_cast<const E&>(e);
+}
+
+template <typename T, std::size_t N>
+constexpr Constant<T, N> as_expr(const Point<T, N>& p) noexcept {
+  return Constant<T, N>(p);
+}
+
+template <typename X>
+using expr_t = std::decay_t<decltype(as_expr(std::declval<const X&>()))>;
+
+// Enables the operators if at least one side is an expression and the other one is an expression or a point
+template <typename L, typename R>
+using enable_binary = std::enable_if_t<is_operand<L> && is_operand<R> && (is_expr<L>::value || is_expr<R>::value)>;
+
+template <typename E, std::size_t... D>
+constexpr auto evaluate(const E& e, std::index_sequence<D...>) noexcept {
+  using result_t = typename E::template value_t<>;
+  return Point<result_t, E::dimension>{e.template component<D>()...};
+}
+
+}  // namespace detail
+
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+constexpr auto operator+(const L& l, const R& r) noexcept {
+  return Sum<detail::expr_t<L>, detail::expr_t<R>, false>(detail::as_expr(l), detail::as_expr(r));
+}
+
+template <typename L, typename R, typename = detail::enable_binary<L, R>>
+constexpr auto operator-(const L& l, const R& r) noexcept {
+  return Sum<detail::expr_t<L>, detail::expr_t<R>, true>(detail::as_expr(l), detail::as_expr(r));
+}
+
+template <typename E, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+constexpr Scaled<E, U> operator*(const Expression<E>& e, U scalar) noexcept {
+  return Scaled<E, U>(detail::as_expr(e), scalar);
+}
+
+template <typename E, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+constexpr Scaled<E, U> operator*(U scalar, const Expression<E>& e) noexcept {
+  return Scaled<E, U>(detail::as_expr(e), scalar);
+}
+
+template <typename E>
+constexpr Negated<E> operator-(const Expression<E>& e) noexcept {
+  return Negated<E>(detail::as_expr(e));
+}
+
+/**
+ * @brief Evaluates an expression without placeholders in one pass
+ * @return Point<value type of the expression, dimension>
+ */
+template <typename E>
+constexpr auto eval(const Expression<E>& e) noexcept {
+  static_assert(E::dimension > 0, "expr::eval: expression needs batch inputs, use expr::apply()");
+  return detail::evaluate(detail::as_expr(e), std::make_index_sequence<E::dimension>{});
+}
+
+namespace detail {
+
+/**
+ * @brief Element access for the batch types accepted by expr::apply()
+ */
+template <typename C>
+struct Batch;
+
+template <typename T, std::size_t N, typename Alloc>
+struct Batch<std::vector<Point<T, N>, Alloc>> {
+  static constexpr std::size_t dimension = N;
+  using container = std::vector<Point<T, N>, Alloc>;
+
+  static std::size_t size(const container& c) noexcept { return c.size(); }
+  static void resize(container& c, std::size_t n) { c.resize(n); }
+  static const Point<T, N>& element(const container& c, std::size_t i) noexcept { return c[i]; }
+
+  template <std::size_t D, typename V>
+  static void store(container& c, std::size_t i, V value) noexcept {
+    c[i][D] = static_cast<T>(value);
+  }
+};
+
+template <typename T>
+struct Batch<PointCloud<T>> {
+  static constexpr std::size_t dimension = 2;
+  using container = PointCloud<T>;
+
+  static std::size_t size(const container& c) noexcept { return c.size(); }
+  static void resize(container& c, std::size_t n) { c.resize(n); }
+  static CloudElement<T> element(const container& c, std::size_t i) noexcept { return {c.xs(), c.ys(), i}; }
+
+  template <std::size_t D, typename V>
+  static void store(container& c, std::size_t i, V value) noexcept {
+    if constexpr (D == 0) {
+      c.xs()[i] = static_cast<T>(value);
+    } else {
+      c.ys()[i] = static_cast<T>(value);
+    }
+  }
+};
+
+template <typename E, typename Out, typename... In>
+std::size_t prepare(Out& out, const In&... in) {
+  static_assert(sizeof...(In) > 0, "expr::apply: needs at least one input");
+  constexpr std::size_t n = Batch<Out>::dimension;
+  static_assert(((Batch<In>::dimension == n) && ...), "expr::apply: inputs and output differ in dimension");
+  static_assert(E::dimension == 0 || E::dimension == n, "expr::apply: expression has a different dimension");
+
+  const std::size_t sizes[] = {Batch<In>::size(in)...};
+  const std::size_t count = sizes[0];
+  if (std::any_of(std::begin(sizes), std::end(sizes), [count](std::size_t s) { return s != count; })) {
+    throw std::invalid_argument("expr::apply: inputs differ in size");
+  }
+  Batch<Out>::resize(out, count);
+  return count;
+}
+
+template <typename E, typename Out, typename... In, std::size_t... D>
+void apply_range(const E& e, Out& out, std::size_t begin, std::size_t end, std::index_sequence<D...>,
+                 const In&... in) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    (Batch<Out>::template store<D>(out, i, e.template component<D>(Batch<In>::element(in, i)...)), ...);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief out[i] = e evaluated on (in[i]...) for every i, in one pass
+ *
+ * Inputs and output are std::vector<Point<T, N>> or PointCloud<T>; the
+ * placeholder _k refers to the k-th input. out is resized to the common input
+ * size and may be one of the inputs. Results are converted to the coordinate
+ * type of out.
+ * @throws std::invalid_argument if the inputs differ in size
+ */
+template <typename E, typename Out, typename... In>
+void apply(const Expression<E>& e, Out& out, const In&... in) {
+  const std::size_t count = detail::prepare<E>(out, in...);
+  detail::apply_range(detail::as_expr(e), out, 0, count, std::make_index_sequence<detail::Batch<Out>::dimension>{},
+                      in...);
+}
+
+/**
+ * @brief Like apply(), with the batch split into chunks that run on the pool
+ */
+template <typename E, typename Out, typename... In>
+void parallel_apply(ThreadPool& pool, const Expression<E>& e, Out& out, const In&... in) {
+  constexpr std::size_t chunk = 1 << 14;
+  const std::size_t count = detail::prepare<E>(out, in...);
+  pool.parallel_for((count + chunk - 1) / chunk, [&](std::size_t c) {
+    detail::apply_range(detail::as_expr(e), out, c * chunk, std::min(count, (c + 1) * chunk),
+                        std::make_index_sequence<detail::Batch<Out>::dimension>{}, in...);
+  });
+}
+
+}  // namespace expr
@@ -5,17 +5,23 @@
 #include <fmt/core.h>
 
 /**
- * @brief fmt formatter specialization for Point<T>
+ * @brief fmt formatter specialization for Point<T, N>
  * Allows using Point with fmt::print, fmt::format, etc.
  * 
  * Usage:
  *   Point<int> p{1, 2};
  *   fmt::print("{}", p);  // Output: (1, 2)
+ *   Point3<int> q{1, 2, 3};
+ *   fmt::print("{}", q);  // Output: (1, 2, 3)
  */
-template <typename T>
-struct fmt::formatter<Point<T>> : fmt::formatter<std::string_view> {
+template <typename T, std::size_t N>
+struct fmt::formatter<Point<T, N>> : fmt::formatter<std::string_view> {
   template <typename FormatContext>
-  auto format(const Point<T>& p, FormatContext& ctx) const {
-    return fmt::format_to(ctx.out(), "({}, {})", p.x, p.y);
+  auto format(const Point<T, N>& p, FormatContext& ctx) const {
+    auto out = fmt::format_to(ctx.out(), "({}", p[0]);
+    for (std::size_t i = 1; i < N; ++i) {
+      out = fmt::format_to(out, ", {}", p[i]);
+    }
+    return fmt::format_to(out, ")");
   }
 };
@@ -0,0 +1,395 @@
+// point_reduce.hpp
+#pragma once
+
+#include "point.hpp"
+#include "point_cloud.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Chunking and thread pool of the point reductions
+ */
+struct ReduceOptions {
+  std::size_t chunk_size = 1 << 14;  // points per task; closest_pair splits no further than this in parallel
+  ThreadPool* pool = nullptr;        // nullptr uses ThreadPool::shared()
+};
+
+/**
+ * @brief Smallest axis-aligned box that contains all points, borders included
+ */
+template <typename T>
+struct BoundingBox {
+  Point<T> min;
+  Point<T> max;
+
+  bool contains(const Point<T>& p) const noexcept {
+    return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y;
+  }
+};
+
+/**
+ * @brief Result of farthest_point(): position in the range and distance to the query point
+ */
+struct FarthestPoint {
+  std::size_t index = 0;
+  double distance = 0.0;
+};
+
+/**
+ * @brief Result of closest_pair(): positions in the range (first < second) and their distance
+ */
+struct ClosestPair {
+  std::size_t first = 0;
+  std::size_t second = 0;
+  double distance = 0.0;
+};
+
+namespace reduce_detail {
+
+/**
+ * @brief Neumaier's compensated sum: the rounding error of every addition is
+ *        collected separately and added back at the end
+ */
+struct CompensatedSum {
+  double sum = 0.0;
+  double error = 0.0;
+
+  void add(double v) noexcept {
+    const double t = sum + v;
+    error += std::fabs(sum) >= std::fabs(v) ? (sum - t) + v : (v - t) + sum;
+    sum = t;
+  }
+
+  void add(const CompensatedSum& other) noexcept {
+    add(other.sum);
+    error += other.error;
+  }
+
+  double mean(std::size_t n) const noexcept { return (sum + error) / static_cast<double>(n); }
+};
+
+/**
+ * @brief Exact sum of integers of up to 32 bits
+ *
+ * Every value is below 2^32 in magnitude, so a sum of up to 2^31 values fits
+ * in 64 bits; int values are at most 2^31 in magnitude, so for them the bound
+ * is 2^32 - 1 values. Longer ranges would overflow.
+ */
+struct ExactSum {
+  std::int64_t sum = 0;
+
+  void add(std::int64_t v) noexcept { sum += v; }
+  void add(const ExactSum& other) noexcept { sum += other.sum; }
+
+  // Quotient and remainder separately, so the sum is never rounded to double
+  double mean(std::size_t n) const noexcept {
+    const auto count = static_cast<std::int64_t>(n);
+    return static_cast<double>(sum / count) + static_cast<double>(sum % count) / static_cast<double>(n);
+  }
+};
+
+template <typename T>
+using Sum = std::conditional_t<std::is_integral<T>::value && sizeof(T) <= 4, ExactSum, CompensatedSum>;
+
+template <typename T>
+struct AxisSums {
+  Sum<T> x;
+  Sum<T> y;
+};
+
+inline ThreadPool& pool_of(const ReduceOptions& options) {
+  return options.pool ? *options.pool : ThreadPool::shared();
+}
+
+inline void require_points(std::size_t n, std::size_t minimum, const char* what) {
+  if (n < minimum) throw std::invalid_argument(std::string(what) + ": too few points");
+}
+
+// at(i) returns point i of a range of n points, for iterators and PointCloud alike
+template <typename T, typename At>
+Point<double> centroid(std::size_t n, At at, const ReduceOptions& options) {
+  require_points(n, 1, "centroid");
+  const AxisSums<T> total = pool_of(options).parallel_reduce(
+    n, options.chunk_size, AxisSums<T>{},
+    [&](std::size_t begin, std::size_t end) {
+      AxisSums<T> sums;
+      for (std::size_t i = begin; i < end; ++i) {
+        const Point<T> p = at(i);
+        sums.x.add(p.x);
+        sums.y.add(p.y);
+      }
+      return sums;
+    },
+    [](AxisSums<T> acc, const AxisSums<T>& part) {
+      acc.x.add(part.x);
+      acc.y.add(part.y);
+      return acc;
+    });
+  return {total.x.mean(n), total.y.mean(n)};
+}
+
+template <typename T, typename At>
+BoundingBox<T> bounding_box(std::size_t n, At at, const ReduceOptions& options) {
+  require_points(n, 1, "bounding_box");
+  const Point<T> first = at(0);
+  return pool_of(options).parallel_reduce(
+    n, options.chunk_size, BoundingBox<T>{first, first},
+    [&](std::size_t begin, std::size_t end) {
+      BoundingBox<T> box{at(begin), at(begin)};
+      for (std::size_t i = begin + 1; i < end; ++i) {
+        const Point<T> p = at(i);
+        box.min = {std::min(box.min.x, p.x), std::min(box.min.y, p.y)};
+        box.max = {std::max(box.max.x, p.x), std::max(box.max.y, p.y)};
+      }
+      return box;
+    },
+    [](BoundingBox<T> acc, const BoundingBox<T>& part) {
+      acc.min = {std::min(acc.min.x, part.min.x), std::min(acc.min.y, part.min.y)};
+      acc.max = {std::max(acc.max.x, part.max.x), std::max(acc.max.y, part.max.y)};
+      return acc;
+    });
+}
+
+// Squared distances in double, so int coordinates cannot overflow
+template <typename T>
+double squared_distance(const Point<T>& p, const Point<double>& q) noexcept {
+  const double dx = static_cast<double>(p.x) - q.x;
+  const double dy = static_cast<double>(p.y) - q.y;
+  return dx * dx + dy * dy;
+}
+
+template <typename T, typename At>
+FarthestPoint farthest_point(std::size_t n, At at, const Point<double>& from, const ReduceOptions& options) {
+  require_points(n, 1, "farthest_point");
+  // Chunks fold in order and only a strictly larger distance wins, so ties go to the lowest index
+  FarthestPoint best = pool_of(options).parallel_reduce(
+    n, options.chunk_size, FarthestPoint{0, -1.0},
+    [&](std::size_t begin, std::size_t end) {
+      FarthestPoint chunk{begin, -1.0};
+      for (std::size_t i = begin; i < end; ++i) {
+        const double d = squared_distance(at(i), from);
+        if (d > chunk.distance) chunk = {i, d};
+      }
+      return chunk;
+    },
+    [](const FarthestPoint& acc, const FarthestPoint& part) { return part.distance > acc.distance ? part : acc; });
+  best.distance = std::sqrt(best.distance);
+  return best;
+}
+
+// A point of the closest pair search, with its position in the input
+struct Item {
+  double x;
+  double y;
+  std::size_t index;
+};
+
+// Best pair so far, by squared distance
+struct Pair {
+  double squared = std::numeric_limits<double>::infinity();
+  std::size_t first = 0;
+  std::size_t second = 0;
+
+  void consider(const Item& a, const Item& b) noexcept {
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    const double d = dx * dx + dy * dy;
+    if (d < squared) *this = {d, std::min(a.index, b.index), std::max(a.index, b.index)};
+  }
+};
+
+inline bool by_x(const Item& a, const Item& b) noexcept { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+inline bool by_y(const Item& a, const Item& b) noexcept { return a.y < b.y; }
+
+// Runs both halves of a split, in parallel once there is enough work for the pool
+template <typename Left, typename Right>
+void fork(ThreadPool& pool, bool parallel, Left&& left, Right&& right) {
+  if (!parallel) {
+    left();
+    right();
+    return;
+  }
+  pool.parallel_for(2, [&](std::size_t half) { half == 0 ? left() : right(); });
+}
+
+// Merge sort by x; scratch holds n items
+inline void sort_by_x(ThreadPool& pool, Item* items, Item* scratch, std::size_t n, std::size_t grain) {
+  if (n <= grain) {
+    std::sort(items, items + n, by_x);
+    return;
+  }
+  const std::size_t mid = n / 2;
+  fork(
+    pool, true, [&] { sort_by_x(pool, items, scratch, mid, grain); },
+    [&] { sort_by_x(pool, items + mid, scratch + mid, n - mid, grain); });
+  std::merge(items, items + mid, items + mid, items + n, scratch, by_x);
+  std::copy(scratch, scratch + n, items);
+}
+
+/**
+ * @brief Closest pair of items[0, n), which are sorted by x (Shamos & Hoare)
+ *
+ * Splits at the median x, solves both halves, then only has to look at the
+ * strip of width 2d around the split line, where d is the better result of
+ * the halves. Each half comes back sorted by y, so merging them keeps the
+ * strip sorted by y and a point needs to be compared only with its next few
+ * neighbours in the strip: O(n log n) overall. scratch holds n items.
+ */
+inline Pair closest(ThreadPool& pool, Item* items, Item* scratch, std::size_t n, std::size_t grain) {
+  Pair best;
+  if (n <= 3) {
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = i + 1; j < n; ++j) best.consider(items[i], items[j]);
+    }
+    std::sort(items, items + n, by_y);
+    return best;
+  }
+
+  const std::size_t mid = n / 2;
+  const double split = items[mid].x;
+  Pair left;
+  Pair right;
+  fork(
+    pool, n > grain, [&] { left = closest(pool, items, scratch, mid, grain); },
+    [&] { right = closest(pool, items + mid, scratch + mid, n - mid, grain); });
+  best = right.squared < left.squared ? right : left;
+
+  std::merge(items, items + mid, items + mid, items + n, scratch, by_y);
+  std::copy(scratch, scratch + n, items);
+
+  Item* strip = scratch;
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double dx = items[i].x - split;
+    if (dx * dx < best.squared) strip[size++] = items[i];
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    for (std::size_t j = i + 1; j < size; ++j) {
+      const double dy = strip[j].y - strip[i].y;
+      if (dy * dy >= best.squared) break;
+      best.consider(strip[i], strip[j]);
+    }
+  }
+  return best;
+}
+
+template <typename T, typename At>
+ClosestPair closest_pair(std::size_t n, At at, const ReduceOptions& options) {
+  require_points(n, 2, "closest_pair");
+  ThreadPool& pool = pool_of(options);
+  const std::size_t grain = std::max<std::size_t>(options.chunk_size, 4);
+  std::vector<Item> items(n);
+  std::vector<Item> scratch(n);
+  pool.parallel_for((n + grain - 1) / grain, [&](std::size_t c) {
+    const std::size_t end = std::min(n, (c + 1) * grain);
+    for (std::size_t i = c * grain; i < end; ++i) {
+      const Point<T> p = at(i);
+      items[i] = {static_cast<double>(p.x), static_cast<double>(p.y), i};
+    }
+  });
+  sort_by_x(pool, items.data(), scratch.data(), n, grain);
+  const Pair best = closest(pool, items.data(), scratch.data(), n, grain);
+  return {best.first, best.second, std::sqrt(best.squared)};
+}
+
+// T of a random access range of Point<T>
+template <typename It>
+using coordinate_t = typename std::iterator_traits<It>::value_type::value_type;
+
+template <typename It>
+auto at(It first) {
+  static_assert(std::is_same<typename std::iterator_traits<It>::value_type, Point<coordinate_t<It>>>::value,
+                "point reductions need a random access range of Point<T>");
+  return [first](std::size_t i) { return first[static_cast<std::ptrdiff_t>(i)]; };
+}
+
+template <typename T>
+auto at(const PointCloud<T>& cloud) {
+  return [&cloud](std::size_t i) { return cloud[i]; };
+}
+
+}  // namespace reduce_detail
+
+/**
+ * @brief Mean of all points, in parallel chunks
+ *
+ * Coordinates of up to 32-bit integer types are summed exactly in 64 bits,
+ * which cannot overflow for ranges of up to 2^31 points (2^32 - 1 for
+ * Point<int>); the mean is taken from quotient and remainder. Floating point
+ * and 64-bit integer coordinates are summed in double with Neumaier
+ * compensation. Chunks are folded in order, so the result does not depend on
+ * the number of threads.
+ *
+ * @throws std::invalid_argument if the range is empty
+ */
+template <typename It>
+Point<double> centroid(It first, It last, const ReduceOptions& options = {}) {
+  return reduce_detail::centroid<reduce_detail::coordinate_t<It>>(static_cast<std::size_t>(last - first),
+                                                                   reduce_detail::at(first), options);
+}
+
+template <typename T>
+Point<double> centroid(const PointCloud<T>& cloud, const ReduceOptions& options = {}) {
+  return reduce_detail::centroid<T>(cloud.size(), reduce_detail::at(cloud), options);
+}
+
+/**
+ * @brief Smallest axis-aligned box around all points
+ * @throws std::invalid_argument if the range is empty
+ */
+template <typename It>
+BoundingBox<reduce_detail::coordinate_t<It>> bounding_box(It first, It last, const ReduceOptions& options = {}) {
+  return reduce_detail::bounding_box<reduce_detail::coordinate_t<It>>(static_cast<std::size_t>(last - first),
+                                                                       reduce_detail::at(first), options);
+}
+
+template <typename T>
+BoundingBox<T> bounding_box(const PointCloud<T>& cloud, const ReduceOptions& options = {}) {
+  return reduce_detail::bounding_box<T>(cloud.size(), reduce_detail::at(cloud), options);
+}
+
+/**
+ * @brief The point farthest from 'from'; ties go to the lowest index
+ * @throws std::invalid_argument if the range is empty
+ */
+template <typename It>
+FarthestPoint farthest_point(It first, It last, const Point<double>& from, const ReduceOptions& options = {}) {
+  return reduce_detail::farthest_point<reduce_detail::coordinate_t<It>>(static_cast<std::size_t>(last - first),
+                                                                         reduce_detail::at(first), from, options);
+}
+
+template <typename T>
+FarthestPoint farthest_point(const PointCloud<T>& cloud, const Point<double>& from, const ReduceOptions& options = {}) {
+  return reduce_detail::farthest_point<T>(cloud.size(), reduce_detail::at(cloud), from, options);
+}
+
+/**
+ * @brief Two points with the smallest distance of all pairs, in O(n log n)
+ *
+ * Divide and conquer on the points sorted by x; both the merge sort and the
+ * recursion hand their halves to the pool until they are smaller than
+ * options.chunk_size. Distances are computed in double. If several pairs are
+ * equally close, one of them is returned, the same one for any thread count.
+ *
+ * @throws std::invalid_argument if there are fewer than two points
+ */
+template <typename It>
+ClosestPair closest_pair(It first, It last, const ReduceOptions& options = {}) {
+  return reduce_detail::closest_pair<reduce_detail::coordinate_t<It>>(static_cast<std::size_t>(last - first),
+                                                                       reduce_detail::at(first), options);
+}
+
+template <typename T>
+ClosestPair closest_pair(const PointCloud<T>& cloud, const ReduceOptions& options = {}) {
+  return reduce_detail::closest_pair<T>(cloud.size(), reduce_detail::at(cloud), options);
+}
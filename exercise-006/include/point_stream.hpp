@@ -0,0 +1,125 @@
+// point_stream.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+/**
+ * @brief Batch processing of point records for the CLI: read, compute, write
+ *
+ * Every input record holds four numbers (two points, or a point and a delta)
+ * and yields one output record. Records are read and written through fixed
+ * size buffers, so memory stays bounded for inputs of any size.
+ *
+ * Formats:
+ *  - csv:    one record per line, comma separated; an optional header as the
+ *            first non-blank line
+ *  - ndjson: one flat JSON object per line, e.g. {"x1": 0, "y1": 0, "x2": 3, "y2": 4};
+ *            every key exactly once
+ *  - binary: packed doubles in native byte order, no header
+ */
+namespace point_stream {
+
+enum class Format { Csv, Ndjson, Binary };
+
+// distance: x1 y1 x2 y2 -> distance; move: x y dx dy -> x y;
+// arithmetic: ax ay bx by -> A + B, A - B and A * scalar
+enum class Operation { Distance, Move, Arithmetic };
+
+// Parse the names used on the command line ("csv", "distance", ...); throw std::invalid_argument
+Format parse_format(std::string_view name);
+Operation parse_operation(std::string_view name);
+
+// Field names of the input and output records, in record order
+const std::vector<std::string>& input_fields(Operation op);
+const std::vector<std::string>& output_fields(Operation op);
+
+// Maximum number of fields of any record
+inline constexpr std::size_t max_fields = 6;
+
+/**
+ * @brief Reads input records from a file through a fixed-size buffer
+ *
+ * Lines may be longer than the buffer, it then grows to the longest line.
+ */
+class RecordReader {
+public:
+  RecordReader(std::FILE* in, Format format, Operation op, std::size_t buffer_size = 1 << 16);
+
+  /**
+   * @brief Reads the next record into fields[0 .. input_fields(op).size())
+   * @return false at the end of the input
+   * @throws std::runtime_error on malformed input (with the line or record number) and read errors
+   */
+  bool next(double* fields);
+
+private:
+  bool next_line(std::string_view& line);
+  bool fill();
+  void parse_csv(std::string_view line, double* fields);
+  void parse_ndjson(std::string_view line, double* fields);
+  [[noreturn]] void fail(const std::string& what) const;
+
+  std::FILE* m_in;
+  Format m_format;
+  const std::vector<std::string>& m_fields;
+  std::vector<char> m_buffer;
+  std::size_t m_begin = 0;  // unread bytes are m_buffer[m_begin, m_end)
+  std::size_t m_end = 0;
+  bool m_eof = false;
+  std::size_t m_line = 0;   // lines (csv, ndjson) or records (binary) read so far
+  bool m_content = false;   // a non-blank line has been read, so headers are no longer expected
+};
+
+/**
+ * @brief Writes output records into a buffer that is flushed once it exceeds a threshold
+ */
+class RecordWriter {
+public:
+  RecordWriter(std::FILE* out, Format format, Operation op, std::size_t flush_threshold = 1 << 16);
+  RecordWriter(const RecordWriter&) = delete;
+  RecordWriter& operator=(const RecordWriter&) = delete;
+
+  // Flushes what is left; errors are only reported by flush()
+  ~RecordWriter();
+
+  // Appends fields[0 .. output_fields(op).size())
+  void write(const double* fields);
+
+  // Writes the buffer to the file; throws std::runtime_error on write errors
+  void flush();
+
+private:
+  std::FILE* m_out;
+  Format m_format;
+  const std::vector<std::string>& m_fields;
+  std::size_t m_threshold;
+  fmt::memory_buffer m_buffer;
+};
+
+struct Options {
+  Operation operation = Operation::Distance;
+  Format input_format = Format::Csv;
+  Format output_format = Format::Csv;
+  double scalar = 2.5;  // factor of the arithmetic operation
+};
+
+struct Stats {
+  std::size_t records = 0;
+  double seconds = 0.0;
+
+  double records_per_second() const noexcept { return seconds > 0 ? static_cast<double>(records) / seconds : 0.0; }
+};
+
+// Computes the output record of one input record
+void compute(const Options& options, const double* input, double* output) noexcept;
+
+// Reads every record of in, computes it and writes the result to out
+Stats process(std::FILE* in, std::FILE* out, const Options& options);
+
+}  // namespace point_stream
@@ -0,0 +1,185 @@
+// thread_pool.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads with a shared FIFO task queue
+ *
+ * submit() runs a single task and returns a future for its result.
+ * parallel_for() spreads an index range over the workers; the calling thread
+ * takes part, so nested calls from inside a task cannot deadlock.
+ */
+class ThreadPool {
+public:
+  // threads == 0 uses one worker per hardware thread
+  explicit ThreadPool(std::size_t threads = 0) {
+    if (threads == 0) {
+      threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      m_workers.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Finishes the queued tasks, then joins the workers
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  // Number of worker threads
+  std::size_t size() const noexcept { return m_workers.size(); }
+
+  /**
+   * @brief Queue fn for execution on a worker
+   * @return Future that yields the result or rethrows the exception of fn
+   */
+  template <typename Fn>
+  auto submit(Fn fn) -> std::future<std::invoke_result_t<Fn>> {
+    using result_t = std::invoke_result_t<Fn>;
+    auto task = std::make_shared<std::packaged_task<result_t()>>(std::move(fn));
+    std::future<result_t> result = task->get_future();
+    enqueue([task] { (*task)(); });
+    return result;
+  }
+
+  /**
+   * @brief Call fn(i) for every i in [0, count), in parallel and in no particular order
+   *
+   * Indices are handed out one by one, so uneven work balances itself. Returns
+   * once every call has finished; the first exception thrown by fn stops the
+   * hand-out of further indices and is rethrown here.
+   */
+  template <typename Fn>
+  void parallel_for(std::size_t count, Fn&& fn) {
+    if (count == 0) return;
+    if (count == 1 || m_workers.empty()) {
+      for (std::size_t i = 0; i < count; ++i) fn(i);
+      return;
+    }
+
+    // Helpers that start after the range is exhausted return at once; the
+    // shared state keeps them valid even after this call has returned.
+    struct State {
+      std::atomic<std::size_t> next{0};
+      std::size_t count = 0;
+      std::mutex mutex;
+      std::condition_variable done;
+      std::size_t active = 0;
+      std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+
+    auto run = [state, &fn] {
+      for (std::size_t i = state->next++; i < state->count; i = state->next++) {
+        try {
+          fn(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (!state->error) state->error = std::current_exception();
+          state->next = state->count;
+        }
+      }
+    };
+
+    const std::size_t helpers = std::min(m_workers.size(), count - 1);
+    for (std::size_t h = 0; h < helpers; ++h) {
+      enqueue([state, run] {
+        {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (state->next >= state->count) return;
+          ++state->active;
+        }
+        run();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (--state->active == 0) state->done.notify_all();
+      });
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->active == 0; });
+    if (state->error) std::rethrow_exception(state->error);
+  }
+
+  /**
+   * @brief Reduce [0, count) in chunks of 'grain' indices
+   *
+   * map(begin, end) turns each chunk into a partial result, in parallel;
+   * combine(acc, partial) then folds the partials into init on the calling
+   * thread, in chunk order. The fixed order keeps the result independent of
+   * the number of workers, even for floating point sums.
+   */
+  template <typename R, typename Map, typename Combine>
+  R parallel_reduce(std::size_t count, std::size_t grain, R init, Map&& map, Combine&& combine) {
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    std::vector<R> partials(chunks, init);
+    parallel_for(chunks, [&](std::size_t c) {
+      const std::size_t begin = c * grain;
+      partials[c] = map(begin, std::min(count, begin + grain));
+    });
+    for (R& partial : partials) init = combine(std::move(init), std::move(partial));
+    return init;
+  }
+
+  // Process-wide pool with one worker per hardware thread, created on first use
+  static ThreadPool& shared() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+private:
+  void enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+  }
+
+  void work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+        if (m_tasks.empty()) return;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_stopping = false;
+};
@@ -0,0 +1,295 @@
+// uniform_grid.hpp
+#pragma once
+
+#include "neighbor.hpp"
+#include "point.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hash grid of square cells over Point<T>, updatable point by point
+ *
+ * Points are bucketed by the cell that contains them; insert, erase and
+ * update are O(1). Radius queries visit the cells overlapping the query
+ * circle, nearest-neighbour queries search rings of cells around the query
+ * until no closer point can follow. Works best with a cell size near the
+ * typical query radius or point spacing. Queries are const and may run
+ * concurrently, but not concurrently with modifications.
+ *
+ * @tparam T Arithmetic type of the point coordinates
+ */
+template <typename T>
+class UniformGrid {
+public:
+  using size_type = std::size_t;
+
+  // cell_size must be positive and finite
+  explicit UniformGrid(double cell_size) : m_cell_size(cell_size) {
+    spatial_detail::check_coordinate_type<T>();
+    if (!(cell_size > 0) || !std::isfinite(cell_size)) {
+      throw std::invalid_argument("UniformGrid: cell size must be positive");
+    }
+  }
+
+  // Bulk insert; point i gets the id i
+  UniformGrid(double cell_size, const std::vector<Point<T>>& points) : UniformGrid(cell_size) {
+    m_slots.reserve(points.size());
+    for (const Point<T>& p : points) {
+      insert(p);
+    }
+  }
+
+  double cell_size() const noexcept { return m_cell_size; }
+
+  // Number of stored points
+  size_type size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+
+  // Adds a point and returns its id; ids of erased points are reused
+  size_type insert(const Point<T>& p) {
+    size_type id;
+    if (!m_free.empty()) {
+      id = m_free.back();
+      m_free.pop_back();
+    } else {
+      id = m_slots.size();
+      m_slots.emplace_back();
+    }
+    place(id, p);
+    ++m_size;
+    return id;
+  }
+
+  // Removes a point; throws std::out_of_range for an unknown id
+  void erase(size_type id) {
+    check(id);
+    unlink(id);
+    m_slots[id].alive = false;
+    m_free.push_back(id);
+    --m_size;
+  }
+
+  // Moves a point to a new position, keeping its id
+  void update(size_type id, const Point<T>& p) {
+    check(id);
+    Slot& slot = m_slots[id];
+    if (cell_of(static_cast<double>(p.x), static_cast<double>(p.y)) == slot.cell) {
+      slot.point = p;
+      slot.x = static_cast<double>(p.x);
+      slot.y = static_cast<double>(p.y);
+      return;
+    }
+    unlink(id);
+    place(id, p);
+  }
+
+  bool contains(size_type id) const noexcept { return id < m_slots.size() && m_slots[id].alive; }
+
+  // Position of a point; throws std::out_of_range for an unknown id
+  Point<T> point(size_type id) const {
+    check(id);
+    return m_slots[id].point;
+  }
+
+  // Closest point; index == npos and an infinite distance for an empty grid
+  Neighbor nearest(const Point<T>& q) const {
+    const std::vector<Neighbor> best = k_nearest(q, 1);
+    return best.empty() ? Neighbor{npos, std::numeric_limits<double>::infinity()} : best.front();
+  }
+
+  // The k closest points, ascending by distance (ties by id)
+  std::vector<Neighbor> k_nearest(const Point<T>& q, size_type k) const {
+    const double qx = static_cast<double>(q.x);
+    const double qy = static_cast<double>(q.y);
+    k = std::min(k, m_size);
+    spatial_detail::KBest best(k);
+    if (k == 0) return {};
+
+    // Unvisited points lie outside the block of rings 0..r, at least r cells away
+    const Cell center = cell_of(qx, qy);
+    for (std::int64_t r = 0;; ++r) {
+      if (static_cast<size_type>(8 * r) > m_cells.size()) {
+        best = spatial_detail::KBest(k);  // rings got larger than the grid: one pass over everything
+        for (const auto& entry : m_cells) {
+          offer_cell(entry.second, qx, qy, best);
+        }
+        break;
+      }
+      visit_ring(center, r, qx, qy, best);
+      const double reach = static_cast<double>(r) * m_cell_size * (1 - 1e-12);
+      if ((best.full() && best.bound() <= reach * reach) || covers_bounds(center, r)) break;
+    }
+    return finish(best.take_sorted(), qx, qy);
+  }
+
+  // All points with distance <= radius, ascending by distance (ties by id)
+  std::vector<Neighbor> within_radius(const Point<T>& q, double radius) const {
+    if (!(radius >= 0) || m_size == 0) return {};
+    const double qx = static_cast<double>(q.x);
+    const double qy = static_cast<double>(q.y);
+    spatial_detail::RadiusCollector found{radius * radius, {}};
+
+    const Cell low = cell_of(qx - radius, qy - radius);
+    const Cell high = cell_of(qx + radius, qy + radius);
+    const double span = (static_cast<double>(high.x - low.x) + 1) * (static_cast<double>(high.y - low.y) + 1);
+    if (span > static_cast<double>(m_cells.size())) {
+      for (const auto& entry : m_cells) {
+        offer_cell(entry.second, qx, qy, found);
+      }
+    } else {
+      for (std::int64_t cx = low.x; cx <= high.x; ++cx) {
+        for (std::int64_t cy = low.y; cy <= high.y; ++cy) {
+          const auto it = m_cells.find(Cell{cx, cy});
+          if (it != m_cells.end()) offer_cell(it->second, qx, qy, found);
+        }
+      }
+    }
+    std::sort(found.found.begin(), found.found.end());
+    return finish(std::move(found.found), qx, qy);
+  }
+
+  // Batch versions: one result per query, computed in parallel
+  std::vector<Neighbor> nearest(const std::vector<Point<T>>& queries, ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<Neighbor>(queries.size(), pool, [&](size_type i) { return nearest(queries[i]); });
+  }
+
+  std::vector<std::vector<Neighbor>> k_nearest(const std::vector<Point<T>>& queries, size_type k,
+                                               ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<std::vector<Neighbor>>(queries.size(), pool,
+                                                        [&](size_type i) { return k_nearest(queries[i], k); });
+  }
+
+  std::vector<std::vector<Neighbor>> within_radius(const std::vector<Point<T>>& queries, double radius,
+                                                   ThreadPool* pool = nullptr) const {
+    return spatial_detail::batch<std::vector<Neighbor>>(
+      queries.size(), pool, [&](size_type i) { return within_radius(queries[i], radius); });
+  }
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+  struct Cell {
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+
+    bool operator==(const Cell& rhs) const noexcept { return x == rhs.x && y == rhs.y; }
+  };
+
+  struct CellHash {
+    std::size_t operator()(const Cell& c) const noexcept {
+      const auto h = static_cast<std::uint64_t>(c.x) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(c.y);
+      return static_cast<std::size_t>(h ^ (h >> 29));
+    }
+  };
+
+  struct Slot {
+    Point<T> point{};
+    double x = 0;
+    double y = 0;
+    Cell cell;
+    size_type pos = 0;  // position in the id list of the cell
+    bool alive = false;
+  };
+
+  // Cell coordinates are clamped, so far-away points share the border cells
+  Cell cell_of(double x, double y) const noexcept {
+    auto coord = [this](double v) {
+      constexpr double limit = 4e18;
+      const double c = std::floor(v / m_cell_size);
+      return static_cast<std::int64_t>(c < -limit ? -limit : (c > limit ? limit : c));
+    };
+    return Cell{coord(x), coord(y)};
+  }
+
+  void check(size_type id) const {
+    if (!contains(id)) throw std::out_of_range("UniformGrid: unknown id");
+  }
+
+  void place(size_type id, const Point<T>& p) {
+    Slot& slot = m_slots[id];
+    slot.point = p;
+    slot.x = static_cast<double>(p.x);
+    slot.y = static_cast<double>(p.y);
+    slot.cell = cell_of(slot.x, slot.y);
+    slot.alive = true;
+    std::vector<size_type>& ids = m_cells[slot.cell];
+    slot.pos = ids.size();
+    ids.push_back(id);
+
+    if (m_size == 0 && m_cells.size() == 1) {
+      m_low = m_high = slot.cell;
+    } else {
+      m_low = Cell{std::min(m_low.x, slot.cell.x), std::min(m_low.y, slot.cell.y)};
+      m_high = Cell{std::max(m_high.x, slot.cell.x), std::max(m_high.y, slot.cell.y)};
+    }
+  }
+
+  // Swap-and-pop removal from the id list of the cell
+  void unlink(size_type id) {
+    const Slot& slot = m_slots[id];
+    const auto it = m_cells.find(slot.cell);
+    std::vector<size_type>& ids = it->second;
+    ids[slot.pos] = ids.back();
+    m_slots[ids[slot.pos]].pos = slot.pos;
+    ids.pop_back();
+    if (ids.empty()) m_cells.erase(it);
+  }
+
+  template <typename Collector>
+  void offer_cell(const std::vector<size_type>& ids, double qx, double qy, Collector& out) const {
+    for (size_type id : ids) {
+      const double dx = m_slots[id].x - qx;
+      const double dy = m_slots[id].y - qy;
+      out.offer(dx * dx + dy * dy, id);
+    }
+  }
+
+  // Cells at Chebyshev distance exactly r from center
+  void visit_ring(const Cell& center, std::int64_t r, double qx, double qy, spatial_detail::KBest& best) const {
+    auto visit = [&](std::int64_t cx, std::int64_t cy) {
+      const auto it = m_cells.find(Cell{cx, cy});
+      if (it != m_cells.end()) offer_cell(it->second, qx, qy, best);
+    };
+    if (r == 0) {
+      visit(center.x, center.y);
+      return;
+    }
+    for (std::int64_t d = -r; d <= r; ++d) {
+      visit(center.x + d, center.y - r);
+      visit(center.x + d, center.y + r);
+    }
+    for (std::int64_t d = -r + 1; d < r; ++d) {
+      visit(center.x - r, center.y + d);
+      visit(center.x + r, center.y + d);
+    }
+  }
+
+  // True if rings 0..r contain every cell that ever held a point
+  bool covers_bounds(const Cell& center, std::int64_t r) const noexcept {
+    return center.x - r <= m_low.x && center.x + r >= m_high.x && center.y - r <= m_low.y &&
+           center.y + r >= m_high.y;
+  }
+
+  std::vector<Neighbor> finish(std::vector<spatial_detail::Candidate> candidates, double qx, double qy) const {
+    return spatial_detail::to_neighbors(std::move(candidates), qx, qy, [this](size_type id) {
+      return std::make_pair(m_slots[id].x, m_slots[id].y);
+    });
+  }
+
+  double m_cell_size;
+  std::vector<Slot> m_slots;  // indexed by id
+  std::vector<size_type> m_free;
+  std::unordered_map<Cell, std::vector<size_type>, CellHash> m_cells;
+  size_type m_size = 0;
+  Cell m_low;   // bounding box of all cells that ever held a point
+  Cell m_high;
+};
@@ -0,0 +1,160 @@
+// json_writer.cpp
+#include "json_writer.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+// detail::to_chars is not public API; tests/010 compares it against dump() for every build
+static_assert(NLOHMANN_JSON_VERSION_MAJOR == 3, "append_double needs nlohmann::detail::to_chars of nlohmann_json 3.x");
+
+namespace json_detail {
+namespace {
+
+// Length of the well-formed UTF-8 sequence at c, 0 if it is malformed. Like the decoder of
+// dump(), overlong forms, surrogates and code points above U+10FFFF count as malformed.
+std::size_t utf8_length(const char* c, const char* end) noexcept {
+  const auto lead = static_cast<unsigned char>(c[0]);
+  std::size_t length = 0;
+  unsigned char low = 0x80, high = 0xBF;  // range of the second byte
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    if (lead == 0xE0) low = 0xA0;
+    if (lead == 0xED) high = 0x9F;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    if (lead == 0xF0) low = 0x90;
+    if (lead == 0xF4) high = 0x8F;
+  } else {
+    return 0;
+  }
+  if (static_cast<std::size_t>(end - c) < length) return 0;
+  const auto second = static_cast<unsigned char>(c[1]);
+  if (second < low || second > high) return 0;
+  for (std::size_t i = 2; i < length; ++i) {
+    if ((static_cast<unsigned char>(c[i]) & 0xC0) != 0x80) return 0;
+  }
+  return length;
+}
+
+}  // namespace
+
+void append_double(fmt::memory_buffer& out, double v) {
+  if (!std::isfinite(v)) {
+    out.append(std::string_view("null"));
+    return;
+  }
+  // nlohmann's own Grisu2 conversion, which dump() uses as well: fmt's shortest
+  // representation picks different digits for about 0.07% of all doubles
+  char text[64];
+  const char* end = nlohmann::detail::to_chars(text, text + sizeof(text), v);
+  out.append(text, end);
+}
+
+void append_string(fmt::memory_buffer& out, std::string_view s) {
+  out.push_back('"');
+  const char* run = s.data();
+  const char* const end = s.data() + s.size();
+  for (const char* c = run; c != end; ++c) {
+    const auto byte = static_cast<unsigned char>(*c);
+    if (byte >= 0x80) {
+      const std::size_t length = utf8_length(c, end);
+      if (length == 0) {
+        throw std::invalid_argument(
+            fmt::format("JsonWriter: invalid UTF-8 byte at index {}: 0x{:02X}", c - s.data(), byte));
+      }
+      c += length - 1;
+      continue;
+    }
+    if (byte >= 0x20 && byte != '"' && byte != '\\') continue;
+    out.append(run, c);
+    run = c + 1;
+    switch (byte) {
+      case '"': out.append(std::string_view("\\\"")); break;
+      case '\\': out.append(std::string_view("\\\\")); break;
+      case '\b': out.append(std::string_view("\\b")); break;
+      case '\f': out.append(std::string_view("\\f")); break;
+      case '\n': out.append(std::string_view("\\n")); break;
+      case '\r': out.append(std::string_view("\\r")); break;
+      case '\t': out.append(std::string_view("\\t")); break;
+      default: fmt::format_to(std::back_inserter(out), "\\u{:04x}", byte); break;
+    }
+  }
+  out.append(run, end);
+  out.push_back('"');
+}
+
+}  // namespace json_detail
+
+void JsonWriter::newline() {
+  m_out.push_back('\n');
+  for (std::size_t i = 0, n = m_depth * static_cast<std::size_t>(m_indent); i < n; ++i) {
+    m_out.push_back(' ');
+  }
+}
+
+void JsonWriter::separate() {
+  if (m_after_key) {
+    m_after_key = false;
+    return;
+  }
+  if (m_depth == 0) return;
+  const std::uint64_t bit = std::uint64_t{1} << (m_depth - 1);
+  if (m_filled & bit) m_out.push_back(',');
+  m_filled |= bit;
+  if (m_indent >= 0) newline();
+}
+
+JsonWriter& JsonWriter::open(char bracket) {
+  if (m_depth == max_depth) throw std::length_error("JsonWriter: nesting too deep");
+  separate();
+  m_out.push_back(bracket);
+  ++m_depth;
+  m_filled &= ~(std::uint64_t{1} << (m_depth - 1));
+  return *this;
+}
+
+JsonWriter& JsonWriter::close(char bracket) {
+  if (m_depth == 0) throw std::logic_error("JsonWriter: no open object or array");
+  const bool filled = (m_filled >> (m_depth - 1)) & 1;
+  --m_depth;
+  if (filled && m_indent >= 0) newline();
+  m_out.push_back(bracket);
+  return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+  separate();
+  json_detail::append_string(m_out, name);
+  m_out.append(std::string_view(m_indent >= 0 ? ": " : ":"));
+  m_after_key = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(double v) {
+  separate();
+  json_detail::append_double(m_out, v);
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(bool v) {
+  separate();
+  m_out.append(std::string_view(v ? "true" : "false"));
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view v) {
+  separate();
+  json_detail::append_string(m_out, v);
+  return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+  separate();
+  m_out.append(std::string_view("null"));
+  return *this;
+}
@@ -1,19 +1,81 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
-#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
 
 #include "CLI/CLI.hpp"
 #include "config.h"
+#include "json_writer.hpp"
+#include "kmeans.hpp"
+#include "particle_simulation.hpp"
 #include "point.hpp"
+#include "point_dataset.hpp"
 #include "point_fmt.hpp"
+#include "point_stream.hpp"
+
+namespace {
+
+// Renders one JSON document into the reused buffer: dump(2) layout, or one compact line for ndjson
+template <typename Emit>
+std::string_view render_json(fmt::memory_buffer& buffer, bool pretty, Emit&& emit)
+{
+    buffer.clear();
+    JsonWriter json(buffer, pretty ? 2 : -1);
+    emit(json);
+    return {buffer.data(), buffer.size()};
+}
 
-// for convenience
-using json = nlohmann::json;
+// x and y of every point of a dataset, whatever its element type, layout and dimension
+template <typename T>
+PointCloud<double> load_xy(const point_dataset::Dataset& data)
+{
+    PointCloud<double> cloud(data.size());
+    if (data.layout() == point_dataset::Layout::Columns) {
+        const auto xs = data.column<T>(0);
+        const auto ys = data.column<T>(1);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            cloud.set(i, {static_cast<double>(xs[i]), static_cast<double>(ys[i])});
+        }
+        return cloud;
+    }
+    const auto coords = data.coordinates<T>();
+    const std::size_t dimension = data.dimension();
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        cloud.set(i, {static_cast<double>(coords[i * dimension]), static_cast<double>(coords[i * dimension + 1])});
+    }
+    return cloud;
+}
+
+PointCloud<double> load_xy(const std::string& path)
+{
+    const point_dataset::Dataset data(path);
+    switch (data.element_type()) {
+        case point_dataset::ElementType::Int32: return load_xy<std::int32_t>(data);
+        case point_dataset::ElementType::Int64: return load_xy<std::int64_t>(data);
+        case point_dataset::ElementType::Float32: return load_xy<float>(data);
+        default: return load_xy<double>(data);
+    }
+}
+
+}  // namespace
 
 auto main(int argc, char **argv) -> int
 {
     CLI::App app{PROJECT_NAME};
     
+    // Output mode: the text report, or only its JSON document (pretty or as one NDJSON line)
+    std::string output = "text";
+    app.add_option("--output", output, "text, json or ndjson")
+        ->check(CLI::IsMember({"text", "json", "ndjson"}))->default_val("text");
+
     // Subcommand for distance calculation
     auto* dist_cmd = app.add_subcommand("distance", "Calculate distance between two points");
     int x1 = 0, y1 = 0, x2 = 3, y2 = 4;
@@ -40,6 +102,64 @@ auto main(int argc, char **argv) -> int
     arith_cmd->add_option("--by", by, "Y coordinate of point B")->default_val(7);
     arith_cmd->add_option("-s,--scalar", scalar, "Scalar for multiplication")->default_val(2.5);
     
+    // Subcommand for batch processing: many records per process instead of one pair
+    auto* batch_cmd = app.add_subcommand("batch", "Run distance, move or arithmetic on every record of a file or stdin");
+    std::string batch_op = "distance", batch_in = "-", batch_out = "-", in_format = "csv", out_format;
+    double batch_scalar = 2.5;
+    batch_cmd->add_option("operation", batch_op, "distance, move or arithmetic")
+        ->check(CLI::IsMember({"distance", "move", "arithmetic"}));
+    batch_cmd->add_option("-i,--input", batch_in, "Input file, - for stdin")->default_val("-");
+    batch_cmd->add_option("-o,--output", batch_out, "Output file, - for stdout")->default_val("-");
+    batch_cmd->add_option("-f,--format", in_format, "Input format: csv, ndjson or binary")
+        ->check(CLI::IsMember({"csv", "ndjson", "binary"}))->default_val("csv");
+    batch_cmd->add_option("--output-format", out_format, "Output format (default: input format)")
+        ->check(CLI::IsMember({"csv", "ndjson", "binary"}));
+    batch_cmd->add_option("-s,--scalar", batch_scalar, "Scalar for arithmetic")->default_val(2.5);
+
+    // Subcommand for converting JSON output into a memory-mappable point dataset
+    auto* convert_cmd = app.add_subcommand("convert", "Convert the JSON or NDJSON output of this tool into a binary point dataset");
+    std::string convert_in = "-", convert_out, convert_type = "float64", convert_layout = "interleaved";
+    std::size_t convert_dimension = 2, convert_alignment = 64;
+    convert_cmd->add_option("-i,--input", convert_in, "JSON input file, - for stdin")->default_val("-");
+    convert_cmd->add_option("-o,--output", convert_out, "Dataset file")->required();
+    convert_cmd->add_option("-t,--type", convert_type, "Coordinate type: int32, int64, float32 or float64")
+        ->check(CLI::IsMember({"int32", "int64", "float32", "float64"}))->default_val("float64");
+    convert_cmd->add_option("--layout", convert_layout, "interleaved (Point<T> array) or columns (like PointCloud<T>)")
+        ->check(CLI::IsMember({"interleaved", "columns"}))->default_val("interleaved");
+    convert_cmd->add_option("-d,--dimension", convert_dimension, "2, 3 (x, y, z) or 4 (x, y, z, w)")
+        ->check(CLI::Range(2, 4))->default_val(2);
+    convert_cmd->add_option("--alignment", convert_alignment, "Alignment of the coordinates in bytes")->default_val(64);
+
+    // Subcommand for the particle simulation: the stability test for many points, in parallel
+    auto* sim_cmd = app.add_subcommand("simulate", "Move random points by random velocities for many steps");
+    std::size_t sim_points = 1000000, sim_steps = 1000, sim_threads = 0, sim_every = 0;
+    std::string sim_boundary = "wrap", sim_dir;
+    double sim_size = 1000.0;
+    unsigned sim_seed = 42;
+    sim_cmd->add_option("-n,--points", sim_points, "Number of points")->default_val(1000000);
+    sim_cmd->add_option("--steps", sim_steps, "Number of steps")->default_val(1000);
+    sim_cmd->add_option("-t,--threads", sim_threads, "Worker threads, 0 = one per hardware thread")->default_val(0);
+    sim_cmd->add_option("-b,--boundary", sim_boundary, "none, wrap or clamp at the box [0, size)")
+        ->check(CLI::IsMember({"none", "wrap", "clamp"}))->default_val("wrap");
+    sim_cmd->add_option("--size", sim_size, "Edge length of the box")->default_val(1000.0);
+    sim_cmd->add_option("--snapshot-every", sim_every, "Write the positions every N steps, 0 = never")->default_val(0);
+    sim_cmd->add_option("--snapshot-dir", sim_dir, "Directory for the snapshot datasets step-NNNNNNNN.pts (default: .)");
+    sim_cmd->add_option("--seed", sim_seed, "Seed of the random points")->default_val(42);
+
+    // Subcommand for k-means clustering of a dataset or of random blobs
+    auto* kmeans_cmd = app.add_subcommand("kmeans", "Cluster the points of a dataset (or random blobs) with k-means");
+    std::string kmeans_in;
+    std::size_t kmeans_points = 1000000, kmeans_threads = 0;
+    KMeansOptions kmeans_options;
+    kmeans_cmd->add_option("-i,--input", kmeans_in, "Point dataset written by convert or simulate (default: random blobs)");
+    kmeans_cmd->add_option("-n,--points", kmeans_points, "Number of random points without --input")->default_val(1000000);
+    kmeans_cmd->add_option("-k,--clusters", kmeans_options.k, "Number of clusters")->default_val(8);
+    kmeans_cmd->add_option("--iterations", kmeans_options.max_iterations, "Maximum number of iterations")->default_val(100);
+    kmeans_cmd->add_option("--tolerance", kmeans_options.tolerance, "Converged once no center moves farther")->default_val(1e-4);
+    kmeans_cmd->add_option("--batch-size", kmeans_options.batch_size, "Points per mini-batch, 0 = full Lloyd iterations")->default_val(0);
+    kmeans_cmd->add_option("-t,--threads", kmeans_threads, "Worker threads, 0 = one per hardware thread")->default_val(0);
+    kmeans_cmd->add_option("--seed", kmeans_options.seed, "Seed of the random points, the seeding and the batches")->default_val(42);
+
     // Subcommand for full demo
     auto* demo_cmd = app.add_subcommand("demo", "Run full demonstration of all Point<T> features");
     
@@ -54,83 +174,288 @@ auto main(int argc, char **argv) -> int
         return app.exit(e);
     }
 
-    fmt::print("Hello, {}!\n", app.get_name());
-    fmt::print("=================================\n");
+    // Handle batch subcommand; stdout may carry the records, so no banner
+    if (batch_cmd->parsed()) {
+        try {
+            point_stream::Options options;
+            options.operation = point_stream::parse_operation(batch_op);
+            options.input_format = point_stream::parse_format(in_format);
+            options.output_format = point_stream::parse_format(out_format.empty() ? in_format : out_format);
+            options.scalar = batch_scalar;
+
+            auto open = [](const std::string& path, const char* mode, std::FILE* standard) {
+                std::FILE* file = path == "-" ? standard : std::fopen(path.c_str(), mode);
+                if (!file) throw std::runtime_error(fmt::format("cannot open {}", path));
+                return std::unique_ptr<std::FILE, int (*)(std::FILE*)>(
+                    file, path == "-" ? [](std::FILE*) { return 0; } : &std::fclose);
+            };
+            const auto in = open(batch_in, "rb", stdin);
+            const auto out = open(batch_out, "wb", stdout);
+
+            const auto stats = point_stream::process(in.get(), out.get(), options);
+            fmt::print(stderr, "{} records in {:.3f} s ({:.0f} records/s)\n", stats.records, stats.seconds,
+                       stats.records_per_second());
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "batch: {}\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    // Handle convert subcommand; like batch, only a summary on stderr
+    if (convert_cmd->parsed()) {
+        try {
+            point_dataset::ConvertOptions options;
+            options.type = point_dataset::parse_element_type(convert_type);
+            options.layout = point_dataset::parse_layout(convert_layout);
+            options.dimension = convert_dimension;
+            options.alignment = convert_alignment;
+
+            const auto start = std::chrono::steady_clock::now();
+            std::ifstream file;
+            if (convert_in != "-") {
+                file.open(convert_in, std::ios::binary);
+                if (!file) throw std::runtime_error(fmt::format("cannot open {}", convert_in));
+            }
+            const std::size_t count =
+                point_dataset::convert_json(convert_in == "-" ? std::cin : file, convert_out, options);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            fmt::print(stderr, "{} points ({} x {}, {}) written to {} in {:.3f} s\n", count, convert_type,
+                       convert_dimension, convert_layout, convert_out, seconds);
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "convert: {}\n", e.what());
+            return 1;
+        }
+        return 0;
+    }
+
+    const bool text = output == "text";
+    fmt::memory_buffer json_buffer;
+    auto print_json = [&](const char* label, auto&& emit) {
+        const std::string_view doc = render_json(json_buffer, output != "ndjson", emit);
+        if (text) {
+            fmt::print("{}JSON output:\n{}\n", label, doc);
+        } else {
+            fmt::print("{}\n", doc);
+        }
+    };
+
+    if (text) {
+        fmt::print("Hello, {}!\n", app.get_name());
+        fmt::print("=================================\n");
+    }
     
     // Handle distance subcommand
     if (dist_cmd->parsed()) {
-        fmt::print("Distance Calculation\n");
-        fmt::print("=================================\n\n");
-        
         Point<int> p1{x1, y1};
         Point<int> p2{x2, y2};
-        
-        fmt::print("Point 1: {}\n", p1);
-        fmt::print("Point 2: {}\n", p2);
-        fmt::print("Distance: {:.6f}\n\n", p1.distance_to(p2));
-        
-        json j;
-        j["point1"] = {{"x", p1.x}, {"y", p1.y}};
-        j["point2"] = {{"x", p2.x}, {"y", p2.y}};
-        j["distance"] = p1.distance_to(p2);
-        fmt::print("JSON output:\n{}\n", j.dump(2));
+        const auto distance = p1.distance_to(p2);
+
+        if (text) {
+            fmt::print("Distance Calculation\n");
+            fmt::print("=================================\n\n");
+            fmt::print("Point 1: {}\n", p1);
+            fmt::print("Point 2: {}\n", p2);
+            fmt::print("Distance: {:.6f}\n\n", distance);
+        }
+
+        // Keys in ascending order, as nlohmann::json sorts them
+        print_json("", [&](JsonWriter& json) {
+            json.begin_object().field("distance", distance).field("point1", p1).field("point2", p2).end_object();
+        });
         
         return 0;
     }
     
     // Handle move subcommand
     if (move_cmd->parsed()) {
-        fmt::print("Move Operation\n");
-        fmt::print("=================================\n\n");
-        
-        Point<int> p{px, py};
-        fmt::print("Initial point: {}\n", p);
-        fmt::print("Moving by: ({}, {})\n", dx, dy);
-        
+        const Point<int> initial{px, py};
+        Point<int> p = initial;
         p.move(dx, dy);
-        fmt::print("Result: {}\n\n", p);
-        
-        json j;
-        j["initial"] = {{"x", px}, {"y", py}};
-        j["delta"] = {{"dx", dx}, {"dy", dy}};
-        j["result"] = {{"x", p.x}, {"y", p.y}};
-        fmt::print("JSON output:\n{}\n", j.dump(2));
+
+        if (text) {
+            fmt::print("Move Operation\n");
+            fmt::print("=================================\n\n");
+            fmt::print("Initial point: {}\n", initial);
+            fmt::print("Moving by: ({}, {})\n", dx, dy);
+            fmt::print("Result: {}\n\n", p);
+        }
+
+        print_json("", [&](JsonWriter& json) {
+            json.begin_object();
+            json.key("delta").begin_object().field("dx", dx).field("dy", dy).end_object();
+            json.field("initial", initial).field("result", p);
+            json.end_object();
+        });
         
         return 0;
     }
     
     // Handle arithmetic subcommand
     if (arith_cmd->parsed()) {
-        fmt::print("Arithmetic Operations\n");
-        fmt::print("=================================\n\n");
-        
         Point<int> pa{ax, ay};
         Point<int> pb{bx, by};
-        
-        fmt::print("Point A: {}\n", pa);
-        fmt::print("Point B: {}\n", pb);
-        fmt::print("\nOperations:\n");
-        fmt::print("  A + B = {}\n", pa + pb);
-        fmt::print("  A - B = {}\n", pa - pb);
-        
-        auto scaled = pa * scalar;
-        fmt::print("  A * {:.2f} = {}\n\n", scalar, scaled);
-        
-        json j;
-        j["pointA"] = {{"x", pa.x}, {"y", pa.y}};
-        j["pointB"] = {{"x", pb.x}, {"y", pb.y}};
-        j["addition"] = {{"x", (pa + pb).x}, {"y", (pa + pb).y}};
-        j["subtraction"] = {{"x", (pa - pb).x}, {"y", (pa - pb).y}};
-        j["scalar_multiplication"] = {
-            {"scalar", scalar},
-            {"result", {{"x", scaled.x}, {"y", scaled.y}}}
-        };
-        fmt::print("JSON output:\n{}\n", j.dump(2));
+        const auto sum = pa + pb;
+        const auto difference = pa - pb;
+        const auto scaled = pa * scalar;
+
+        if (text) {
+            fmt::print("Arithmetic Operations\n");
+            fmt::print("=================================\n\n");
+            fmt::print("Point A: {}\n", pa);
+            fmt::print("Point B: {}\n", pb);
+            fmt::print("\nOperations:\n");
+            fmt::print("  A + B = {}\n", sum);
+            fmt::print("  A - B = {}\n", difference);
+            fmt::print("  A * {:.2f} = {}\n\n", scalar, scaled);
+        }
+
+        print_json("", [&](JsonWriter& json) {
+            json.begin_object().field("addition", sum).field("pointA", pa).field("pointB", pb);
+            json.key("scalar_multiplication").begin_object().field("result", scaled).field("scalar", scalar).end_object();
+            json.field("subtraction", difference).end_object();
+        });
         
         return 0;
     }
     
+    // Handle simulate subcommand
+    if (sim_cmd->parsed()) {
+        PointCloud<double> positions(sim_points);
+        PointCloud<double> velocities(sim_points);
+        std::mt19937 gen(sim_seed);
+        std::uniform_real_distribution<double> coordinate(0.0, sim_size);
+        std::uniform_real_distribution<double> speed(-1.0, 1.0);
+        for (std::size_t i = 0; i < sim_points; ++i) {
+            positions.set(i, {coordinate(gen), coordinate(gen)});
+            velocities.set(i, {speed(gen), speed(gen)});
+        }
+
+        SimulationOptions<double> options;
+        options.boundary = sim_boundary == "wrap"    ? Boundary::Wrap
+                           : sim_boundary == "clamp" ? Boundary::Clamp
+                                                     : Boundary::None;
+        options.max = {sim_size, sim_size};
+        ThreadPool pool(sim_threads);
+        options.pool = &pool;
+
+        std::size_t snapshots = 0;
+        SimulationStats stats;
+        try {
+            ParticleSimulation<double> sim(std::move(positions), std::move(velocities), options);
+            auto write_snapshot = [&](std::size_t step, const PointCloud<double>& points) {
+                point_dataset::write(fmt::format("{}/step-{:08}.pts", sim_dir.empty() ? "." : sim_dir, step), points);
+                ++snapshots;
+            };
+            stats = sim.run(sim_steps, write_snapshot, sim_every);
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "simulate: {}\n", e.what());
+            return 1;
+        }
+
+        if (text) {
+            fmt::print("Particle Simulation\n");
+            fmt::print("=================================\n\n");
+            fmt::print("Points: {}, steps: {}, boundary: {}\n", stats.points, stats.steps, sim_boundary);
+            fmt::print("Threads: {} workers + caller, kernels: {}\n", stats.threads,
+                       cloud_simd::isa_name(cloud_simd::active_isa()));
+            fmt::print("Time: {:.3f} s ({} snapshots in {:.3f} s)\n", stats.seconds, snapshots, stats.snapshot_seconds);
+            fmt::print("Steps/s: {:.1f}\n", stats.steps_per_second());
+            fmt::print("Points/s: {:.3e}\n\n", stats.points_per_second());
+        }
+
+        print_json("", [&](JsonWriter& json) {
+            json.begin_object().field("boundary", sim_boundary).field("points", stats.points);
+            json.field("points_per_second", stats.points_per_second()).field("seconds", stats.seconds);
+            json.field("snapshots", snapshots).field("steps", stats.steps);
+            json.field("steps_per_second", stats.steps_per_second()).field("threads", stats.threads).end_object();
+        });
+
+        return 0;
+    }
+
+    // Handle kmeans subcommand
+    if (kmeans_cmd->parsed()) {
+        ThreadPool pool(kmeans_threads);
+        kmeans_options.pool = &pool;
+        KMeansResult result;
+        std::size_t count = 0;
+        try {
+            PointCloud<double> points;
+            if (!kmeans_in.empty()) {
+                points = load_xy(kmeans_in);
+            } else {
+                // One Gaussian blob per cluster in a 1000 x 1000 box
+                std::mt19937_64 gen(kmeans_options.seed);
+                std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+                std::normal_distribution<double> noise(0.0, 25.0);
+                std::vector<Point<double>> centers(kmeans_options.k);
+                for (auto& c : centers) c = {coordinate(gen), coordinate(gen)};
+                points = PointCloud<double>(kmeans_points);
+                for (std::size_t i = 0; i < kmeans_points; ++i) {
+                    const auto& c = centers[i % centers.size()];
+                    points.set(i, {c.x + noise(gen), c.y + noise(gen)});
+                }
+            }
+            count = points.size();
+            result = kmeans(points, kmeans_options);
+        } catch (const std::exception& e) {
+            fmt::print(stderr, "kmeans: {}\n", e.what());
+            return 1;
+        }
+        const char* mode = kmeans_options.batch_size > 0 ? "mini-batch" : "lloyd";
+
+        if (text) {
+            fmt::print("K-Means Clustering\n");
+            fmt::print("=================================\n\n");
+            fmt::print("Points: {} ({}), k: {}, mode: {}\n", count, kmeans_in.empty() ? "random blobs" : kmeans_in,
+                       kmeans_options.k, mode);
+            fmt::print("Threads: {} workers + caller, kernels: {}\n", pool.size(),
+                       cloud_simd::isa_name(cloud_simd::active_isa()));
+            fmt::print("Iterations: {} ({})\n", result.iterations, result.converged ? "converged" : "not converged");
+            fmt::print("Time: {:.3f} s (seeding {:.3f} s, {:.3f} ms per iteration)\n", result.seconds,
+                       result.init_seconds,
+                       result.iterations > 0 ? (result.seconds - result.init_seconds) / result.iterations * 1e3 : 0.0);
+            fmt::print("Inertia: {:.6e}\n\nCenters:\n", result.inertia);
+            for (std::size_t j = 0; j < result.centers.size(); ++j) {
+                fmt::print("  {:>3}: {} ({} points)\n", j, result.centers[j], result.sizes[j]);
+            }
+            fmt::print("\n");
+        }
+
+        print_json("", [&](JsonWriter& json) {
+            json.begin_object().key("centers").begin_array();
+            for (const auto& c : result.centers) json.value(c);
+            json.end_array().field("converged", result.converged).field("inertia", result.inertia);
+            json.field("init_seconds", result.init_seconds).field("iterations", result.iterations);
+            json.field("k", kmeans_options.k).field("mode", mode).field("points", count);
+            json.field("seconds", result.seconds).key("sizes").begin_array();
+            for (std::size_t size : result.sizes) json.value(size);
+            json.end_array().field("threads", pool.size()).end_object();
+        });
+
+        return 0;
+    }
+
     // Default behavior: run full demo
+    // Its JSON document (section 10) is the whole output in the json and ndjson modes
+    const Point<int> origin{0, 0};
+    const Point<int> target{3, 4};
+    auto demo_json = [&](JsonWriter& json) {
+        json.begin_object();
+        json.key("operations").begin_object();
+        json.field("difference", target - origin).field("distance", origin.distance_to(target));
+        json.field("sum", origin + target).end_object();
+        json.key("points").begin_array();
+        json.begin_object().field("name", "origin").field("x", origin.x).field("y", origin.y).end_object();
+        json.begin_object().field("name", "target").field("x", target.x).field("y", target.y).end_object();
+        json.end_array().end_object();
+    };
+    if (!text) {
+        print_json("", demo_json);
+        return 0;
+    }
+
     fmt::print("Point<T> Template Class Demo\n");
     fmt::print("=================================\n\n");
     
@@ -214,16 +539,8 @@ auto main(int argc, char **argv) -> int
     
     // 10. JSON integration
     fmt::print("10. JSON Integration:\n");
-    json j;
-    j["points"] = json::array();
-    j["points"].push_back({{"name", "origin"}, {"x", p1.x}, {"y", p1.y}});
-    j["points"].push_back({{"name", "target"}, {"x", p2.x}, {"y", p2.y}});
-    j["operations"] = {
-        {"distance", p1.distance_to(p2)},
-        {"sum", {{"x", (p1 + p2).x}, {"y", (p1 + p2).y}}},
-        {"difference", {{"x", (p2 - p1).x}, {"y", (p2 - p1).y}}}
-    };
-    fmt::print("   JSON output:\n{}\n\n", j.dump(2));
+    print_json("   ", demo_json);
+    fmt::print("\n");
     
     fmt::print("=================================\n");
     fmt::print("All Point<T> operations completed successfully!\n");
@@ -232,6 +549,10 @@ auto main(int argc, char **argv) -> int
     fmt::print("  {} distance --x1 0 --y1 0 --x2 3 --y2 4\n", app.get_name());
     fmt::print("  {} move -x 10 -y 20 --dx 5 --dy -3\n", app.get_name());
     fmt::print("  {} arithmetic --ax 10 --ay 20 --bx 3 --by 7 -s 2.5\n", app.get_name());
+    fmt::print("  {} batch distance -f csv < pairs.csv > distances.csv\n", app.get_name());
+    fmt::print("  {} simulate -n 1000000 --steps 1000 --boundary wrap\n", app.get_name());
+    fmt::print("  {} kmeans -n 1000000 -k 8 --batch-size 4096\n", app.get_name());
+    fmt::print("  {} --output json demo | {} convert -o points.pts -t int32\n", app.get_name(), app.get_name());
     fmt::print("  {} demo\n", app.get_name());
 
     return 0;
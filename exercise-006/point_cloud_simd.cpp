@@ -0,0 +1,586 @@
+// point_cloud_simd.cpp
+#include "point_cloud.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define POINT_CLOUD_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace cloud_simd {
+namespace {
+
+// Outside [tiny, huge] the squares lose precision, std::hypot handles those pairs
+constexpr double huge = 1e150;
+constexpr double tiny = 1e-150;
+
+// Shared by both instruction sets, so that they return identical results
+double distance(double dx, double dy) noexcept {
+  const double ax = std::fabs(dx);
+  const double ay = std::fabs(dy);
+  const double m = ax > ay ? ax : ay;
+  if (!(ax <= huge) || !(ay <= huge) || (m < tiny && m > 0)) {
+    return std::hypot(dx, dy);
+  }
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// Wrap-around integer arithmetic, matching the AVX2 instructions
+int wrapping_add(int a, int b) noexcept {
+  return static_cast<int>(static_cast<std::uint32_t>(a) + static_cast<std::uint32_t>(b));
+}
+
+int wrapping_mul(int a, int b) noexcept {
+  return static_cast<int>(static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(b));
+}
+
+// --- scalar kernels ------------------------------------------------------
+
+void add_scalar(int* data, std::size_t n, int value) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] = wrapping_add(data[i], value);
+}
+
+void add_scalar(int* data, const int* values, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] = wrapping_add(data[i], values[i]);
+}
+
+void mul_scalar(int* data, std::size_t n, int factor) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] = wrapping_mul(data[i], factor);
+}
+
+template <typename T>
+void add_scalar(T* data, std::size_t n, T value) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] += value;
+}
+
+template <typename T>
+void add_scalar(T* data, const T* values, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] += values[i];
+}
+
+template <typename T>
+void mul_scalar(T* data, std::size_t n, T factor) noexcept {
+  for (std::size_t i = 0; i < n; ++i) data[i] *= factor;
+}
+
+void add_scalar(const int* a, const int* b, std::size_t n, int* out) noexcept {
+  for (std::size_t i = 0; i < n; ++i) out[i] = wrapping_add(a[i], b[i]);
+}
+
+template <typename T>
+void add_scalar(const T* a, const T* b, std::size_t n, T* out) noexcept {
+  for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+// Same operand order as the AVX2 min/max instructions, so NaN behaves alike
+template <typename T>
+void clamp_scalar(T* data, std::size_t n, T lo, T hi) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    const T x = lo > data[i] ? lo : data[i];
+    data[i] = hi < x ? hi : x;
+  }
+}
+
+void wrap_scalar(int* data, std::size_t n, int lo, int hi) noexcept {
+  const std::int64_t width = std::int64_t{hi} - lo;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::int64_t offset = (data[i] - std::int64_t{lo}) % width;
+    if (offset < 0) offset += width;
+    data[i] = static_cast<int>(lo + offset);
+  }
+}
+
+// Points rarely move more than one box width per step: one add or subtract
+// brings them back. Only the rest pays for the division.
+template <typename T>
+T wrap_one(T x, T lo, T hi, T width) noexcept {
+  T offset = x - lo;
+  if (offset < T(0)) offset += width;
+  if (offset >= width) offset -= width;
+  if (offset < T(0) || offset >= width) {
+    offset = x - lo;
+    offset -= std::floor(offset / width) * width;
+    if (offset < T(0)) offset += width;
+    if (offset >= width) offset -= width;
+  }
+  const T r = lo + offset;
+  return r < hi ? r : lo;
+}
+
+template <typename T>
+void wrap_scalar(T* data, std::size_t n, T lo, T hi) noexcept {
+  const T width = hi - lo;
+  for (std::size_t i = 0; i < n; ++i) data[i] = wrap_one(data[i], lo, hi, width);
+}
+
+template <typename T>
+void distances_scalar(const T* xs, const T* ys, std::size_t n, T px, T py, double* out) noexcept {
+  const auto qx = static_cast<double>(px);
+  const auto qy = static_cast<double>(py);
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = distance(static_cast<double>(xs[i]) - qx, static_cast<double>(ys[i]) - qy);
+  }
+}
+
+template <typename T>
+void squared_distances_scalar(const T* xs, const T* ys, std::size_t n, T px, T py, double* out) noexcept {
+  const auto qx = static_cast<double>(px);
+  const auto qy = static_cast<double>(py);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double dx = static_cast<double>(xs[i]) - qx;
+    const double dy = static_cast<double>(ys[i]) - qy;
+    out[i] = dx * dx + dy * dy;
+  }
+}
+
+template <typename T>
+void nearest_center_scalar(const T* xs, const T* ys, std::size_t n, const double* cx, const double* cy,
+                           std::size_t k, std::uint32_t* labels, double* squared) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto x = static_cast<double>(xs[i]);
+    const auto y = static_cast<double>(ys[i]);
+    double best = 0.0;
+    std::uint32_t label = 0;
+    for (std::size_t j = 0; j < k; ++j) {
+      const double dx = x - cx[j];
+      const double dy = y - cy[j];
+      const double d = dx * dx + dy * dy;
+      if (j == 0 || d < best) {
+        best = d;
+        label = static_cast<std::uint32_t>(j);
+      }
+    }
+    labels[i] = label;
+    squared[i] = best;
+  }
+}
+
+#if defined(POINT_CLOUD_SIMD_X86)
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// --- AVX2 kernels: 8 ints or floats, 4 doubles per register -------------
+
+TARGET_AVX2 void add_avx2(int* data, std::size_t n, int value) noexcept {
+  const __m256i v = _mm256_set1_epi32(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), v));
+  }
+  add_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 void add_avx2(int* data, const int* values, std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i);
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), v));
+  }
+  add_scalar(data + i, values + i, n - i);
+}
+
+TARGET_AVX2 void mul_avx2(int* data, std::size_t n, int factor) noexcept {
+  const __m256i f = _mm256_set1_epi32(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(p, _mm256_mullo_epi32(_mm256_loadu_si256(p), f));
+  }
+  mul_scalar(data + i, n - i, factor);
+}
+
+TARGET_AVX2 void add_avx2(float* data, std::size_t n, float value) noexcept {
+  const __m256 v = _mm256_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), v));
+  }
+  add_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 void add_avx2(float* data, const float* values, std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), _mm256_loadu_ps(values + i)));
+  }
+  add_scalar(data + i, values + i, n - i);
+}
+
+TARGET_AVX2 void mul_avx2(float* data, std::size_t n, float factor) noexcept {
+  const __m256 f = _mm256_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), f));
+  }
+  mul_scalar(data + i, n - i, factor);
+}
+
+TARGET_AVX2 void add_avx2(double* data, std::size_t n, double value) noexcept {
+  const __m256d v = _mm256_set1_pd(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(data + i, _mm256_add_pd(_mm256_loadu_pd(data + i), v));
+  }
+  add_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 void add_avx2(double* data, const double* values, std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(data + i, _mm256_add_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(values + i)));
+  }
+  add_scalar(data + i, values + i, n - i);
+}
+
+TARGET_AVX2 void mul_avx2(double* data, std::size_t n, double factor) noexcept {
+  const __m256d f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), f));
+  }
+  mul_scalar(data + i, n - i, factor);
+}
+
+TARGET_AVX2 void add_avx2(const int* a, const int* b, std::size_t n, int* out) noexcept {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(va, vb));
+  }
+  add_scalar(a + i, b + i, n - i, out + i);
+}
+
+TARGET_AVX2 void add_avx2(const float* a, const float* b, std::size_t n, float* out) noexcept {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  add_scalar(a + i, b + i, n - i, out + i);
+}
+
+TARGET_AVX2 void add_avx2(const double* a, const double* b, std::size_t n, double* out) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  add_scalar(a + i, b + i, n - i, out + i);
+}
+
+TARGET_AVX2 void clamp_avx2(int* data, std::size_t n, int lo, int hi) noexcept {
+  const __m256i vlo = _mm256_set1_epi32(lo);
+  const __m256i vhi = _mm256_set1_epi32(hi);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(p, _mm256_min_epi32(vhi, _mm256_max_epi32(vlo, _mm256_loadu_si256(p))));
+  }
+  clamp_scalar(data + i, n - i, lo, hi);
+}
+
+// max(lo, x) and min(hi, x) return x if it is NaN
+TARGET_AVX2 void clamp_avx2(float* data, std::size_t n, float lo, float hi) noexcept {
+  const __m256 vlo = _mm256_set1_ps(lo);
+  const __m256 vhi = _mm256_set1_ps(hi);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(data + i, _mm256_min_ps(vhi, _mm256_max_ps(vlo, _mm256_loadu_ps(data + i))));
+  }
+  clamp_scalar(data + i, n - i, lo, hi);
+}
+
+TARGET_AVX2 void clamp_avx2(double* data, std::size_t n, double lo, double hi) noexcept {
+  const __m256d vlo = _mm256_set1_pd(lo);
+  const __m256d vhi = _mm256_set1_pd(hi);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(data + i, _mm256_min_pd(vhi, _mm256_max_pd(vlo, _mm256_loadu_pd(data + i))));
+  }
+  clamp_scalar(data + i, n - i, lo, hi);
+}
+
+// The fast path of wrap_one; lanes that are still outside are redone by wrap_one.
+// For int the offsets are exact in double, so the result equals wrap_scalar.
+TARGET_AVX2 void wrap_avx2(int* data, std::size_t n, int lo, int hi) noexcept {
+  const __m256d vlo = _mm256_set1_pd(lo);
+  const __m256d width = _mm256_set1_pd(static_cast<double>(std::int64_t{hi} - lo));
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i);
+    __m256d offset = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128(p)), vlo);
+    offset = _mm256_add_pd(offset, _mm256_and_pd(_mm256_cmp_pd(offset, zero, _CMP_LT_OQ), width));
+    offset = _mm256_sub_pd(offset, _mm256_and_pd(_mm256_cmp_pd(offset, width, _CMP_GE_OQ), width));
+    const int outside = _mm256_movemask_pd(
+      _mm256_or_pd(_mm256_cmp_pd(offset, zero, _CMP_LT_OQ), _mm256_cmp_pd(offset, width, _CMP_GE_OQ)));
+    if (outside) {
+      wrap_scalar(data + i, 4, lo, hi);
+      continue;
+    }
+    _mm_storeu_si128(p, _mm256_cvttpd_epi32(_mm256_add_pd(vlo, offset)));
+  }
+  wrap_scalar(data + i, n - i, lo, hi);
+}
+
+TARGET_AVX2 void wrap_avx2(float* data, std::size_t n, float lo, float hi) noexcept {
+  const __m256 vlo = _mm256_set1_ps(lo);
+  const __m256 vhi = _mm256_set1_ps(hi);
+  const float w = hi - lo;
+  const __m256 width = _mm256_set1_ps(w);
+  const __m256 zero = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 x = _mm256_loadu_ps(data + i);
+    __m256 offset = _mm256_sub_ps(x, vlo);
+    offset = _mm256_add_ps(offset, _mm256_and_ps(_mm256_cmp_ps(offset, zero, _CMP_LT_OQ), width));
+    offset = _mm256_sub_ps(offset, _mm256_and_ps(_mm256_cmp_ps(offset, width, _CMP_GE_OQ), width));
+    const __m256 r = _mm256_add_ps(vlo, offset);
+    _mm256_storeu_ps(data + i, _mm256_blendv_ps(vlo, r, _mm256_cmp_ps(r, vhi, _CMP_LT_OQ)));
+    const int outside = _mm256_movemask_ps(
+      _mm256_or_ps(_mm256_cmp_ps(offset, zero, _CMP_LT_OQ), _mm256_cmp_ps(offset, width, _CMP_GE_OQ)));
+    for (int lane = 0; outside && lane < 8; ++lane) {
+      if (outside & (1 << lane)) data[i + lane] = wrap_one(x[lane], lo, hi, w);
+    }
+  }
+  wrap_scalar(data + i, n - i, lo, hi);
+}
+
+TARGET_AVX2 void wrap_avx2(double* data, std::size_t n, double lo, double hi) noexcept {
+  const __m256d vlo = _mm256_set1_pd(lo);
+  const __m256d vhi = _mm256_set1_pd(hi);
+  const double w = hi - lo;
+  const __m256d width = _mm256_set1_pd(w);
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d x = _mm256_loadu_pd(data + i);
+    __m256d offset = _mm256_sub_pd(x, vlo);
+    offset = _mm256_add_pd(offset, _mm256_and_pd(_mm256_cmp_pd(offset, zero, _CMP_LT_OQ), width));
+    offset = _mm256_sub_pd(offset, _mm256_and_pd(_mm256_cmp_pd(offset, width, _CMP_GE_OQ), width));
+    const __m256d r = _mm256_add_pd(vlo, offset);
+    _mm256_storeu_pd(data + i, _mm256_blendv_pd(vlo, r, _mm256_cmp_pd(r, vhi, _CMP_LT_OQ)));
+    const int outside = _mm256_movemask_pd(
+      _mm256_or_pd(_mm256_cmp_pd(offset, zero, _CMP_LT_OQ), _mm256_cmp_pd(offset, width, _CMP_GE_OQ)));
+    for (int lane = 0; outside && lane < 4; ++lane) {
+      if (outside & (1 << lane)) data[i + lane] = wrap_one(x[lane], lo, hi, w);
+    }
+  }
+  wrap_scalar(data + i, n - i, lo, hi);
+}
+
+// Loads four coordinates widened to double
+TARGET_AVX2 __m256d load4(const int* p) noexcept {
+  return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+TARGET_AVX2 __m256d load4(const float* p) noexcept { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+TARGET_AVX2 __m256d load4(const double* p) noexcept { return _mm256_loadu_pd(p); }
+
+// Four distances at once; lanes outside the safe range are redone with distance()
+template <typename T>
+TARGET_AVX2 void distances_avx2(const T* xs, const T* ys, std::size_t n, T px, T py, double* out) noexcept {
+  const __m256d qx = _mm256_set1_pd(static_cast<double>(px));
+  const __m256d qy = _mm256_set1_pd(static_cast<double>(py));
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d upper = _mm256_set1_pd(huge);
+  const __m256d lower = _mm256_set1_pd(tiny);
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d dx = _mm256_sub_pd(load4(xs + i), qx);
+    const __m256d dy = _mm256_sub_pd(load4(ys + i), qy);
+    const __m256d sum = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    _mm256_storeu_pd(out + i, _mm256_sqrt_pd(sum));
+
+    // int and float differences always stay in range, only double needs the check
+    if constexpr (std::is_same<T, double>::value) {
+      const __m256d ax = _mm256_andnot_pd(sign, dx);
+      const __m256d ay = _mm256_andnot_pd(sign, dy);
+      const __m256d m = _mm256_max_pd(ax, ay);
+      const __m256d bad = _mm256_or_pd(
+        _mm256_or_pd(_mm256_cmp_pd(ax, upper, _CMP_NLE_UQ), _mm256_cmp_pd(ay, upper, _CMP_NLE_UQ)),
+        _mm256_and_pd(_mm256_cmp_pd(m, lower, _CMP_LT_OQ), _mm256_cmp_pd(m, zero, _CMP_GT_OQ)));
+      const int mask = _mm256_movemask_pd(bad);
+      if (mask) {
+        for (int lane = 0; lane < 4; ++lane) {
+          if (mask & (1 << lane)) {
+            const std::size_t k = i + static_cast<std::size_t>(lane);
+            out[k] = distance(static_cast<double>(xs[k]) - static_cast<double>(px),
+                              static_cast<double>(ys[k]) - static_cast<double>(py));
+          }
+        }
+      }
+    }
+  }
+  distances_scalar(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+template <typename T>
+TARGET_AVX2 void squared_distances_avx2(const T* xs, const T* ys, std::size_t n, T px, T py,
+                                        double* out) noexcept {
+  const __m256d qx = _mm256_set1_pd(static_cast<double>(px));
+  const __m256d qy = _mm256_set1_pd(static_cast<double>(py));
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d dx = _mm256_sub_pd(load4(xs + i), qx);
+    const __m256d dy = _mm256_sub_pd(load4(ys + i), qy);
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+  }
+  squared_distances_scalar(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+// Four points against all centers; the running minimum and its index stay in registers
+template <typename T>
+TARGET_AVX2 void nearest_center_avx2(const T* xs, const T* ys, std::size_t n, const double* cx, const double* cy,
+                                     std::size_t k, std::uint32_t* labels, double* squared) noexcept {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d x = load4(xs + i);
+    const __m256d y = load4(ys + i);
+    __m256d dx = _mm256_sub_pd(x, _mm256_broadcast_sd(cx));
+    __m256d dy = _mm256_sub_pd(y, _mm256_broadcast_sd(cy));
+    __m256d best = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    __m256d label = _mm256_setzero_pd();
+    for (std::size_t j = 1; j < k; ++j) {
+      dx = _mm256_sub_pd(x, _mm256_broadcast_sd(cx + j));
+      dy = _mm256_sub_pd(y, _mm256_broadcast_sd(cy + j));
+      const __m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+      const __m256d closer = _mm256_cmp_pd(d, best, _CMP_LT_OQ);
+      best = _mm256_blendv_pd(best, d, closer);
+      label = _mm256_blendv_pd(label, _mm256_set1_pd(static_cast<double>(j)), closer);
+    }
+    _mm256_storeu_pd(squared + i, best);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(labels + i), _mm256_cvttpd_epi32(label));
+  }
+  nearest_center_scalar(xs + i, ys + i, n - i, cx, cy, k, labels + i, squared + i);
+}
+
+#undef TARGET_AVX2
+
+#endif  // POINT_CLOUD_SIMD_X86
+
+std::atomic<Isa>& active() noexcept {
+  static std::atomic<Isa> isa{detected_isa()};
+  return isa;
+}
+
+bool use_avx2() noexcept {
+  return active().load(std::memory_order_relaxed) == Isa::AVX2;
+}
+
+}  // namespace
+
+Isa detected_isa() noexcept {
+#if defined(POINT_CLOUD_SIMD_X86)
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? Isa::AVX2 : Isa::Scalar;
+  }();
+  return isa;
+#else
+  return Isa::Scalar;
+#endif
+}
+
+Isa active_isa() noexcept {
+  return active().load(std::memory_order_relaxed);
+}
+
+Isa force_isa(Isa isa) noexcept {
+  if (isa == Isa::AVX2 && detected_isa() != Isa::AVX2) {
+    isa = Isa::Scalar;
+  }
+  active().store(isa, std::memory_order_relaxed);
+  return isa;
+}
+
+const char* isa_name(Isa isa) noexcept {
+  return isa == Isa::AVX2 ? "avx2" : "scalar";
+}
+
+#if defined(POINT_CLOUD_SIMD_X86)
+#define POINT_CLOUD_DISPATCH(name, ...) \
+  (use_avx2() ? name##_avx2(__VA_ARGS__) : name##_scalar(__VA_ARGS__))
+#else
+#define POINT_CLOUD_DISPATCH(name, ...) name##_scalar(__VA_ARGS__)
+#endif
+
+void add(int* data, std::size_t n, int value) noexcept { POINT_CLOUD_DISPATCH(add, data, n, value); }
+void add(float* data, std::size_t n, float value) noexcept { POINT_CLOUD_DISPATCH(add, data, n, value); }
+void add(double* data, std::size_t n, double value) noexcept { POINT_CLOUD_DISPATCH(add, data, n, value); }
+
+void add(int* data, const int* values, std::size_t n) noexcept { POINT_CLOUD_DISPATCH(add, data, values, n); }
+void add(float* data, const float* values, std::size_t n) noexcept { POINT_CLOUD_DISPATCH(add, data, values, n); }
+void add(double* data, const double* values, std::size_t n) noexcept { POINT_CLOUD_DISPATCH(add, data, values, n); }
+
+void mul(int* data, std::size_t n, int factor) noexcept { POINT_CLOUD_DISPATCH(mul, data, n, factor); }
+void mul(float* data, std::size_t n, float factor) noexcept { POINT_CLOUD_DISPATCH(mul, data, n, factor); }
+void mul(double* data, std::size_t n, double factor) noexcept { POINT_CLOUD_DISPATCH(mul, data, n, factor); }
+
+void add(const int* a, const int* b, std::size_t n, int* out) noexcept { POINT_CLOUD_DISPATCH(add, a, b, n, out); }
+void add(const float* a, const float* b, std::size_t n, float* out) noexcept {
+  POINT_CLOUD_DISPATCH(add, a, b, n, out);
+}
+void add(const double* a, const double* b, std::size_t n, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(add, a, b, n, out);
+}
+
+void clamp(int* data, std::size_t n, int lo, int hi) noexcept { POINT_CLOUD_DISPATCH(clamp, data, n, lo, hi); }
+void clamp(float* data, std::size_t n, float lo, float hi) noexcept { POINT_CLOUD_DISPATCH(clamp, data, n, lo, hi); }
+void clamp(double* data, std::size_t n, double lo, double hi) noexcept {
+  POINT_CLOUD_DISPATCH(clamp, data, n, lo, hi);
+}
+
+void wrap(int* data, std::size_t n, int lo, int hi) noexcept { POINT_CLOUD_DISPATCH(wrap, data, n, lo, hi); }
+void wrap(float* data, std::size_t n, float lo, float hi) noexcept { POINT_CLOUD_DISPATCH(wrap, data, n, lo, hi); }
+void wrap(double* data, std::size_t n, double lo, double hi) noexcept { POINT_CLOUD_DISPATCH(wrap, data, n, lo, hi); }
+
+void distances(const int* xs, const int* ys, std::size_t n, int px, int py, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(distances, xs, ys, n, px, py, out);
+}
+
+void distances(const float* xs, const float* ys, std::size_t n, float px, float py, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(distances, xs, ys, n, px, py, out);
+}
+
+void distances(const double* xs, const double* ys, std::size_t n, double px, double py, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(distances, xs, ys, n, px, py, out);
+}
+
+void squared_distances(const int* xs, const int* ys, std::size_t n, int px, int py, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(squared_distances, xs, ys, n, px, py, out);
+}
+
+void squared_distances(const float* xs, const float* ys, std::size_t n, float px, float py, double* out) noexcept {
+  POINT_CLOUD_DISPATCH(squared_distances, xs, ys, n, px, py, out);
+}
+
+void squared_distances(const double* xs, const double* ys, std::size_t n, double px, double py,
+                       double* out) noexcept {
+  POINT_CLOUD_DISPATCH(squared_distances, xs, ys, n, px, py, out);
+}
+
+void nearest_center(const int* xs, const int* ys, std::size_t n, const double* cx, const double* cy, std::size_t k,
+                    std::uint32_t* labels, double* squared) noexcept {
+  POINT_CLOUD_DISPATCH(nearest_center, xs, ys, n, cx, cy, k, labels, squared);
+}
+
+void nearest_center(const float* xs, const float* ys, std::size_t n, const double* cx, const double* cy, std::size_t k,
+                    std::uint32_t* labels, double* squared) noexcept {
+  POINT_CLOUD_DISPATCH(nearest_center, xs, ys, n, cx, cy, k, labels, squared);
+}
+
+void nearest_center(const double* xs, const double* ys, std::size_t n, const double* cx, const double* cy,
+                    std::size_t k, std::uint32_t* labels, double* squared) noexcept {
+  POINT_CLOUD_DISPATCH(nearest_center, xs, ys, n, cx, cy, k, labels, squared);
+}
+
+#undef POINT_CLOUD_DISPATCH
+
+}  // namespace cloud_simd
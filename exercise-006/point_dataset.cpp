@@ -0,0 +1,399 @@
+// point_dataset.cpp
+#include "point_dataset.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+namespace point_dataset {
+namespace {
+
+bool is_power_of_two(std::uint64_t v) noexcept {
+  return v != 0 && (v & (v - 1)) == 0;
+}
+
+std::uint64_t round_up(std::uint64_t v, std::uint64_t alignment) noexcept {
+  return (v + alignment - 1) & ~(alignment - 1);
+}
+
+std::size_t element_size_of(ElementType type) noexcept {
+  switch (type) {
+    case ElementType::Int32: return 4;
+    case ElementType::Int64: return 8;
+    case ElementType::Float32: return 4;
+    case ElementType::Float64: return 8;
+  }
+  return 0;
+}
+
+std::uint32_t byte_swap(std::uint32_t v) noexcept {
+  return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+[[noreturn]] void fail(const std::string& what) {
+  throw std::runtime_error(fmt::format("point_dataset: {}", what));
+}
+
+}  // namespace
+
+const char* element_type_name(ElementType type) noexcept {
+  switch (type) {
+    case ElementType::Int32: return "int32";
+    case ElementType::Int64: return "int64";
+    case ElementType::Float32: return "float32";
+    case ElementType::Float64: return "float64";
+  }
+  return "unknown";
+}
+
+ElementType parse_element_type(const std::string& name) {
+  for (ElementType type : {ElementType::Int32, ElementType::Int64, ElementType::Float32, ElementType::Float64}) {
+    if (name == element_type_name(type)) return type;
+  }
+  throw std::invalid_argument(fmt::format("unknown element type '{}' (int32, int64, float32, float64)", name));
+}
+
+const char* layout_name(Layout layout) noexcept {
+  return layout == Layout::Columns ? "columns" : "interleaved";
+}
+
+Layout parse_layout(const std::string& name) {
+  if (name == "interleaved") return Layout::Interleaved;
+  if (name == "columns") return Layout::Columns;
+  throw std::invalid_argument(fmt::format("unknown layout '{}' (interleaved, columns)", name));
+}
+
+namespace detail {
+
+Header make_header(ElementType type, std::size_t element_size, std::size_t dimension, Layout layout,
+                   std::uint64_t count, std::size_t alignment) {
+  // Beyond a page the mapping itself would no longer be aligned
+  if (!is_power_of_two(alignment) || alignment > 4096) {
+    throw std::invalid_argument("point_dataset: alignment must be a power of two up to 4096");
+  }
+  if (alignment < element_size) {
+    throw std::invalid_argument("point_dataset: alignment must be at least the element size");
+  }
+  if (dimension == 0 || dimension > std::numeric_limits<std::uint8_t>::max()) {
+    throw std::invalid_argument("point_dataset: dimension must be between 1 and 255");
+  }
+  Header header{};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.byte_order = byte_order_mark;
+  header.version = version;
+  header.element_type = static_cast<std::uint8_t>(type);
+  header.dimension = static_cast<std::uint8_t>(dimension);
+  header.layout = static_cast<std::uint8_t>(layout);
+  header.element_size = static_cast<std::uint8_t>(element_size);
+  header.alignment = static_cast<std::uint32_t>(alignment);
+  header.count = count;
+  header.stride = layout == Layout::Interleaved ? dimension * element_size : round_up(count * element_size, alignment);
+  header.data_offset = round_up(sizeof(Header), alignment);
+  return header;
+}
+
+void validate(const Header& header, std::uint64_t file_size) {
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) fail("not a point dataset (bad magic)");
+  if (header.byte_order != byte_order_mark) {
+    fail(header.byte_order == byte_swap(byte_order_mark) ? "written on a machine with the other byte order"
+                                                         : "bad byte order mark");
+  }
+  if (header.version == 0 || header.version > version) {
+    fail(fmt::format("unsupported version {} (this build reads up to {})", header.version, version));
+  }
+  const auto type = static_cast<ElementType>(header.element_type);
+  const std::size_t element_size = element_size_of(type);
+  if (element_size == 0) fail(fmt::format("unknown element type {}", header.element_type));
+  if (header.element_size != element_size) fail("element size does not match the element type");
+  if (header.dimension == 0) fail("dimension is 0");
+  const auto layout = static_cast<Layout>(header.layout);
+  if (layout != Layout::Interleaved && layout != Layout::Columns) fail(fmt::format("unknown layout {}", header.layout));
+  if (!is_power_of_two(header.alignment)) fail("alignment is not a power of two");
+  // The views cast the mapping to const T*, so every coordinate must be aligned for T
+  if (header.alignment < element_size) fail("alignment is smaller than an element");
+  if (header.data_offset < sizeof(Header) || header.data_offset % header.alignment != 0) fail("bad data offset");
+  if (header.data_offset > file_size) fail("truncated before the data");
+
+  // Compare by division, a corrupt count or stride must not overflow
+  const std::uint64_t available = file_size - header.data_offset;
+  const std::uint64_t dimension = header.dimension;
+  if (layout == Layout::Interleaved) {
+    if (header.stride < dimension * element_size) fail("stride is smaller than a point");
+    if (header.stride % element_size != 0) fail("stride is not a multiple of the element size");
+    if (header.count > available / header.stride) fail("truncated, fewer points than the header says");
+    return;
+  }
+  if (header.stride % header.alignment != 0 || header.stride % element_size != 0) fail("column stride is not aligned");
+  if (header.count > header.stride / element_size) fail("column stride is smaller than a column");
+  if (dimension > 1 && header.stride > available / (dimension - 1)) fail("truncated, fewer columns than the header says");
+  if ((dimension - 1) * header.stride + header.count * element_size > available) fail("truncated in the last column");
+}
+
+OutputFile::OutputFile(const std::string& path) : m_file(std::fopen(path.c_str(), "wb")), m_path(path) {
+  if (!m_file) fail(fmt::format("cannot create {}: {}", path, std::strerror(errno)));
+}
+
+OutputFile::~OutputFile() {
+  if (m_file) std::fclose(m_file);
+}
+
+void OutputFile::write(const void* data, std::size_t bytes) {
+  if (bytes > 0 && std::fwrite(data, 1, bytes, m_file) != bytes) fail(fmt::format("write error on {}", m_path));
+  m_offset += bytes;
+}
+
+void OutputFile::pad_to(std::uint64_t offset) {
+  static constexpr char zeros[256] = {};
+  while (m_offset < offset) {
+    write(zeros, static_cast<std::size_t>(std::min<std::uint64_t>(offset - m_offset, sizeof(zeros))));
+  }
+}
+
+void OutputFile::finish(const Header& header) {
+  const bool ok = std::fflush(m_file) == 0 && std::fseek(m_file, 0, SEEK_SET) == 0 &&
+                  std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+  const bool closed = std::fclose(m_file) == 0;
+  m_file = nullptr;
+  if (!ok || !closed) fail(fmt::format("write error on {}", m_path));
+}
+
+}  // namespace detail
+
+// ---------------------------------------------------------------------------
+// Dataset
+
+Dataset::Dataset(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) fail(fmt::format("cannot open {}: {}", path, std::strerror(errno)));
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    const int error = errno;
+    ::close(fd);
+    fail(fmt::format("cannot stat {}: {}", path, std::strerror(error)));
+  }
+  const auto file_size = static_cast<std::uint64_t>(info.st_size);
+  if (file_size < sizeof(Header)) {
+    ::close(fd);
+    fail(fmt::format("{} is not a point dataset (too small)", path));
+  }
+  void* data = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  ::close(fd);  // the mapping keeps the file open
+  if (data == MAP_FAILED) fail(fmt::format("cannot map {}: {}", path, std::strerror(error)));
+  m_data = data;
+  m_size = static_cast<std::size_t>(file_size);
+  try {
+    detail::validate(header(), file_size);
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+Dataset::Dataset(Dataset&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+Dataset& Dataset::operator=(Dataset&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+Dataset::~Dataset() {
+  release();
+}
+
+void Dataset::release() noexcept {
+  if (m_data) ::munmap(m_data, m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void Dataset::check(ElementType type, std::size_t dimension, Layout layout, const char* what) const {
+  if (this->layout() != layout) {
+    throw std::invalid_argument(
+        fmt::format("point_dataset: {}() needs a {} dataset, this one is {}", what, layout_name(layout),
+                    layout_name(this->layout())));
+  }
+  if (element_type() != type || this->dimension() != dimension) {
+    throw std::invalid_argument(fmt::format("point_dataset: requested {} x {}, the file holds {} x {}",
+                                            element_type_name(type), dimension, element_type_name(element_type()),
+                                            this->dimension()));
+  }
+}
+
+// ---------------------------------------------------------------------------
+// convert_json
+
+namespace {
+
+// Keys of the coordinates in Point<T, N> order
+constexpr char coordinate_keys[] = {'x', 'y', 'z', 'w'};
+
+// Converts one JSON number into a coordinate; false if it does not fit exactly
+template <typename T, typename V>
+bool to_coordinate(V v, T& out) noexcept {
+  if constexpr (std::is_integral<T>::value) {
+    if constexpr (std::is_floating_point<V>::value) {
+      // 2^63 as a double is exact, the largest int64 is not
+      constexpr double limit = -static_cast<double>(std::numeric_limits<T>::min());
+      if (!(v >= -limit && v < limit) || std::trunc(v) != v) return false;
+    } else if constexpr (std::is_signed<V>::value) {
+      if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max()) return false;
+    } else {
+      if (v > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) return false;
+    }
+  } else if constexpr (std::is_same<T, float>::value && std::is_floating_point<V>::value) {
+    if (std::fabs(v) > std::numeric_limits<float>::max()) return false;
+  }
+  out = static_cast<T>(v);
+  return true;
+}
+
+/**
+ * @brief SAX handler that turns every object with all coordinate keys into a point
+ */
+template <typename T, std::size_t N, typename Emit>
+class PointCollector {
+public:
+  explicit PointCollector(Emit& emit) : m_emit(emit) {}
+
+  bool start_object(std::size_t) {
+    clear_key();
+    m_frames.push_back(Frame{true});
+    return true;
+  }
+
+  bool end_object() {
+    const Frame frame = m_frames.back();
+    m_frames.pop_back();
+    if (frame.seen == (1u << N) - 1) m_emit(frame.point);
+    return true;
+  }
+
+  bool start_array(std::size_t) {
+    clear_key();
+    m_frames.push_back(Frame{false});
+    return true;
+  }
+
+  bool end_array() {
+    m_frames.pop_back();
+    return true;
+  }
+
+  bool key(std::string& name) {
+    Frame& frame = m_frames.back();
+    frame.key = -1;
+    for (std::size_t d = 0; d < N && name.size() == 1; ++d) {
+      if (name[0] == coordinate_keys[d]) frame.key = static_cast<int>(d);
+    }
+    return true;
+  }
+
+  bool number_integer(nlohmann::json::number_integer_t v) { return number(v); }
+  bool number_unsigned(nlohmann::json::number_unsigned_t v) { return number(v); }
+  bool number_float(nlohmann::json::number_float_t v, const std::string&) { return number(v); }
+
+  bool null() { return clear_key(); }
+  bool boolean(bool) { return clear_key(); }
+  bool string(std::string&) { return clear_key(); }
+  bool binary(nlohmann::json::binary_t&) { return clear_key(); }
+
+  bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
+    fail(fmt::format("invalid JSON: {}", e.what()));
+  }
+
+private:
+  struct Frame {
+    bool object;
+    int key = -1;       // coordinate index of the pending key, -1 for any other key
+    unsigned seen = 0;  // bit d: coordinate d was set
+    Point<T, N> point{};
+  };
+
+  template <typename V>
+  bool number(V v) {
+    if (m_frames.empty() || !m_frames.back().object || m_frames.back().key < 0) return true;
+    Frame& frame = m_frames.back();
+    if (!to_coordinate(v, frame.point[static_cast<std::size_t>(frame.key)])) {
+      fail(fmt::format("value {} of \"{}\" does not fit {}", v, coordinate_keys[frame.key],
+                       element_type_name(element_type_of<T>())));
+    }
+    frame.seen |= 1u << frame.key;
+    frame.key = -1;
+    return true;
+  }
+
+  bool clear_key() {
+    if (!m_frames.empty()) m_frames.back().key = -1;
+    return true;
+  }
+
+  Emit& m_emit;
+  std::vector<Frame> m_frames;
+};
+
+// Parses every top-level document of in, one after the other
+template <typename T, std::size_t N, typename Emit>
+void collect_points(std::istream& in, Emit& emit) {
+  PointCollector<T, N, Emit> collector(emit);
+  while (in >> std::ws, in.peek() != std::char_traits<char>::eof()) {
+    nlohmann::json::sax_parse(in, &collector, nlohmann::json::input_format_t::json, false);
+  }
+  if (in.bad()) fail("read error");
+}
+
+template <typename T, std::size_t N>
+std::size_t convert(std::istream& in, const std::string& path, const ConvertOptions& options) {
+  if (options.layout == Layout::Interleaved) {
+    Writer<T, N> writer(path, options.alignment);
+    auto emit = [&](const Point<T, N>& p) { writer.write(p); };
+    collect_points<T, N>(in, emit);
+    writer.close();
+    return writer.size();
+  }
+  // The column stride depends on the count, so the points are collected first
+  std::vector<Point<T, N>> points;
+  auto emit = [&](const Point<T, N>& p) { points.push_back(p); };
+  collect_points<T, N>(in, emit);
+  write(path, points, Layout::Columns, options.alignment);
+  return points.size();
+}
+
+template <typename T>
+std::size_t convert(std::istream& in, const std::string& path, const ConvertOptions& options) {
+  switch (options.dimension) {
+    case 2: return convert<T, 2>(in, path, options);
+    case 3: return convert<T, 3>(in, path, options);
+    case 4: return convert<T, 4>(in, path, options);
+    default: throw std::invalid_argument("point_dataset: convert_json supports 2 to 4 dimensions");
+  }
+}
+
+}  // namespace
+
+std::size_t convert_json(std::istream& in, const std::string& path, const ConvertOptions& options) {
+  switch (options.type) {
+    case ElementType::Int32: return convert<std::int32_t>(in, path, options);
+    case ElementType::Int64: return convert<std::int64_t>(in, path, options);
+    case ElementType::Float32: return convert<float>(in, path, options);
+    case ElementType::Float64: return convert<double>(in, path, options);
+  }
+  throw std::invalid_argument("point_dataset: unknown element type");
+}
+
+}  // namespace point_dataset
@@ -0,0 +1,334 @@
+// point_stream.cpp
+#include "point_stream.hpp"
+
+#include "json_writer.hpp"
+#include "point.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fmt/ranges.h>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+namespace point_stream {
+namespace {
+
+bool is_space(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+  while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
+  return s;
+}
+
+// Parses all of s as a number; a leading '+' is allowed as in strtod
+bool parse_number(std::string_view s, double& value) noexcept {
+  if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+  const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  return ec == std::errc() && end == s.data() + s.size() && !s.empty();
+}
+
+}  // namespace
+
+Format parse_format(std::string_view name) {
+  if (name == "csv") return Format::Csv;
+  if (name == "ndjson") return Format::Ndjson;
+  if (name == "binary") return Format::Binary;
+  throw std::invalid_argument(fmt::format("unknown format '{}' (csv, ndjson, binary)", name));
+}
+
+Operation parse_operation(std::string_view name) {
+  if (name == "distance") return Operation::Distance;
+  if (name == "move") return Operation::Move;
+  if (name == "arithmetic") return Operation::Arithmetic;
+  throw std::invalid_argument(fmt::format("unknown operation '{}' (distance, move, arithmetic)", name));
+}
+
+const std::vector<std::string>& input_fields(Operation op) {
+  static const std::vector<std::string> distance{"x1", "y1", "x2", "y2"};
+  static const std::vector<std::string> move{"x", "y", "dx", "dy"};
+  static const std::vector<std::string> arithmetic{"ax", "ay", "bx", "by"};
+  switch (op) {
+    case Operation::Move: return move;
+    case Operation::Arithmetic: return arithmetic;
+    default: return distance;
+  }
+}
+
+const std::vector<std::string>& output_fields(Operation op) {
+  static const std::vector<std::string> distance{"distance"};
+  static const std::vector<std::string> move{"x", "y"};
+  static const std::vector<std::string> arithmetic{"add_x", "add_y", "sub_x", "sub_y", "mul_x", "mul_y"};
+  switch (op) {
+    case Operation::Move: return move;
+    case Operation::Arithmetic: return arithmetic;
+    default: return distance;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// RecordReader
+
+RecordReader::RecordReader(std::FILE* in, Format format, Operation op, std::size_t buffer_size)
+    : m_in(in), m_format(format), m_fields(input_fields(op)), m_buffer(std::max<std::size_t>(buffer_size, 64)) {}
+
+void RecordReader::fail(const std::string& what) const {
+  const char* unit = m_format == Format::Binary ? "record" : "line";
+  throw std::runtime_error(fmt::format("{} {}: {}", unit, m_line, what));
+}
+
+// Moves the unread bytes to the front and reads more; false if nothing new arrived
+bool RecordReader::fill() {
+  if (m_eof) return false;
+  if (m_begin > 0) {
+    std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+  }
+  if (m_end == m_buffer.size()) {
+    m_buffer.resize(m_buffer.size() * 2);
+  }
+  const std::size_t got = std::fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_in);
+  if (got == 0) {
+    if (std::ferror(m_in)) throw std::runtime_error("read error");
+    m_eof = true;
+    return false;
+  }
+  m_end += got;
+  return true;
+}
+
+bool RecordReader::next_line(std::string_view& line) {
+  std::size_t scanned = m_begin;
+  for (;;) {
+    const char* first = m_buffer.data() + scanned;
+    const void* newline = std::memchr(first, '\n', m_end - scanned);
+    if (newline) {
+      const char* stop = static_cast<const char*>(newline);
+      line = std::string_view(m_buffer.data() + m_begin, static_cast<std::size_t>(stop - (m_buffer.data() + m_begin)));
+      m_begin = static_cast<std::size_t>(stop - m_buffer.data()) + 1;
+      ++m_line;
+      return true;
+    }
+    const std::size_t offset = m_end - m_begin;  // already scanned, survives the move in fill()
+    if (!fill()) break;
+    scanned = offset;
+  }
+  if (m_begin == m_end) return false;
+  // Last line without a trailing newline
+  line = std::string_view(m_buffer.data() + m_begin, m_end - m_begin);
+  m_begin = m_end;
+  ++m_line;
+  return true;
+}
+
+bool RecordReader::next(double* fields) {
+  const std::size_t n = m_fields.size();
+  if (m_format == Format::Binary) {
+    const std::size_t bytes = n * sizeof(double);
+    while (m_end - m_begin < bytes) {
+      if (!fill()) {
+        if (m_begin == m_end) return false;
+        ++m_line;
+        fail(fmt::format("truncated, {} of {} bytes", m_end - m_begin, bytes));
+      }
+    }
+    std::memcpy(fields, m_buffer.data() + m_begin, bytes);
+    m_begin += bytes;
+    ++m_line;
+    return true;
+  }
+
+  std::string_view line;
+  while (next_line(line)) {
+    line = trim(line);
+    if (line.empty()) continue;
+    if (m_format == Format::Ndjson) {
+      parse_ndjson(line, fields);
+      return true;
+    }
+    // A first non-blank line that does not start with a number is the header
+    const bool first_line = !m_content;
+    m_content = true;
+    double first;
+    if (first_line && !parse_number(trim(line.substr(0, line.find(','))), first)) continue;
+    parse_csv(line, fields);
+    return true;
+  }
+  return false;
+}
+
+void RecordReader::parse_csv(std::string_view line, double* fields) {
+  const std::size_t n = m_fields.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t comma = line.find(',');
+    if ((comma == std::string_view::npos) != (i + 1 == n)) {
+      fail(fmt::format("expected {} comma separated values", n));
+    }
+    const std::string_view field = trim(line.substr(0, comma));
+    if (!parse_number(field, fields[i])) fail(fmt::format("'{}' is not a number", field));
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+  }
+}
+
+// Flat objects with each input field exactly once as key and numbers as values, in any order
+void RecordReader::parse_ndjson(std::string_view line, double* fields) {
+  const std::size_t n = m_fields.size();
+  unsigned seen = 0;
+  std::size_t pos = 0;
+  auto skip_space = [&] {
+    while (pos < line.size() && (is_space(line[pos]) || line[pos] == '\n')) ++pos;
+  };
+  auto expect = [&](char c) {
+    skip_space();
+    if (pos >= line.size() || line[pos] != c) fail(fmt::format("expected '{}' in JSON object", c));
+    ++pos;
+  };
+
+  expect('{');
+  skip_space();
+  if (pos < line.size() && line[pos] == '}') fail("empty JSON object");
+  for (;;) {
+    expect('"');
+    const std::size_t key_end = line.find('"', pos);
+    if (key_end == std::string_view::npos) fail("unterminated key");
+    const std::string_view key = line.substr(pos, key_end - pos);
+    pos = key_end + 1;
+    const auto it = std::find(m_fields.begin(), m_fields.end(), key);
+    if (it == m_fields.end()) fail(fmt::format("unexpected key \"{}\"", key));
+    const auto index = static_cast<std::size_t>(it - m_fields.begin());
+    if (seen & (1u << index)) fail(fmt::format("duplicate key \"{}\"", key));
+
+    expect(':');
+    skip_space();
+    const std::size_t value_end = line.find_first_of(",} \t\r", pos);
+    const std::string_view value = line.substr(pos, value_end == std::string_view::npos ? value_end : value_end - pos);
+    if (!parse_number(value, fields[index])) fail(fmt::format("value of \"{}\" is not a number", key));
+    seen |= 1u << index;
+    pos += value.size();
+
+    skip_space();
+    if (pos < line.size() && line[pos] == ',') {
+      ++pos;
+      continue;
+    }
+    expect('}');
+    break;
+  }
+  skip_space();
+  if (pos != line.size()) fail("trailing characters after JSON object");
+  if (seen != (1u << n) - 1) fail(fmt::format("missing keys, expected {}", fmt::join(m_fields, ", ")));
+}
+
+// ---------------------------------------------------------------------------
+// RecordWriter
+
+RecordWriter::RecordWriter(std::FILE* out, Format format, Operation op, std::size_t flush_threshold)
+    : m_out(out), m_format(format), m_fields(output_fields(op)), m_threshold(flush_threshold) {
+  if (m_format == Format::Csv) {
+    fmt::format_to(std::back_inserter(m_buffer), "{}\n", fmt::join(m_fields, ","));
+  }
+}
+
+RecordWriter::~RecordWriter() {
+  try {
+    flush();
+  } catch (...) {
+    // Destructors must not throw; call flush() to see write errors
+  }
+}
+
+void RecordWriter::write(const double* fields) {
+  const std::size_t n = m_fields.size();
+  auto out = std::back_inserter(m_buffer);
+  switch (m_format) {
+    case Format::Csv:
+      for (std::size_t i = 0; i < n; ++i) {
+        if (i > 0) m_buffer.push_back(',');
+        fmt::format_to(out, "{}", fields[i]);
+      }
+      m_buffer.push_back('\n');
+      break;
+    case Format::Ndjson: {
+      // Same numbers as nlohmann::json::dump(), NaN and infinity become null
+      JsonWriter json(m_buffer);
+      json.begin_object();
+      for (std::size_t i = 0; i < n; ++i) {
+        json.field(m_fields[i], fields[i]);
+      }
+      json.end_object();
+      m_buffer.push_back('\n');
+      break;
+    }
+    case Format::Binary: {
+      const char* bytes = reinterpret_cast<const char*>(fields);
+      m_buffer.append(bytes, bytes + n * sizeof(double));
+      break;
+    }
+  }
+  if (m_buffer.size() >= m_threshold) flush();
+}
+
+void RecordWriter::flush() {
+  if (m_buffer.size() == 0) return;
+  const std::size_t written = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_out);
+  const std::size_t size = m_buffer.size();
+  m_buffer.clear();
+  if (written != size || std::fflush(m_out) != 0) throw std::runtime_error("write error");
+}
+
+// ---------------------------------------------------------------------------
+
+void compute(const Options& options, const double* in, double* out) noexcept {
+  const Point<double> a{in[0], in[1]};
+  const Point<double> b{in[2], in[3]};
+  switch (options.operation) {
+    case Operation::Distance:
+      out[0] = a.distance_to(b);
+      break;
+    case Operation::Move: {
+      Point<double> p = a;
+      p.move(b);
+      out[0] = p.x;
+      out[1] = p.y;
+      break;
+    }
+    case Operation::Arithmetic: {
+      const Point<double> sum = a + b;
+      const Point<double> difference = a - b;
+      const Point<double> scaled = a * options.scalar;
+      out[0] = sum.x;
+      out[1] = sum.y;
+      out[2] = difference.x;
+      out[3] = difference.y;
+      out[4] = scaled.x;
+      out[5] = scaled.y;
+      break;
+    }
+  }
+}
+
+Stats process(std::FILE* in, std::FILE* out, const Options& options) {
+  const auto start = std::chrono::steady_clock::now();
+  RecordReader reader(in, options.input_format, options.operation);
+  RecordWriter writer(out, options.output_format, options.operation);
+
+  Stats stats;
+  double input[max_fields];
+  double output[max_fields];
+  while (reader.next(input)) {
+    compute(options, input, output);
+    writer.write(output);
+    ++stats.records;
+  }
+  writer.flush();
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
+
+}  // namespace point_stream
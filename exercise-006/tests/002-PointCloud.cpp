@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include "../include/point_cloud.hpp"
+#include "test_points.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Random points with a size that is not a multiple of the SIMD width; floating point
+// coordinates get a fractional part
+template <typename T>
+std::vector<Point<T>> cloud_points(std::size_t n, unsigned seed) {
+  std::vector<Point<T>> points = random_points<T>(n, seed, 100000);
+  if constexpr (!std::is_integral<T>::value) {
+    for (auto& p : points) p = {p.x / 7, p.y / 3};
+  }
+  return points;
+}
+
+const cloud_simd::Isa all_isas[] = {cloud_simd::Isa::Scalar, cloud_simd::Isa::AVX2};
+
+}  // namespace
+
+TEST_CASE("PointCloud<T>: Speicher & Zugriff") {
+  PointCloud<int> cloud{{1, 2}, {3, 4}};
+  REQUIRE(cloud.size() == 2);
+  REQUIRE(cloud[1] == Point<int>{3, 4});
+  REQUIRE_THROWS_AS(cloud.at(2), std::out_of_range);
+
+  for (int i = 0; i < 100; ++i) {
+    cloud.push_back(Point<int>{i, -i});
+  }
+  REQUIRE(cloud.size() == 102);
+  REQUIRE(cloud.at(101) == Point<int>{99, -99});
+  REQUIRE(reinterpret_cast<std::uintptr_t>(cloud.xs()) % PointCloud<int>::alignment == 0);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(cloud.ys()) % PointCloud<int>::alignment == 0);
+
+  PointCloud<int> copy = cloud;
+  copy.set(0, Point<int>{7, 7});
+  REQUIRE(cloud[0] == Point<int>{1, 2});
+  REQUIRE(copy.to_points().size() == 102);
+
+  copy.resize(200);
+  REQUIRE(copy[150] == Point<int>{});
+  copy.clear();
+  REQUIRE(copy.empty());
+}
+
+TEMPLATE_TEST_CASE("PointCloud<T>: Batch-Operationen wie Point<T>", "", int, float, double, long long) {
+  const std::vector<Point<TestType>> points = cloud_points<TestType>(1003, 42);
+  const std::vector<Point<TestType>> offsets = cloud_points<TestType>(points.size(), 7);
+  const Point<TestType> target{static_cast<TestType>(12), static_cast<TestType>(-34)};
+
+  for (cloud_simd::Isa isa : all_isas) {
+    cloud_simd::force_isa(isa);
+    INFO(cloud_simd::isa_name(cloud_simd::active_isa()));
+
+    PointCloud<TestType> moved(points.begin(), points.end());
+    moved.move(3, -5);
+    PointCloud<TestType> translated(points.begin(), points.end());
+    translated.translate(PointCloud<TestType>(offsets.begin(), offsets.end()));
+    PointCloud<TestType> scaled(points.begin(), points.end());
+    scaled.scale(3);
+    const PointCloud<TestType> cloud(points.begin(), points.end());
+    const auto distances = cloud.distances_to(target);
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      Point<TestType> p = points[i];
+      p.move(3, -5);
+      REQUIRE(moved[i] == p);
+      REQUIRE(translated[i] == points[i] + offsets[i]);
+      REQUIRE(scaled[i] == points[i] * TestType{3});
+      REQUIRE(distances[i] == Catch::Approx(points[i].distance_to(target)).epsilon(1e-15));
+    }
+  }
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+}
+
+TEST_CASE("PointCloud<T>: gleiche Ergebnisse für alle Befehlssätze") {
+  const std::vector<Point<double>> points = cloud_points<double>(517, 3);
+  const PointCloud<double> cloud(points.begin(), points.end());
+
+  cloud_simd::force_isa(cloud_simd::Isa::Scalar);
+  const auto scalar = cloud.distances_to(Point<double>{0.5, 0.25});
+  cloud_simd::force_isa(cloud_simd::Isa::AVX2);
+  const auto vectorized = cloud.distances_to(Point<double>{0.5, 0.25});
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+
+  REQUIRE(scalar == vectorized);
+}
+
+TEST_CASE("PointCloud<T>: distances_to – extreme Werte") {
+  const PointCloud<double> cloud{{1e200, 1e200}, {3e-200, 4e-200}, {0, 0}, {INFINITY, NAN},
+                                 {-1e300, 2}, {5, 12}, {1e-310, 0}, {NAN, 1}};
+  const Point<double> origin{};
+
+  for (cloud_simd::Isa isa : all_isas) {
+    cloud_simd::force_isa(isa);
+    const auto distances = cloud.distances_to(origin);
+    for (std::size_t i = 0; i < cloud.size(); ++i) {
+      const double expected = cloud[i].distance_to(origin);
+      if (std::isnan(expected)) {
+        REQUIRE(std::isnan(distances[i]));
+      } else {
+        REQUIRE(distances[i] == Catch::Approx(expected).epsilon(1e-15));
+      }
+    }
+  }
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+
+  PointCloud<int> ints{{2147483647, -2147483647 - 1}};
+  REQUIRE(ints.distances_to(Point<int>{-2147483647 - 1, 2147483647})[0] ==
+          Catch::Approx(std::hypot(4294967295.0, 4294967295.0)));
+
+  REQUIRE_THROWS_AS(ints.translate(PointCloud<int>{}), std::invalid_argument);
+}
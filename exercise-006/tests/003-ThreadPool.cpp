@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/thread_pool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("ThreadPool: submit liefert Ergebnisse und Ausnahmen") {
+  ThreadPool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.submit([i] { return i * i; }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(results[i].get() == i * i);
+  }
+
+  auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+  REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool: parallel_for besucht jeden Index genau einmal") {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(10007);
+  pool.parallel_for(visits.size(), [&](std::size_t i) { ++visits[i]; });
+  for (const auto& v : visits) {
+    REQUIRE(v == 1);
+  }
+
+  // nested calls from inside a task must not deadlock
+  std::atomic<long> total{0};
+  pool.parallel_for(8, [&](std::size_t) {
+    pool.parallel_for(100, [&](std::size_t j) { total += static_cast<long>(j); });
+  });
+  REQUIRE(total == 8 * 4950);
+}
+
+TEST_CASE("ThreadPool: parallel_for gibt die erste Ausnahme weiter") {
+  ThreadPool pool(2);
+  std::atomic<int> calls{0};
+  REQUIRE_THROWS_AS(pool.parallel_for(1000,
+                                      [&](std::size_t i) {
+                                        ++calls;
+                                        if (i == 10) throw std::out_of_range("index 10");
+                                      }),
+                    std::out_of_range);
+  REQUIRE(calls < 1000);
+
+  // the pool stays usable afterwards
+  std::atomic<int> after{0};
+  pool.parallel_for(50, [&](std::size_t) { ++after; });
+  REQUIRE(after == 50);
+}
+
+TEST_CASE("ThreadPool: parallel_reduce faltet die Teilergebnisse in Reihenfolge") {
+  ThreadPool pool(3);
+  auto sum = [](std::size_t begin, std::size_t end) {
+    long s = 0;
+    for (std::size_t i = begin; i < end; ++i) s += static_cast<long>(i);
+    return s;
+  };
+  auto plus = [](long a, long b) { return a + b; };
+  REQUIRE(pool.parallel_reduce(10007, 100, 0L, sum, plus) == 10006L * 10007 / 2);
+  REQUIRE(pool.parallel_reduce(0, 100, 7L, sum, plus) == 7);
+
+  // chunk boundaries arrive in order, the last chunk is shorter
+  auto bounds = [](std::size_t begin, std::size_t end) { return std::vector<std::size_t>{begin, end}; };
+  auto append = [](std::vector<std::size_t> a, std::vector<std::size_t> b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+  };
+  REQUIRE(pool.parallel_reduce(10, 4, std::vector<std::size_t>{}, bounds, append) ==
+          std::vector<std::size_t>{0, 4, 4, 8, 8, 10});
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../include/distance_matrix.hpp"
+#include "test_points.hpp"
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("pairwise_distances: A x B wie distance_to") {
+  const auto a = random_points<int>(131, 1, 5000);
+  const auto b = random_points<int>(77, 2, 5000);
+  ThreadPool pool(4);
+  DistanceMatrixOptions options;
+  options.tile_rows = 16;  // several partial tiles in both directions
+  options.tile_cols = 20;
+  options.pool = &pool;
+
+  std::vector<double> matrix(a.size() * b.size());
+  pairwise_distances(a, b, matrix.data(), options);
+  std::vector<double> squared(a.size() * b.size());
+  options.squared = true;
+  pairwise_distances(a, b, squared.data(), options);
+
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    for (std::size_t j = 0; j < b.size(); ++j) {
+      const double expected = a[i].distance_to(b[j]);
+      REQUIRE(matrix[i * b.size() + j] == Catch::Approx(expected).epsilon(1e-15));
+      REQUIRE(squared[i * b.size() + j] == Catch::Approx(expected * expected).epsilon(1e-12));
+    }
+  }
+}
+
+TEST_CASE("pairwise_distances: alle Paare sind symmetrisch mit Nulldiagonale") {
+  const auto points = random_points<int>(300, 3, 5000);
+  const PointCloud<int> cloud(points.begin(), points.end());
+  std::vector<double> from_vector(points.size() * points.size());
+  std::vector<double> from_cloud(points.size() * points.size());
+  pairwise_distances(points, from_vector.data());
+  pairwise_distances(cloud, from_cloud.data());
+
+  REQUIRE(from_vector == from_cloud);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    REQUIRE(from_vector[i * points.size() + i] == 0.0);
+    for (std::size_t j = 0; j < i; ++j) {
+      REQUIRE(from_vector[i * points.size() + j] == from_vector[j * points.size() + i]);
+    }
+  }
+
+  REQUIRE_THROWS_AS(pairwise_distances(points, nullptr), std::invalid_argument);
+  pairwise_distances(std::vector<Point<int>>{}, nullptr);  // nothing to do, no buffer needed
+}
+
+TEST_CASE("for_each_distance_tile: jede Zelle genau einmal, ohne volle Matrix") {
+  const auto a = random_points<int>(100, 4, 5000);
+  const auto b = random_points<int>(90, 5, 5000);
+  DistanceMatrixOptions options;
+  options.tile_rows = 7;
+  options.tile_cols = 13;
+
+  std::mutex mutex;
+  std::vector<int> seen(a.size() * b.size(), 0);
+  bool values_ok = true;
+  for_each_distance_tile(
+    a, b,
+    [&](const DistanceTile& tile) {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (std::size_t i = 0; i < tile.rows; ++i) {
+        for (std::size_t j = 0; j < tile.cols; ++j) {
+          ++seen[(tile.row + i) * b.size() + tile.col + j];
+          const double expected = a[tile.row + i].distance_to(b[tile.col + j]);
+          values_ok = values_ok && tile.value(i, j) == Catch::Approx(expected).epsilon(1e-15);
+        }
+      }
+    },
+    options);
+  REQUIRE(values_ok);
+  for (int count : seen) {
+    REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("for_each_distance_tile: upper_triangle deckt alle Paare i < j ab") {
+  const auto points = random_points<int>(97, 6, 5000);
+  DistanceMatrixOptions options;
+  options.tile_rows = 10;
+  options.tile_cols = 10;
+  options.upper_triangle = true;
+
+  std::mutex mutex;
+  std::vector<int> seen(points.size() * points.size(), 0);
+  std::size_t cells = 0;
+  for_each_distance_tile(
+    points,
+    [&](const DistanceTile& tile) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cells += tile.rows * tile.cols;
+      for (std::size_t i = 0; i < tile.rows; ++i) {
+        for (std::size_t j = 0; j < tile.cols; ++j) {
+          ++seen[(tile.row + i) * points.size() + tile.col + j];
+        }
+      }
+    },
+    options);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = i + 1; j < points.size(); ++j) {
+      REQUIRE(seen[i * points.size() + j] == 1);
+    }
+  }
+  REQUIRE(cells < points.size() * points.size() * 6 / 10);
+}
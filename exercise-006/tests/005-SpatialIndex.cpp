@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/kd_tree.hpp"
+#include "../include/uniform_grid.hpp"
+#include "test_points.hpp"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Reference: sort everything by (distance, index)
+template <typename T>
+std::vector<Neighbor> brute_force(const std::vector<Point<T>>& points, const Point<T>& q) {
+  std::vector<Neighbor> all;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    all.push_back({i, points[i].distance_to(q)});
+  }
+  std::sort(all.begin(), all.end(), [](const Neighbor& a, const Neighbor& b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+  });
+  return all;
+}
+
+std::vector<Neighbor> first(std::vector<Neighbor> all, std::size_t k) {
+  all.resize(std::min(k, all.size()));
+  return all;
+}
+
+std::vector<Neighbor> within(std::vector<Neighbor> all, double radius) {
+  all.erase(std::remove_if(all.begin(), all.end(), [radius](const Neighbor& n) { return n.distance > radius; }),
+            all.end());
+  return all;
+}
+
+}  // namespace
+
+TEST_CASE("KdTree: Abfragen wie Brute Force") {
+  // small coordinate range -> many duplicates and ties
+  const auto points = random_points<int>(5000, 1, 60);
+  const auto queries = random_points<int>(200, 2, 70);
+  ThreadPool pool(3);
+  const KdTree<int> tree(points, &pool);
+  REQUIRE(tree.size() == points.size());
+
+  for (const auto& q : queries) {
+    const auto reference = brute_force(points, q);
+    REQUIRE(tree.nearest(q) == reference.front());
+    REQUIRE(tree.k_nearest(q, 10) == first(reference, 10));
+    REQUIRE(tree.within_radius(q, 7.5) == within(reference, 7.5));
+    REQUIRE(tree.within_radius(q, 5.0) == within(reference, 5.0));  // integer distance on the boundary
+  }
+
+  const auto batch = tree.k_nearest(queries, 3, &pool);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    REQUIRE(batch[i] == tree.k_nearest(queries[i], 3));
+  }
+  REQUIRE(tree.nearest(queries, &pool).size() == queries.size());
+}
+
+TEST_CASE("KdTree: Randfälle") {
+  const KdTree<double> empty(std::vector<Point<double>>{});
+  REQUIRE(empty.nearest(Point<double>{1, 2}).index == 0);
+  REQUIRE(empty.k_nearest(Point<double>{1, 2}, 5).empty());
+
+  const std::vector<Point<double>> points{{0.5, 0.5}, {1.5, 0.5}};
+  const KdTree<double> tree(points);
+  REQUIRE(tree.k_nearest(Point<double>{0, 0}, 10).size() == 2);
+  REQUIRE(tree.k_nearest(Point<double>{0, 0}, 0).empty());
+  REQUIRE(tree.within_radius(Point<double>{0, 0}, -1.0).empty());
+
+  // large enough for the parallel build
+  const auto many = random_points<double>(KdTree<double>::parallel_threshold * 3, 9, 1000000);
+  const KdTree<double> big(many);
+  for (const auto& q : random_points<double>(20, 10, 1000000)) {
+    REQUIRE(big.nearest(q) == brute_force(many, q).front());
+  }
+}
+
+TEST_CASE("UniformGrid: Abfragen wie Brute Force") {
+  const auto points = random_points<int>(3000, 3, 500);
+  const auto queries = random_points<int>(150, 4, 800);  // some queries outside the occupied area
+  for (double cell : {1.0, 16.0, 1000.0}) {
+    const UniformGrid<int> grid(cell, points);
+    for (const auto& q : queries) {
+      const auto reference = brute_force(points, q);
+      REQUIRE(grid.nearest(q) == reference.front());
+      REQUIRE(grid.k_nearest(q, 7) == first(reference, 7));
+      REQUIRE(grid.within_radius(q, 40.0) == within(reference, 40.0));
+    }
+  }
+}
+
+TEST_CASE("UniformGrid: insert, update & erase") {
+  UniformGrid<double> grid(2.0);
+  REQUIRE(grid.nearest(Point<double>{0, 0}).index == UniformGrid<double>::npos);
+  REQUIRE_THROWS_AS(UniformGrid<double>(0.0), std::invalid_argument);
+
+  std::vector<Point<double>> points = random_points<double>(500, 5, 50);
+  for (const auto& p : points) {
+    grid.insert(p);
+  }
+  std::mt19937 gen(6);
+  std::uniform_real_distribution<double> coord(-60.0, 60.0);
+  for (std::size_t id = 0; id < points.size(); id += 3) {
+    points[id] = Point<double>{coord(gen), coord(gen)};
+    grid.update(id, points[id]);
+  }
+  REQUIRE(grid.point(3) == points[3]);
+
+  // erase every fifth point; the brute-force reference keeps them far away instead
+  for (std::size_t id = 0; id < points.size(); id += 5) {
+    grid.erase(id);
+    points[id] = Point<double>{1e9, 1e9};
+  }
+  REQUIRE(grid.size() == 400);
+  REQUIRE_FALSE(grid.contains(5));
+  REQUIRE_THROWS_AS(grid.erase(5), std::out_of_range);
+  REQUIRE_THROWS_AS(grid.point(5), std::out_of_range);
+
+  for (const auto& q : random_points<double>(100, 7, 70)) {
+    const auto reference = brute_force(points, q);
+    REQUIRE(grid.k_nearest(q, 5) == first(reference, 5));
+    REQUIRE(grid.within_radius(q, 6.0) == within(reference, 6.0));
+  }
+
+  // erased ids are reused
+  REQUIRE(grid.insert(Point<double>{0, 0}) % 5 == 0);
+  REQUIRE(grid.size() == 401);
+
+  const auto queries = random_points<double>(300, 8, 60);
+  const auto batch = grid.within_radius(queries, 4.0);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    REQUIRE(batch[i] == grid.within_radius(queries[i], 4.0));
+  }
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../include/metric.hpp"
+#include <cmath>
+#include <random>
+#include <type_traits>
+
+TEST_CASE("metric: Werte für alle Policies") {
+  const Point<int> a{0, 0};
+  const Point<int> b{3, -4};
+  REQUIRE(distance<metric::Hypot>(a, b) == 5.0);
+  REQUIRE(distance<metric::Euclidean>(a, b) == 5.0);
+  REQUIRE(distance<metric::SquaredEuclidean>(a, b) == 25.0);
+  REQUIRE(distance<metric::Manhattan>(a, b) == 7.0);
+  REQUIRE(distance<metric::Chebyshev>(a, b) == 4.0);
+
+  // Hypot is exactly distance_to, the common_type promotion is the same
+  STATIC_REQUIRE(std::is_same<decltype(distance<metric::Manhattan>(a, b)), double>::value);
+  const Point<double> c{1.5, 2.5};
+  const Point<double> d{-4.0, 7.25};
+  REQUIRE(distance<metric::Hypot>(c, d) == c.distance_to(d));
+  REQUIRE(distance<metric::Euclidean>(c, d) == Catch::Approx(c.distance_to(d)).epsilon(1e-15));
+}
+
+TEST_CASE("metric: constexpr & noexcept") {
+  constexpr Point<int> a{1, 2};
+  constexpr Point<int> b{-2, 6};
+  STATIC_REQUIRE(distance<metric::SquaredEuclidean>(a, b) == 25.0);
+  STATIC_REQUIRE(distance<metric::Manhattan>(a, b) == 7.0);
+  STATIC_REQUIRE(distance<metric::Chebyshev>(a, b) == 4.0);
+  STATIC_REQUIRE(closer<metric::Chebyshev>(a, a, b));
+  STATIC_REQUIRE(noexcept(distance<metric::Hypot>(a, b)));
+  STATIC_REQUIRE(noexcept(distance<metric::Euclidean>(a, b)));
+
+  // Negative differences, and a negative zero that must not leak into the result
+  STATIC_REQUIRE(metric::detail::abs(-2.5) == 2.5);
+  const Point<double> z{-0.0, -0.0};
+  const Point<double> o{0.0, 0.0};
+  REQUIRE_FALSE(std::signbit(distance<metric::Manhattan>(z, o)));
+  REQUIRE_FALSE(std::signbit(distance<metric::Chebyshev>(z, o)));
+}
+
+TEST_CASE("metric: Integer-Extremwerte laufen nicht über") {
+  const Point<int> lo{-2147483647 - 1, -2147483647 - 1};
+  const Point<int> hi{2147483647, 2147483647};
+  REQUIRE(distance<metric::Manhattan>(lo, hi) == 2.0 * 4294967295.0);
+  REQUIRE(distance<metric::Chebyshev>(lo, hi) == 4294967295.0);
+  REQUIRE(distance<metric::SquaredEuclidean>(lo, hi) == 2.0 * 4294967295.0 * 4294967295.0);
+}
+
+TEST_CASE("metric: SquaredEuclidean ordnet wie distance_to") {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> coord(-1e3, 1e3);
+  const Point<double> q{coord(gen), coord(gen)};
+  for (int i = 0; i < 1000; ++i) {
+    const Point<double> a{coord(gen), coord(gen)};
+    const Point<double> b{coord(gen), coord(gen)};
+    REQUIRE(closer<metric::SquaredEuclidean>(q, a, b) == (q.distance_to(a) < q.distance_to(b)));
+  }
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../include/metric.hpp"
+#include "../include/point.hpp"
+#include "../include/point_fmt.hpp"
+#include <cmath>
+#include <fmt/format.h>
+#include <type_traits>
+
+TEST_CASE("Point<T, N>: Konstruktion & Zugriff") {
+  Point3<int> p{1, 2, 3};
+  REQUIRE(p.x == 1);
+  REQUIRE(p.y == 2);
+  REQUIRE(p.z == 3);
+  REQUIRE(p[2] == 3);
+
+  p.move(1, -1, 4);
+  REQUIRE(p == Point3<int>{2, 1, 7});
+  p.move(Point3<int>{-2, -1, -7});
+  REQUIRE(p == Point3<int>{});
+
+  Point4<float> q{1.f, 2.f, 3.f, 4.f};
+  REQUIRE(q.w == 4.f);
+  q[3] = 5.f;
+  REQUIRE(q.w == 5.f);
+
+  Point<double, 6> r{1, 2, 3, 4, 5, 6};
+  REQUIRE(r[5] == 6.0);
+  REQUIRE(Point<double, 6>{}[4] == 0.0);
+}
+
+TEST_CASE("Point<T, N>: Typen, Ausrichtung & constexpr") {
+  STATIC_REQUIRE(std::is_same<Point<int>, Point2<int>>::value);
+  STATIC_REQUIRE(Point<int>::dimension == 2);
+  STATIC_REQUIRE(Point3<double>::dimension == 3);
+
+  // Whole points fit one SIMD register and never straddle it
+  STATIC_REQUIRE(alignof(Point2<double>) == 16);
+  STATIC_REQUIRE(alignof(Point4<double>) == 32);
+  STATIC_REQUIRE(alignof(Point4<float>) == 16);
+  STATIC_REQUIRE(alignof(Point3<float>) == 16);
+  STATIC_REQUIRE(sizeof(Point2<float>) == 8);
+  STATIC_REQUIRE(sizeof(Point3<double>) == 32);
+  STATIC_REQUIRE(sizeof(Point<double, 8>) == 64);
+
+  constexpr Point3<int> a{1, 2, 3};
+  constexpr Point3<int> b = a + a - Point3<int>{0, 0, 1};
+  STATIC_REQUIRE(b[0] == 2);
+  STATIC_REQUIRE(b[2] == 5);
+  STATIC_REQUIRE(distance<metric::Manhattan>(a, b) == 5.0);
+  STATIC_REQUIRE(distance<metric::Chebyshev>(a, b) == 2.0);
+}
+
+TEST_CASE("Point<T, N>: Arithmetik mit Typ-Promotion") {
+  const Point3<int> a{1, 2, 3};
+  const Point3<int> b{4, 5, 6};
+  REQUIRE(a + b == Point3<int>{5, 7, 9});
+  REQUIRE(b - a == Point3<int>{3, 3, 3});
+
+  const auto s = a * 1.5;
+  STATIC_REQUIRE(std::is_same<decltype(s), const Point3<double>>::value);
+  REQUIRE(s == Point3<double>{1.5, 3.0, 4.5});
+  REQUIRE(a != b);
+}
+
+TEST_CASE("Point<T, N>: distance_to") {
+  const Point3<int> a{0, 0, 0};
+  const Point3<int> b{2, 3, 6};
+  REQUIRE(a.distance_to(b) == 7.0);
+
+  const Point4<double> c{1, 2, 3, 4};
+  const Point4<double> d{-1, 0, 7, 5};
+  REQUIRE(c.distance_to(d) == Catch::Approx(std::sqrt(4.0 + 4.0 + 16.0 + 1.0)));
+
+  const Point<double, 5> e{};
+  const Point<double, 5> f{1, 1, 1, 1, 1};
+  REQUIRE(e.distance_to(f) == Catch::Approx(std::sqrt(5.0)));
+  REQUIRE(distance<metric::Euclidean>(e, f) == Catch::Approx(std::sqrt(5.0)));
+  REQUIRE(distance<metric::SquaredEuclidean>(e, f) == 5.0);
+
+  // Scaled like hypot: no overflow for huge components
+  const Point<double, 5> big{1e300, 1e300, 0, 0, 0};
+  REQUIRE(e.distance_to(big) == Catch::Approx(std::sqrt(2.0) * 1e300));
+  REQUIRE(Point<double, 1>{-3}.distance_to(Point<double, 1>{4}) == 7.0);
+}
+
+TEST_CASE("Point<T, N>: fmt-Formatter") {
+  REQUIRE(fmt::format("{}", Point3<int>{1, 2, 3}) == "(1, 2, 3)");
+  REQUIRE(fmt::format("{}", Point4<double>{0.5, 1, 2, 3}) == "(0.5, 1, 2, 3)");
+  REQUIRE(fmt::format("{}", Point<int, 1>{7}) == "(7)");
+}
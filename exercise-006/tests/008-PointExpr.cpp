@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../include/point_cloud.hpp"
+#include "../include/point_expr.hpp"
+#include "../include/thread_pool.hpp"
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace expr::placeholders;
+
+TEST_CASE("expr: gleiche Werte & Typen wie die eager-Operatoren") {
+  const Point<int> a{10, 20};
+  const Point<int> b{3, 7};
+  const Point<double> c{0.5, -1.25};
+
+  const auto sum = expr::eval(expr::lazy(a) + b);
+  STATIC_REQUIRE(std::is_same<decltype(sum), const Point<int>>::value);
+  REQUIRE(sum == a + b);
+  REQUIRE(expr::eval(expr::lazy(a) - b) == a - b);
+  REQUIRE(expr::eval(-expr::lazy(b)) == Point<int>{-3, -7});
+
+  const auto chain = expr::eval((expr::lazy(a) + b) * 2.5 - c);
+  STATIC_REQUIRE(std::is_same<decltype(chain), const Point<double>>::value);
+  REQUIRE(chain == (a + b) * 2.5 - c);
+  REQUIRE(expr::eval(2.5 * (expr::lazy(a) - b)) == (a - b) * 2.5);
+
+  // Conversion to the result type evaluates as well
+  const Point<double> converted = (expr::lazy(a) + b) * 0.5;
+  REQUIRE(converted == Point<double>{6.5, 13.5});
+  STATIC_REQUIRE(!std::is_convertible<decltype(expr::lazy(a) * 0.5), Point<int>>::value);
+}
+
+TEST_CASE("expr: constexpr, N Dimensionen & Promotion kleiner Typen") {
+  constexpr Point3<int> a{1, 2, 3};
+  constexpr Point3<int> b{4, 5, 6};
+  constexpr auto r = expr::eval((expr::lazy(a) + b) * 2 - a);
+  STATIC_REQUIRE(r == Point3<int>{9, 12, 15});
+
+  // Same wrap-around to T as Point::operator+
+  const Point<unsigned char> big{250, 1};
+  const Point<unsigned char> step{10, 1};
+  REQUIRE(expr::eval(expr::lazy(big) + step) == big + step);
+}
+
+TEST_CASE("expr: apply auf std::vector in einem Durchlauf") {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::vector<Point<double>> a(1000);
+  std::vector<Point<double>> b(1000);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = Point<double>{coord(gen), coord(gen)};
+    b[i] = Point<double>{coord(gen), coord(gen)};
+  }
+  const Point<double> offset{1.5, -2.0};
+  const auto transform = ((_1 + _2) * 2.5 - offset) * 0.5 + _1;
+
+  std::vector<Point<double>> out;
+  expr::apply(transform, out, a, b);
+  REQUIRE(out.size() == a.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    REQUIRE(out[i] == ((a[i] + b[i]) * 2.5 - offset) * 0.5 + a[i]);
+  }
+
+  // In place: the output is the first input
+  std::vector<Point<double>> inplace = a;
+  expr::apply(transform, inplace, inplace, b);
+  REQUIRE(inplace == out);
+
+  // Conversion to the coordinate type of the output
+  std::vector<Point<int>> ints{{1, 2}, {3, 4}};
+  std::vector<Point<double>> halves;
+  expr::apply(_1 * 0.5, halves, ints);
+  REQUIRE(halves == std::vector<Point<double>>{{0.5, 1.0}, {1.5, 2.0}});
+
+  std::vector<Point<double>> shorter(3);
+  REQUIRE_THROWS_AS(expr::apply(_1 + _2, out, a, shorter), std::invalid_argument);
+}
+
+TEST_CASE("expr: apply auf PointCloud & parallel_apply") {
+  PointCloud<float> cloud;
+  std::vector<Point<float>> points;
+  for (int i = 0; i < 50000; ++i) {
+    const Point<float> p{static_cast<float>(i % 1000), static_cast<float>(i / 7)};
+    cloud.push_back(p);
+    points.push_back(p);
+  }
+  const Point<float> shift{-3.0f, 4.0f};
+  const auto transform = (_1 - shift) * 2.0f + shift;
+
+  PointCloud<float> moved;
+  expr::apply(transform, moved, cloud);
+  std::vector<Point<float>> expected;
+  expr::apply(transform, expected, points);
+  REQUIRE(moved.to_points() == expected);
+
+  ThreadPool pool(3);
+  std::vector<Point<float>> parallel;
+  expr::parallel_apply(pool, transform, parallel, points);
+  REQUIRE(parallel == expected);
+
+  expr::parallel_apply(pool, transform, cloud, cloud);
+  REQUIRE(cloud.to_points() == expected);
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/point_stream.hpp"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using File = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+File temp_file(const std::string& content) {
+  File file(std::tmpfile(), &std::fclose);
+  std::fwrite(content.data(), 1, content.size(), file.get());
+  std::rewind(file.get());
+  return file;
+}
+
+std::string read_all(std::FILE* file) {
+  std::rewind(file);
+  std::string content;
+  char buffer[4096];
+  for (std::size_t got; (got = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+    content.append(buffer, got);
+  }
+  return content;
+}
+
+std::string run(const std::string& input, const point_stream::Options& options) {
+  const File in = temp_file(input);
+  const File out(std::tmpfile(), &std::fclose);
+  point_stream::process(in.get(), out.get(), options);
+  return read_all(out.get());
+}
+
+}  // namespace
+
+TEST_CASE("point_stream: CSV mit Header, Leerzeilen & CRLF") {
+  point_stream::Options options;
+  const std::string out = run("x1,y1,x2,y2\r\n0,0,3,4\r\n\n 1.5 , 2.5,4.5,+6.5\n-1e3,0,0,0", options);
+  REQUIRE(out == "distance\n5\n5\n1000\n");
+
+  // The header may follow blank lines, but only the first non-blank line can be one
+  REQUIRE(run("\n  \r\nx1,y1,x2,y2\n0,0,3,4\n", options) == "distance\n5\n");
+  REQUIRE_THROWS_AS(run("\n0,0,3,4\nx1,y1,x2,y2\n", options), std::runtime_error);
+}
+
+TEST_CASE("point_stream: NDJSON & alle Operationen") {
+  point_stream::Options options;
+  options.input_format = point_stream::Format::Ndjson;
+  options.output_format = point_stream::Format::Ndjson;
+
+  options.operation = point_stream::Operation::Move;
+  REQUIRE(run("{\"x\": 1, \"y\": 2, \"dx\": 0.5, \"dy\": -1}\n{\"dy\":1,\"dx\":1,\"y\":1,\"x\":1}", options) ==
+          "{\"x\":1.5,\"y\":1.0}\n{\"x\":2.0,\"y\":2.0}\n");
+
+  options.operation = point_stream::Operation::Arithmetic;
+  options.scalar = 2.5;
+  REQUIRE(run("{\"ax\":10,\"ay\":20,\"bx\":3,\"by\":7}\n", options) ==
+          "{\"add_x\":13.0,\"add_y\":27.0,\"sub_x\":7.0,\"sub_y\":13.0,\"mul_x\":25.0,\"mul_y\":50.0}\n");
+
+  // No NaN in JSON
+  options.operation = point_stream::Operation::Distance;
+  REQUIRE(run("{\"x1\":0,\"y1\":0,\"x2\":nan,\"y2\":0}\n", options) == "{\"distance\":null}\n");
+}
+
+TEST_CASE("point_stream: Binärformat & Puffergrenzen") {
+  // More records than fit into the reader and writer buffers at once
+  std::vector<double> input;
+  for (int i = 0; i < 10000; ++i) {
+    input.insert(input.end(), {0.0, 0.0, 3.0 * i, 4.0 * i});
+  }
+  const std::string bytes(reinterpret_cast<const char*>(input.data()), input.size() * sizeof(double));
+
+  point_stream::Options options;
+  options.input_format = point_stream::Format::Binary;
+  options.output_format = point_stream::Format::Binary;
+  const File in = temp_file(bytes);
+  const File out(std::tmpfile(), &std::fclose);
+  const auto stats = point_stream::process(in.get(), out.get(), options);
+  REQUIRE(stats.records == 10000);
+
+  const std::string result = read_all(out.get());
+  REQUIRE(result.size() == 10000 * sizeof(double));
+  std::vector<double> distances(10000);
+  std::memcpy(distances.data(), result.data(), result.size());
+  for (int i = 0; i < 10000; ++i) {
+    REQUIRE(distances[static_cast<std::size_t>(i)] == 5.0 * i);
+  }
+
+  // Lines longer than the buffer
+  const File long_line = temp_file(std::string(200, ' ') + "0,0,3,4\n1,1,1,1\n");
+  point_stream::RecordReader reader(long_line.get(), point_stream::Format::Csv, point_stream::Operation::Distance, 64);
+  double fields[point_stream::max_fields];
+  REQUIRE(reader.next(fields));
+  REQUIRE(fields[3] == 4.0);
+  REQUIRE(reader.next(fields));
+  REQUIRE(fields[0] == 1.0);
+  REQUIRE(!reader.next(fields));
+}
+
+TEST_CASE("point_stream: Fehler mit Zeilennummer") {
+  point_stream::Options options;
+  auto error = [&](const std::string& input) {
+    try {
+      run(input, options);
+    } catch (const std::runtime_error& e) {
+      return std::string(e.what());
+    }
+    return std::string("no error");
+  };
+  REQUIRE(error("0,0,3,4\n0,0,3\n") == "line 2: expected 4 comma separated values");
+  REQUIRE(error("0,0,3,4\n0,0,3,4,5\n") == "line 2: expected 4 comma separated values");
+  REQUIRE(error("0,0,3,4\n0,0,x,4\n") == "line 2: 'x' is not a number");
+
+  options.input_format = point_stream::Format::Ndjson;
+  REQUIRE(error("{\"x1\":0,\"y1\":0,\"x2\":3}\n") == "line 1: missing keys, expected x1, y1, x2, y2");
+  REQUIRE(error("{\"x1\":0,\"y1\":0,\"x2\":3,\"z\":4}\n") == "line 1: unexpected key \"z\"");
+  REQUIRE(error("{\"x1\":0,\"y1\":0,\"x2\":3,\"y2\":4}\n{\"x1\":0,\"y1\":0,\"x1\":3,\"y2\":4,\"x2\":1}\n") ==
+          "line 2: duplicate key \"x1\"");
+  REQUIRE(error("{\"x1\":0,\"y1\":0,\"x2\":3,\"y2\":\"4\"}\n") == "line 1: value of \"y2\" is not a number");
+
+  options.input_format = point_stream::Format::Binary;
+  REQUIRE(error(std::string(40, '\0')) == "record 2: truncated, 8 of 32 bytes");
+
+  REQUIRE_THROWS_AS(point_stream::parse_format("xml"), std::invalid_argument);
+  REQUIRE(point_stream::parse_operation("move") == point_stream::Operation::Move);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/json_writer.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+template <typename Emit>
+std::string render(int indent, Emit&& emit) {
+  fmt::memory_buffer buffer;
+  JsonWriter json(buffer, indent);
+  emit(json);
+  REQUIRE(json.depth() == 0);
+  return fmt::to_string(buffer);
+}
+
+}  // namespace
+
+TEST_CASE("JsonWriter: Zahlen wie nlohmann::json::dump") {
+  std::mt19937_64 gen(11);
+  std::uniform_real_distribution<double> coord(-1e6, 1e6);
+  fmt::memory_buffer buffer;
+  auto check = [&](double v) {
+    buffer.clear();
+    json_detail::append_double(buffer, v);
+    REQUIRE(fmt::to_string(buffer) == nlohmann::json(v).dump());
+  };
+  for (double v : {0.0, -0.0, 5.0, -2.5, 0.1, 1.0 / 3, 1e15, 1e16, 1e21, 1e-4, 1e-5, 0.00012, 5e-324,
+                   std::numeric_limits<double>::max(), std::numeric_limits<double>::quiet_NaN(),
+                   std::numeric_limits<double>::infinity()}) {
+    check(v);
+  }
+  for (int i = 0; i < 20000; ++i) {
+    check(coord(gen));
+    check(std::round(coord(gen)));
+    std::uint64_t bits = gen();
+    double any;
+    std::memcpy(&any, &bits, sizeof(any));
+    check(any);
+  }
+  REQUIRE(render(-1, [](JsonWriter& json) { json.value(0.1f); }) == nlohmann::json(0.1f).dump());
+}
+
+TEST_CASE("JsonWriter: Dokumente byte-gleich, kompakt & eingerückt") {
+  const Point<int> p{3, -4};
+  const Point<double> q{0.5, 25.0};
+  nlohmann::json expected;
+  expected["distance"] = 5.0;
+  expected["empty_array"] = nlohmann::json::array();
+  expected["empty_object"] = nlohmann::json::object();
+  expected["flags"] = {true, false, nullptr, -7, 18446744073709551615ull};
+  expected["name"] = "tab\t \"quoted\" \\ \x01 ü";
+  expected["point"] = {{"x", p.x}, {"y", p.y}};
+  expected["points"] = {{{"x", q.x}, {"y", q.y}}, {{"x", p.x}, {"y", p.y}}};
+
+  auto emit = [&](JsonWriter& json) {
+    json.begin_object();
+    json.field("distance", 5.0);
+    json.key("empty_array").begin_array().end_array();
+    json.key("empty_object").begin_object().end_object();
+    json.key("flags").begin_array().value(true).value(false).null().value(-7).value(18446744073709551615ull).end_array();
+    json.field("name", "tab\t \"quoted\" \\ \x01 ü");
+    json.field("point", p);
+    json.key("points").begin_array().value(q).value(p).end_array();
+    json.end_object();
+  };
+  REQUIRE(render(-1, emit) == expected.dump());
+  REQUIRE(render(2, emit) == expected.dump(2));
+  REQUIRE(render(4, emit) == expected.dump(4));
+  REQUIRE(render(0, emit) == expected.dump(0));
+}
+
+TEST_CASE("JsonWriter: UTF-8 wie nlohmann::json::dump") {
+  // Accepted and rejected by both: dump() throws type_error 316, the writer invalid_argument
+  const std::string valid[] = {"", "ascii", "\xC3\xBC", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF",
+                               "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF", "a\xC2\x80z"};
+  const std::string invalid[] = {"\x80", "\xC0\xAF", "\xC1\xBF", "\xC3", "\xC3(", "\xE0\x80\xAF", "\xE2\x82",
+                                 "\xED\xA0\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+                                 "\xFF", "ok\xE2\x82(x"};
+  fmt::memory_buffer buffer;
+  for (const std::string& s : valid) {
+    buffer.clear();
+    json_detail::append_string(buffer, s);
+    REQUIRE(fmt::to_string(buffer) == nlohmann::json(s).dump());
+  }
+  for (const std::string& s : invalid) {
+    REQUIRE_THROWS_AS(nlohmann::json(s).dump(), nlohmann::json::type_error);
+    REQUIRE_THROWS_AS(json_detail::append_string(buffer, s), std::invalid_argument);
+    REQUIRE_THROWS_AS(render(-1, [&](JsonWriter& json) { json.begin_object().key(s); }), std::invalid_argument);
+  }
+}
+
+TEST_CASE("JsonWriter: Point3/Point4 & Fehler") {
+  const Point4<int> p{1, 2, 3, 4};
+  nlohmann::json expected{{"x", 1}, {"y", 2}, {"z", 3}, {"w", 4}};
+  REQUIRE(render(2, [&](JsonWriter& json) { json.value(p); }) == expected.dump(2));
+  REQUIRE(render(-1, [](JsonWriter& json) { json.value(Point3<double>{1, 2, 3}); }) ==
+          R"({"x":1.0,"y":2.0,"z":3.0})");
+
+  fmt::memory_buffer buffer;
+  JsonWriter json(buffer);
+  REQUIRE_THROWS_AS(json.end_object(), std::logic_error);
+  for (std::size_t i = 0; i < JsonWriter::max_depth; ++i) json.begin_array();
+  REQUIRE_THROWS_AS(json.begin_array(), std::length_error);
+}
@@ -0,0 +1,260 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../include/point_dataset.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Path in the temp directory that is removed again at the end of the test
+class TempPath {
+public:
+  explicit TempPath(const std::string& name)
+      : m_path((std::filesystem::temp_directory_path() / ("exercise-006-" + name)).string()) {}
+  TempPath(const TempPath&) = delete;
+  TempPath& operator=(const TempPath&) = delete;
+  ~TempPath() { std::remove(m_path.c_str()); }
+
+  const std::string& str() const noexcept { return m_path; }
+
+private:
+  std::string m_path;
+};
+
+std::string read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::string& path, const std::string& content) {
+  std::ofstream(path, std::ios::binary) << content;
+}
+
+// Message of the exception thrown by fn, empty if it does not throw
+template <typename Fn>
+std::string error_of(Fn&& fn) {
+  try {
+    fn();
+  } catch (const std::exception& e) {
+    return e.what();
+  }
+  return {};
+}
+
+}  // namespace
+
+TEST_CASE("point_dataset: Interleaved Roundtrip ohne Kopie") {
+  const TempPath path("interleaved.pts");
+  std::vector<Point<int>> points;
+  for (int i = 0; i < 1000; ++i) points.push_back({i, -3 * i});
+  point_dataset::write(path.str(), points);
+
+  const point_dataset::Dataset data(path.str());
+  REQUIRE(data.size() == 1000);
+  REQUIRE(data.dimension() == 2);
+  REQUIRE(data.element_type() == point_dataset::ElementType::Int32);
+  REQUIRE(data.layout() == point_dataset::Layout::Interleaved);
+  REQUIRE(data.header().version == point_dataset::version);
+
+  const auto view = data.points<int>();
+  REQUIRE(view.size() == points.size());
+  REQUIRE(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(Point<int>) == 0);
+  REQUIRE(std::vector<Point<int>>(view.begin(), view.end()) == points);
+
+  // Header, padding up to the alignment, then exactly the packed points
+  REQUIRE(read_file(path.str()).size() == 64 + points.size() * sizeof(Point<int>));
+}
+
+TEST_CASE("point_dataset: Point3 wird ohne Padding gepackt") {
+  const TempPath path("point3.pts");
+  const TempPath again("point3-again.pts");
+  std::vector<Point3<double>> points{{1.0, 2.0, 3.0}, {-4.5, 0.25, 1e300}};
+  point_dataset::write(path.str(), points);
+
+  const point_dataset::Dataset data(path.str());
+  REQUIRE(data.header().stride == 3 * sizeof(double));
+  REQUIRE(read_file(path.str()).size() == 64 + 2 * 3 * sizeof(double));
+  const auto coords = data.coordinates<double>();
+  REQUIRE(std::vector<double>(coords.begin(), coords.end()) == std::vector<double>{1.0, 2.0, 3.0, -4.5, 0.25, 1e300});
+  // Point3<double> is 32 bytes in memory, so there is no zero-copy Point view
+  REQUIRE_THROWS_AS((data.points<double, 3>()), std::invalid_argument);
+
+  // Byte for byte the same file, whatever the padding of the source points held
+  std::vector<unsigned char> garbage(points.size() * sizeof(Point3<double>), 0xAB);
+  std::memcpy(static_cast<void*>(points.data()), garbage.data(), garbage.size());
+  points[0] = {1.0, 2.0, 3.0};
+  points[1] = {-4.5, 0.25, 1e300};
+  point_dataset::write(again.str(), points);
+  REQUIRE(read_file(again.str()) == read_file(path.str()));
+}
+
+TEST_CASE("point_dataset: Spalten aus PointCloud & vector") {
+  const TempPath path("columns.pts");
+  PointCloud<float> cloud;
+  for (int i = 0; i < 37; ++i) cloud.push_back({static_cast<float>(i) * 0.5f, static_cast<float>(-i)});
+  point_dataset::write(path.str(), cloud);
+
+  const point_dataset::Dataset data(path.str());
+  REQUIRE(data.layout() == point_dataset::Layout::Columns);
+  const auto xs = data.column<float>(0);
+  const auto ys = data.column<float>(1);
+  REQUIRE(xs.size() == 37);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(xs.data()) % 64 == 0);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(ys.data()) % 64 == 0);
+  for (std::size_t i = 0; i < cloud.size(); ++i) {
+    REQUIRE(xs[i] == cloud.xs()[i]);
+    REQUIRE(ys[i] == cloud.ys()[i]);
+  }
+  REQUIRE_THROWS_AS(data.column<float>(2), std::out_of_range);
+  REQUIRE_THROWS_AS(data.points<float>(), std::invalid_argument);
+
+  // The same columns from points, with three dimensions
+  const TempPath path3("columns3.pts");
+  const std::vector<Point3<std::int64_t>> points{{1, 2, 3}, {4, 5, 6}};
+  point_dataset::write(path3.str(), points, point_dataset::Layout::Columns, 16);
+  const point_dataset::Dataset data3(path3.str());
+  REQUIRE(data3.header().alignment == 16);
+  REQUIRE(data3.column<std::int64_t>(2)[1] == 6);
+  REQUIRE(data3.column<std::int64_t>(0)[1] == 4);
+}
+
+TEST_CASE("point_dataset: Writer streamt & Leere Datei") {
+  const TempPath path("stream.pts");
+  {
+    point_dataset::Writer<double> writer(path.str());
+    for (int i = 0; i < 5; ++i) writer.write({i * 1.5, 0.0});
+    REQUIRE(writer.size() == 5);
+    writer.close();
+  }
+  const point_dataset::Dataset data(path.str());
+  REQUIRE(data.size() == 5);
+  REQUIRE(data.points<double>()[4] == Point<double>{6.0, 0.0});
+
+  const TempPath empty("empty.pts");
+  point_dataset::write(empty.str(), std::vector<Point<double>>{});
+  REQUIRE(point_dataset::Dataset(empty.str()).points<double>().empty());
+}
+
+TEST_CASE("point_dataset: Ungültige Dateien & falsche Typen") {
+  const TempPath path("invalid.pts");
+  point_dataset::write(path.str(), std::vector<Point<double>>{{1.0, 2.0}, {3.0, 4.0}});
+  const std::string valid = read_file(path.str());
+
+  REQUIRE_THROWS_AS(point_dataset::Dataset(path.str() + ".missing"), std::runtime_error);
+
+  const point_dataset::Dataset data(path.str());
+  REQUIRE_THROWS_AS(data.points<float>(), std::invalid_argument);
+  REQUIRE_THROWS_AS((data.points<double, 3>()), std::invalid_argument);
+  REQUIRE_THROWS_AS(data.column<double>(0), std::invalid_argument);
+
+  auto rejects = [&](std::string content, const std::string& message) {
+    write_file(path.str(), content);
+    REQUIRE(error_of([&] { point_dataset::Dataset{path.str()}; }).find(message) != std::string::npos);
+  };
+  rejects(valid.substr(0, valid.size() - 1), "truncated");
+  rejects(valid.substr(0, 10), "too small");
+  rejects("X" + valid.substr(1), "bad magic");
+
+  std::string swapped = valid;
+  std::swap(swapped[8], swapped[11]);
+  std::swap(swapped[9], swapped[10]);
+  rejects(swapped, "other byte order");
+
+  std::string newer = valid;
+  newer[12] = 2;
+  rejects(newer, "unsupported version");
+
+  // Misaligned coordinates: alignment 1 with an odd data offset, record stride or column stride
+  auto with_header = [&](const std::string& content, auto&& change) {
+    point_dataset::Header header;
+    std::memcpy(&header, content.data(), sizeof(header));
+    change(header);
+    std::string result = content;
+    std::memcpy(&result[0], &header, sizeof(header));
+    return result;
+  };
+  const std::string shifted = valid.substr(0, 64) + '\0' + valid.substr(64);
+  rejects(with_header(shifted, [](point_dataset::Header& h) {
+            h.alignment = 1;
+            h.data_offset = 65;
+          }),
+          "alignment is smaller than an element");
+  rejects(with_header(shifted, [](point_dataset::Header& h) { h.data_offset = 65; }), "bad data offset");
+  rejects(with_header(valid + std::string(8, '\0'), [](point_dataset::Header& h) { h.stride = 17; }),
+          "stride is not a multiple of the element size");
+  const std::vector<Point<double>> one{{1.0, 2.0}};
+  REQUIRE_THROWS_AS(point_dataset::write(path.str(), one, point_dataset::Layout::Columns, 4), std::invalid_argument);
+
+  // A huge count must not overflow the size check
+  std::string huge = valid;
+  for (int i = 24; i < 32; ++i) huge[i] = '\xff';
+  rejects(huge, "truncated");
+}
+
+TEST_CASE("point_dataset: JSON der CLI konvertieren") {
+  const TempPath path("converted.pts");
+
+  // The demo, arithmetic and move documents, concatenated
+  std::istringstream json(R"({
+  "operations": {"difference": {"x": 3, "y": 4}, "distance": 5.0, "sum": {"x": 3, "y": 4}},
+  "points": [{"name": "origin", "x": 0, "y": 0}, {"name": "target", "x": 3, "y": 4}]
+}
+{"addition":{"x":13,"y":27},"pointA":{"x":10,"y":20},"pointB":{"x":3,"y":7},
+ "scalar_multiplication":{"result":{"x":25.0,"y":50.0},"scalar":2.5},"subtraction":{"x":7,"y":13}}
+{"delta":{"dx":1,"dy":1},"initial":{"x":0,"y":0},"result":{"x":1,"y":1}})");
+  point_dataset::ConvertOptions options;
+  options.type = point_dataset::ElementType::Int32;
+  REQUIRE(point_dataset::convert_json(json, path.str(), options) == 11);
+
+  const point_dataset::Dataset data(path.str());
+  const auto points = data.points<int>();
+  const std::vector<Point<int>> expected{{3, 4}, {3, 4}, {0, 0}, {3, 4},  {13, 27}, {10, 20},
+                                         {3, 7}, {25, 50}, {7, 13}, {0, 0}, {1, 1}};
+  REQUIRE(std::vector<Point<int>>(points.begin(), points.end()) == expected);
+
+  // NDJSON from batch move, into columns
+  const TempPath path2("converted-columns.pts");
+  std::istringstream ndjson("{\"x\":1.5,\"y\":1.0}\n{\"y\":2.0,\"x\":-2.0}\n\n");
+  options.type = point_dataset::ElementType::Float64;
+  options.layout = point_dataset::Layout::Columns;
+  REQUIRE(point_dataset::convert_json(ndjson, path2.str(), options) == 2);
+  const point_dataset::Dataset columns(path2.str());
+  REQUIRE(columns.column<double>(0)[1] == -2.0);
+  REQUIRE(columns.column<double>(1)[0] == 1.0);
+
+  // Three dimensions need z as well
+  const TempPath path3("converted-3d.pts");
+  std::istringstream three("[{\"x\":1,\"y\":2,\"z\":3},{\"x\":4,\"y\":5}]");
+  options.dimension = 3;
+  options.layout = point_dataset::Layout::Interleaved;
+  REQUIRE(point_dataset::convert_json(three, path3.str(), options) == 1);
+  const point_dataset::Dataset data3(path3.str());
+  const auto coords = data3.coordinates<double>();
+  REQUIRE(std::vector<double>(coords.begin(), coords.end()) == std::vector<double>{1.0, 2.0, 3.0});
+}
+
+TEST_CASE("point_dataset: Konvertierungsfehler") {
+  const TempPath path("convert-errors.pts");
+  point_dataset::ConvertOptions options;
+  options.type = point_dataset::ElementType::Int32;
+
+  std::istringstream fraction("{\"x\": 1.5, \"y\": 2}");
+  REQUIRE(error_of([&] { point_dataset::convert_json(fraction, path.str(), options); }).find("does not fit int32") !=
+          std::string::npos);
+  std::istringstream large("{\"x\": 3000000000, \"y\": 2}");
+  REQUIRE(error_of([&] { point_dataset::convert_json(large, path.str(), options); }).find("does not fit int32") !=
+          std::string::npos);
+  std::istringstream broken("{\"x\": 1, \"y\": }");
+  REQUIRE(error_of([&] { point_dataset::convert_json(broken, path.str(), options); }).find("invalid JSON") !=
+          std::string::npos);
+
+  REQUIRE(point_dataset::parse_element_type("float32") == point_dataset::ElementType::Float32);
+  REQUIRE_THROWS_AS(point_dataset::parse_element_type("int8"), std::invalid_argument);
+  REQUIRE(point_dataset::parse_layout("columns") == point_dataset::Layout::Columns);
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include "../include/particle_simulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Positions in [-1000, 1000] and velocities in [-20, 20]; fractions for float and double
+template <typename T>
+PointCloud<T> random_cloud(std::size_t n, int range, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> coord(-range * 8, range * 8);
+  PointCloud<T> cloud;
+  const T scale = std::is_integral<T>::value ? T(8) : T(8.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    cloud.push_back({static_cast<T>(coord(gen)) / scale, static_cast<T>(coord(gen)) / scale});
+  }
+  return cloud;
+}
+
+// One step at a time with Point::move and the scalar rule of the boundary
+template <typename T>
+std::vector<Point<T>> reference(const PointCloud<T>& positions, const PointCloud<T>& velocities,
+                                const SimulationOptions<T>& options, std::size_t steps) {
+  std::vector<Point<T>> points = positions.to_points();
+  for (std::size_t s = 0; s < steps; ++s) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      points[i].move(velocities[i].x, velocities[i].y);
+      for (std::size_t d = 0; d < 2; ++d) {
+        T& c = points[i][d];
+        const T lo = options.min[d];
+        const T hi = options.max[d];
+        if (options.boundary == Boundary::Clamp) {
+          c = std::min(std::max(c, lo), hi);
+        } else if (options.boundary == Boundary::Wrap) {
+          if constexpr (std::is_integral<T>::value) {
+            const std::int64_t width = std::int64_t{hi} - lo;
+            c = static_cast<T>(lo + ((c - std::int64_t{lo}) % width + width) % width);
+          } else {
+            c = lo + (c - lo) - std::floor((c - lo) / (hi - lo)) * (hi - lo);
+            if (c >= hi) c = lo;
+          }
+        }
+      }
+    }
+  }
+  return points;
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("ParticleSimulation<T>: gleiche Schritte wie Point::move", "", int, float, double) {
+  const auto positions = random_cloud<TestType>(1237, 1000, 1);
+  const auto velocities = random_cloud<TestType>(1237, 20, 2);
+
+  for (Boundary boundary : {Boundary::None, Boundary::Wrap, Boundary::Clamp}) {
+    SimulationOptions<TestType> options;
+    options.boundary = boundary;
+    options.min = {TestType(-500), TestType(-250)};
+    options.max = {TestType(500), TestType(750)};
+    options.chunk_size = 100;
+    options.steps_per_pass = 7;
+    const auto expected = reference(positions, velocities, options, 50);
+
+    for (auto isa : {cloud_simd::Isa::Scalar, cloud_simd::Isa::AVX2}) {
+      cloud_simd::force_isa(isa);
+      ParticleSimulation<TestType> sim(positions, velocities, options);
+      const auto stats = sim.run(50);
+      REQUIRE(stats.steps == 50);
+      REQUIRE(stats.points == 1237);
+      REQUIRE(sim.step_count() == 50);
+      const auto actual = sim.positions().to_points();
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+        if constexpr (std::is_integral<TestType>::value) {
+          REQUIRE(actual[i] == expected[i]);
+        } else {
+          // Both are within one rounding of the exact remainder
+          REQUIRE(std::fabs(actual[i].x - expected[i].x) <= 1e-3);
+          REQUIRE(std::fabs(actual[i].y - expected[i].y) <= 1e-3);
+        }
+        if (boundary != Boundary::None) {
+          REQUIRE(actual[i].x >= options.min.x);
+          REQUIRE(actual[i].y <= options.max.y);
+        }
+        if (boundary == Boundary::Wrap) {
+          REQUIRE(actual[i].x < options.max.x);
+        }
+      }
+    }
+    cloud_simd::force_isa(cloud_simd::detected_isa());
+  }
+}
+
+TEMPLATE_TEST_CASE("cloud_simd: add, clamp & wrap für alle Befehlssätze gleich", "", int, float, double) {
+  // Mostly just outside the box, some far away
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> near(-120.0, 120.0);
+  std::uniform_real_distribution<double> far(-1e7, 1e7);
+  std::vector<TestType> values(1003);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<TestType>(i % 10 == 0 ? far(gen) : near(gen));
+  }
+  const TestType lo = TestType(-100);
+  const TestType hi = TestType(100);
+
+  std::vector<std::vector<TestType>> results;
+  for (auto isa : {cloud_simd::Isa::Scalar, cloud_simd::Isa::AVX2}) {
+    cloud_simd::force_isa(isa);
+    std::vector<TestType> sum(values.size()), clamped = values, wrapped = values;
+    cloud_simd::add(values.data(), values.data(), values.size(), sum.data());
+    cloud_simd::clamp(clamped.data(), clamped.size(), lo, hi);
+    cloud_simd::wrap(wrapped.data(), wrapped.size(), lo, hi);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      REQUIRE(clamped[i] == std::min(std::max(values[i], lo), hi));
+      REQUIRE(wrapped[i] >= lo);
+      REQUIRE(wrapped[i] < hi);
+    }
+    results.push_back(sum);
+    results.push_back(clamped);
+    results.push_back(wrapped);
+  }
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+  REQUIRE(results[0] == results[3]);
+  REQUIRE(results[1] == results[4]);
+  REQUIRE(results[2] == results[5]);
+}
+
+TEST_CASE("ParticleSimulation<T>: Passgröße & Snapshots ändern nichts") {
+  const auto positions = random_cloud<double>(5000, 1000, 3);
+  const auto velocities = random_cloud<double>(5000, 20, 4);
+  SimulationOptions<double> options;
+  options.boundary = Boundary::Wrap;
+  options.min = {-1000.0, -1000.0};
+  options.max = {1000.0, 1000.0};
+
+  ParticleSimulation<double> blocked(positions, velocities, options);
+  std::vector<std::size_t> snapshot_steps;
+  std::vector<Point<double>> at_30;
+  blocked.run(
+    100,
+    [&](std::size_t step, const PointCloud<double>& p) {
+      snapshot_steps.push_back(step);
+      if (step == 30) at_30 = p.to_points();
+    },
+    15);
+  REQUIRE(snapshot_steps == std::vector<std::size_t>{15, 30, 45, 60, 75, 90});
+
+  options.steps_per_pass = 1;
+  options.chunk_size = 1;
+  ThreadPool pool(3);
+  options.pool = &pool;
+  ParticleSimulation<double> single(positions, velocities, options);
+  for (int s = 0; s < 30; ++s) single.step();
+  REQUIRE(single.positions().to_points() == at_30);
+  single.run(70);
+  REQUIRE(single.positions().to_points() == blocked.positions().to_points());
+  REQUIRE(single.velocities().to_points() == velocities.to_points());
+}
+
+TEST_CASE("ParticleSimulation<T>: Randfälle & ungültige Optionen") {
+  // int overflow wraps around, like the kernels and two's complement
+  PointCloud<int> positions{{std::numeric_limits<int>::max(), 0}};
+  PointCloud<int> velocities{{1, -1}};
+  ParticleSimulation<int> sim(positions, velocities);
+  sim.step();
+  REQUIRE(sim.positions()[0] == Point<int>{std::numeric_limits<int>::min(), -1});
+
+  // Points far outside the box are wrapped back in, whatever the distance
+  SimulationOptions<int> wrap;
+  wrap.boundary = Boundary::Wrap;
+  wrap.min = {0, 0};
+  wrap.max = {10, 10};
+  ParticleSimulation<int> far(PointCloud<int>{{-1000003, 1000003}}, PointCloud<int>{{0, 0}}, wrap);
+  far.step();
+  REQUIRE(far.positions()[0] == Point<int>{7, 3});
+
+  ParticleSimulation<double> empty(PointCloud<double>{}, PointCloud<double>{});
+  REQUIRE(empty.run(10).steps_per_second() >= 0.0);
+
+  REQUIRE_THROWS_AS(ParticleSimulation<int>(PointCloud<int>(3), PointCloud<int>(2)), std::invalid_argument);
+  wrap.max = {10, 0};
+  REQUIRE_THROWS_AS(ParticleSimulation<int>(PointCloud<int>(1), PointCloud<int>(1), wrap), std::invalid_argument);
+  SimulationOptions<int> clamp;
+  clamp.boundary = Boundary::Clamp;
+  REQUIRE_NOTHROW(ParticleSimulation<int>(PointCloud<int>(1), PointCloud<int>(1), clamp));
+  clamp.chunk_size = 0;
+  REQUIRE_THROWS_AS(ParticleSimulation<int>(PointCloud<int>(1), PointCloud<int>(1), clamp), std::invalid_argument);
+}
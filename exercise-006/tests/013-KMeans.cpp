@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include "../include/kmeans.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Gaussian blobs around the given centers, shuffled
+template <typename T>
+PointCloud<T> blobs(const std::vector<Point<double>>& centers, std::size_t per_blob, double sigma, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<double> noise(0.0, sigma);
+  std::vector<Point<T>> points;
+  for (std::size_t i = 0; i < per_blob; ++i) {
+    for (const auto& c : centers) {
+      points.push_back({static_cast<T>(std::round(c.x + noise(gen))), static_cast<T>(std::round(c.y + noise(gen)))});
+    }
+  }
+  std::shuffle(points.begin(), points.end(), gen);
+  return PointCloud<T>(points.begin(), points.end());
+}
+
+const std::vector<Point<double>> blob_centers{{0, 0}, {1000, 0}, {0, 1000}, {1000, 1000}, {500, 2000}};
+
+// Index of the center closest to p
+std::size_t closest(const std::vector<Point<double>>& centers, const Point<double>& p) {
+  std::size_t best = 0;
+  for (std::size_t j = 1; j < centers.size(); ++j) {
+    if (centers[j].distance_to(p) < centers[best].distance_to(p)) best = j;
+  }
+  return best;
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("cloud_simd::nearest_center wie Brute Force", "", int, float, double) {
+  const auto cloud = blobs<TestType>(blob_centers, 203, 300.0, 1);
+  const std::vector<double> cx{0, 1000, 0, 1000, 500, 500};
+  const std::vector<double> cy{0, 0, 1000, 1000, 2000, 2000};  // the last center duplicates the fifth
+
+  std::vector<std::vector<std::uint32_t>> labels;
+  std::vector<std::vector<double>> squared;
+  for (auto isa : {cloud_simd::Isa::Scalar, cloud_simd::Isa::AVX2}) {
+    cloud_simd::force_isa(isa);
+    labels.emplace_back(cloud.size());
+    squared.emplace_back(cloud.size());
+    cloud_simd::nearest_center(cloud.xs(), cloud.ys(), cloud.size(), cx.data(), cy.data(), cx.size(),
+                               labels.back().data(), squared.back().data());
+  }
+  cloud_simd::force_isa(cloud_simd::detected_isa());
+  REQUIRE(labels[0] == labels[1]);
+  REQUIRE(squared[0] == squared[1]);
+
+  for (std::size_t i = 0; i < cloud.size(); ++i) {
+    const auto x = static_cast<double>(cloud.xs()[i]);
+    const auto y = static_cast<double>(cloud.ys()[i]);
+    double best = 1e300;
+    for (std::size_t j = 0; j < cx.size(); ++j) best = std::min(best, (x - cx[j]) * (x - cx[j]) + (y - cy[j]) * (y - cy[j]));
+    REQUIRE(squared[0][i] == best);
+    REQUIRE(labels[0][i] != 5);  // ties go to the lower index
+  }
+}
+
+TEMPLATE_TEST_CASE("kmeans: findet getrennte Cluster", "", int, float, double) {
+  const auto cloud = blobs<TestType>(blob_centers, 2000, 40.0, 2);
+  KMeansOptions options;
+  options.k = 5;
+  options.chunk_size = 777;
+  const KMeansResult result = kmeans(cloud, options);
+
+  REQUIRE(result.converged);
+  REQUIRE(result.centers.size() == 5);
+  REQUIRE(result.labels.size() == cloud.size());
+  REQUIRE(result.init_seconds <= result.seconds);
+
+  // Every blob is found once, and every point carries the label of its blob
+  std::vector<std::size_t> blob_of(5);
+  for (std::size_t j = 0; j < 5; ++j) {
+    blob_of[j] = closest(blob_centers, result.centers[j]);
+    REQUIRE(result.centers[j].distance_to(blob_centers[blob_of[j]]) < 5.0);
+    REQUIRE(result.sizes[j] == 2000);
+  }
+  REQUIRE(std::is_permutation(blob_of.begin(), blob_of.end(), std::vector<std::size_t>{0, 1, 2, 3, 4}.begin()));
+
+  double inertia = 0.0;
+  for (std::size_t i = 0; i < cloud.size(); ++i) {
+    const Point<double> p{static_cast<double>(cloud.xs()[i]), static_cast<double>(cloud.ys()[i])};
+    REQUIRE(result.labels[i] == closest(result.centers, p));
+    const double d = p.distance_to(result.centers[result.labels[i]]);
+    inertia += d * d;
+  }
+  REQUIRE(std::fabs(result.inertia - inertia) <= 1e-9 * inertia);
+}
+
+TEST_CASE("kmeans: unabhängig von der Threadzahl & Mini-Batch") {
+  const auto cloud = blobs<double>(blob_centers, 3000, 120.0, 3);
+  KMeansOptions options;
+  options.k = 5;
+  options.chunk_size = 1000;
+
+  ThreadPool one(1);
+  ThreadPool four(4);
+  options.pool = &one;
+  const KMeansResult a = kmeans(cloud, options);
+  options.pool = &four;
+  const KMeansResult b = kmeans(cloud, options);
+  REQUIRE(a.centers == b.centers);
+  REQUIRE(a.labels == b.labels);
+  REQUIRE(a.iterations == b.iterations);
+
+  // Mini-batch ends close to the full solution, with far fewer points per iteration
+  options.batch_size = 1024;
+  options.max_iterations = 200;
+  options.tolerance = 0.01;
+  const KMeansResult mini = kmeans(cloud, options);
+  REQUIRE(mini.labels.size() == cloud.size());
+  for (const auto& center : mini.centers) {
+    REQUIRE(center.distance_to(a.centers[closest(a.centers, center)]) < 20.0);
+  }
+  REQUIRE(mini.inertia < 1.05 * a.inertia);
+}
+
+TEST_CASE("kmeans: Randfälle & ungültige Optionen") {
+  // k == n: every point is its own center
+  const std::vector<Point<int>> points{{0, 0}, {5, 5}, {10, 0}, {5, 5}};
+  KMeansOptions options;
+  options.k = 3;
+  const KMeansResult result = kmeans(points, options);
+  REQUIRE(result.inertia == 0.0);
+  std::vector<std::size_t> sizes = result.sizes;
+  std::sort(sizes.begin(), sizes.end());
+  REQUIRE(sizes == std::vector<std::size_t>{1, 1, 2});
+
+  options.k = 1;
+  const KMeansResult one = kmeans(points, options);
+  REQUIRE(one.centers[0] == Point<double>{5.0, 2.5});
+
+  options.k = 5;
+  REQUIRE_THROWS_AS(kmeans(points, options), std::invalid_argument);
+  options.k = 0;
+  REQUIRE_THROWS_AS(kmeans(points, options), std::invalid_argument);
+  options.k = 2;
+  options.chunk_size = 0;
+  REQUIRE_THROWS_AS(kmeans(points, options), std::invalid_argument);
+}
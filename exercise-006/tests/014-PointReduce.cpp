@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include "../include/point_reduce.hpp"
+#include "test_points.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Smallest distance of all pairs, the slow way
+template <typename T>
+double brute_force_closest(const std::vector<Point<T>>& points) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = i + 1; j < points.size(); ++j) {
+      const double dx = static_cast<double>(points[i].x) - static_cast<double>(points[j].x);
+      const double dy = static_cast<double>(points[i].y) - static_cast<double>(points[j].y);
+      best = std::min(best, std::sqrt(dx * dx + dy * dy));
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("centroid, bounding_box & farthest_point wie serielle Schleifen", "", int, float, double) {
+  const auto points = random_points<TestType>(10007, 1, 1000);
+  const PointCloud<TestType> cloud(points.begin(), points.end());
+  ThreadPool pool(3);
+  ReduceOptions options;
+  options.chunk_size = 100;
+  options.pool = &pool;
+
+  long double sx = 0, sy = 0;
+  Point<TestType> lo = points[0], hi = points[0];
+  for (const auto& p : points) {
+    sx += p.x;
+    sy += p.y;
+    lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+    hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+  }
+  const Point<double> center = centroid(points.begin(), points.end(), options);
+  REQUIRE(std::fabs(center.x - static_cast<double>(sx / points.size())) <= 1e-12);
+  REQUIRE(std::fabs(center.y - static_cast<double>(sy / points.size())) <= 1e-12);
+  REQUIRE(centroid(cloud, options) == center);
+
+  const auto box = bounding_box(points.begin(), points.end(), options);
+  REQUIRE(box.min == lo);
+  REQUIRE(box.max == hi);
+  REQUIRE(bounding_box(cloud).min == box.min);
+  REQUIRE(bounding_box(cloud).max == box.max);
+  REQUIRE(std::all_of(points.begin(), points.end(), [&](const auto& p) { return box.contains(p); }));
+
+  const Point<double> from{3000.0, -2000.0};
+  const FarthestPoint far = farthest_point(points.begin(), points.end(), from, options);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const Point<double> p{static_cast<double>(points[i].x), static_cast<double>(points[i].y)};
+    REQUIRE(p.distance_to(from) <= far.distance);
+  }
+  const Point<double> p{static_cast<double>(points[far.index].x), static_cast<double>(points[far.index].y)};
+  REQUIRE(p.distance_to(from) == far.distance);
+  REQUIRE(farthest_point(cloud, from).index == far.index);
+}
+
+TEST_CASE("centroid: Point<int> läuft nicht über, Ergebnis unabhängig von der Threadzahl") {
+  // Any int sum of these overflows after two points
+  constexpr int max = std::numeric_limits<int>::max();
+  constexpr int min = std::numeric_limits<int>::min();
+  std::vector<Point<int>> points(100000, Point<int>{max, min});
+  points.back() = {max - 1, min + 3};
+  const Point<double> center = centroid(points.begin(), points.end());
+  REQUIRE(std::fabs(center.x - (max - 1e-5)) <= 1e-6);
+  REQUIRE(std::fabs(center.y - (min + 3e-5)) <= 1e-6);
+
+  // Compensated double sums: the ones survive next to 1e16, a plain sum loses all of them
+  std::vector<Point<double>> doubles;
+  for (int i = 0; i < 300; ++i) {
+    for (double x : {1e16, 1.0, -1e16}) doubles.push_back({x, 1.0});
+  }
+  REQUIRE(centroid(doubles.begin(), doubles.end()) == Point<double>{1.0 / 3.0, 1.0});
+
+  const auto random = random_points<double>(50000, 2, 1000000);
+  ThreadPool one(1);
+  ThreadPool four(4);
+  ReduceOptions options;
+  options.chunk_size = 333;
+  options.pool = &one;
+  const auto a = centroid(random.begin(), random.end(), options);
+  options.pool = &four;
+  REQUIRE(centroid(random.begin(), random.end(), options) == a);
+}
+
+TEMPLATE_TEST_CASE("closest_pair wie Brute Force", "", int, float, double) {
+  ThreadPool pool(4);
+  ReduceOptions options;
+  options.chunk_size = 64;
+  options.pool = &pool;
+
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    const auto points = random_points<TestType>(1500 + seed * 37, seed, 100000);
+    const ClosestPair pair = closest_pair(points.begin(), points.end(), options);
+    REQUIRE(pair.first < pair.second);
+    REQUIRE(pair.distance == brute_force_closest(points));
+    REQUIRE(std::fabs(pair.distance - points[pair.first].distance_to(points[pair.second])) <= 1e-9 * pair.distance);
+
+    const PointCloud<TestType> cloud(points.begin(), points.end());
+    const ClosestPair serial = closest_pair(cloud);
+    REQUIRE(serial.distance == pair.distance);
+  }
+
+  // Many duplicates on a small grid, and everything on one vertical line
+  const auto grid = random_points<TestType>(3000, 9, 20);
+  REQUIRE(closest_pair(grid.begin(), grid.end(), options).distance == 0.0);
+  std::vector<Point<TestType>> line;
+  for (int i = 0; i < 1000; ++i) line.push_back({TestType(7), static_cast<TestType>(i * i % 10007)});
+  REQUIRE(closest_pair(line.begin(), line.end(), options).distance == brute_force_closest(line));
+}
+
+TEST_CASE("Reduktionen: Randfälle") {
+  const std::vector<Point<int>> none;
+  REQUIRE_THROWS_AS(centroid(none.begin(), none.end()), std::invalid_argument);
+  REQUIRE_THROWS_AS(bounding_box(none.begin(), none.end()), std::invalid_argument);
+  REQUIRE_THROWS_AS(farthest_point(none.begin(), none.end(), {0.0, 0.0}), std::invalid_argument);
+
+  const std::vector<Point<int>> one{{4, -2}};
+  REQUIRE(centroid(one.begin(), one.end()) == Point<double>{4.0, -2.0});
+  REQUIRE(bounding_box(one.begin(), one.end()).min == Point<int>{4, -2});
+  REQUIRE_THROWS_AS(closest_pair(one.begin(), one.end()), std::invalid_argument);
+
+  // Ties go to the lowest index
+  const std::vector<Point<int>> ring{{0, 5}, {5, 0}, {0, -5}, {-5, 0}};
+  const FarthestPoint far = farthest_point(ring.begin(), ring.end(), {0.0, 0.0});
+  REQUIRE(far.index == 0);
+  REQUIRE(far.distance == 5.0);
+
+  const std::vector<Point<int>> two{{0, 0}, {3, 4}};
+  const ClosestPair pair = closest_pair(two.begin(), two.end());
+  REQUIRE(pair.first == 0);
+  REQUIRE(pair.second == 1);
+  REQUIRE(pair.distance == 5.0);
+}
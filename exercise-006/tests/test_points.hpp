@@ -0,0 +1,23 @@
+// test_points.hpp
+#pragma once
+
+#include "../include/point.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Reproducible points with integer coordinates in [-range, range]
+template <typename T>
+std::vector<Point<T>> random_points(std::size_t n, unsigned seed, int range) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> coord(-range, range);
+  std::vector<Point<T>> points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const T x = static_cast<T>(coord(gen));  // x is drawn first, whatever the argument order
+    const T y = static_cast<T>(coord(gen));
+    points.emplace_back(x, y);
+  }
+  return points;
+}
@@ -0,0 +1,215 @@
+#include "arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace {
+
+// Resource that forwards to the global aligned operator new / delete
+class NewDeleteResource : public MemoryResource {
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept override {
+        ::operator delete(ptr, bytes, std::align_val_t(alignment));
+    }
+};
+
+// Rounds ptr up to the next multiple of alignment (a power of two)
+unsigned char* align_up(unsigned char* ptr, std::size_t alignment) noexcept {
+    const auto value = reinterpret_cast<std::uintptr_t>(ptr);
+    return reinterpret_cast<unsigned char*>((value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+}
+
+} // namespace
+
+MemoryResource* new_delete_resource() noexcept {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+// ---------------------------------------------------------------------------
+// MonotonicArena
+// ---------------------------------------------------------------------------
+
+MonotonicArena::MonotonicArena(std::size_t initial_chunk_size, MemoryResource* upstream) noexcept
+    : m_upstream(upstream), m_next_chunk_size(std::max<std::size_t>(initial_chunk_size, 64))
+{
+}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void MonotonicArena::release() noexcept {
+    while (m_chunks) {
+        Chunk* next = m_chunks->next;
+        m_upstream->deallocate(m_chunks, sizeof(Chunk) + m_chunks->size, alignof(std::max_align_t));
+        m_chunks = next;
+    }
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_stats.bytes_reserved = 0;
+    m_stats.bytes_used = 0;
+    m_stats.bytes_live = 0;
+}
+
+// Bump allocation: align the cursor and advance it, a new chunk is only needed when the current one is full
+void* MonotonicArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    unsigned char* ptr = m_cursor ? align_up(m_cursor, alignment) : nullptr;
+    if (!ptr || ptr + bytes > m_end) {
+        add_chunk(bytes, alignment);
+        ptr = align_up(m_cursor, alignment);
+    }
+    m_stats.bytes_used += static_cast<std::size_t>(ptr + bytes - m_cursor);
+    m_stats.bytes_live += bytes;
+    m_stats.high_water_mark = std::max(m_stats.high_water_mark, m_stats.bytes_used);
+    ++m_stats.allocations;
+    m_cursor = ptr + bytes;
+    return ptr;
+}
+
+// Memory is reclaimed in release(); only the most recent block can be rewound
+void MonotonicArena::do_deallocate(void* ptr, std::size_t bytes, std::size_t /*alignment*/) noexcept {
+    m_stats.bytes_live -= bytes;
+    if (static_cast<unsigned char*>(ptr) + bytes == m_cursor) {
+        m_cursor = static_cast<unsigned char*>(ptr);
+        m_stats.bytes_used -= bytes;
+    }
+}
+
+// Chunks grow geometrically so that the number of upstream calls stays logarithmic
+void MonotonicArena::add_chunk(std::size_t bytes, std::size_t alignment) {
+    const std::size_t size = std::max(m_next_chunk_size, bytes + alignment);
+    void* raw = m_upstream->allocate(sizeof(Chunk) + size, alignof(std::max_align_t));
+    Chunk* chunk = ::new (raw) Chunk{m_chunks, size};
+    if (m_cursor) {
+        m_stats.bytes_used += static_cast<std::size_t>(m_end - m_cursor); // the rest of the old chunk is lost
+    }
+    m_chunks = chunk;
+    m_cursor = reinterpret_cast<unsigned char*>(chunk + 1);
+    m_end = m_cursor + size;
+    m_next_chunk_size = size * 2;
+    m_stats.bytes_reserved += size;
+    ++m_stats.upstream_allocations;
+}
+
+// ---------------------------------------------------------------------------
+// PoolResource
+// ---------------------------------------------------------------------------
+
+PoolResource::PoolResource(MemoryResource* upstream, std::size_t slab_size) noexcept
+    : m_upstream(upstream), m_slab_size(std::max(slab_size, 2 * max_block_size))
+{
+}
+
+PoolResource::~PoolResource() {
+    release();
+}
+
+// Large blocks are freed one by one with their share of the stats, what remains belongs to the slabs
+void PoolResource::release() noexcept {
+    while (m_large) {
+        free_large(m_large);
+    }
+    while (m_slabs) {
+        Slab* next = m_slabs->next;
+        m_stats.bytes_reserved -= m_slabs->size;
+        m_upstream->deallocate(m_slabs, m_slabs->size, alignof(std::max_align_t));
+        m_slabs = next;
+    }
+    m_free.fill(nullptr);
+    m_stats.bytes_used = 0;
+    m_stats.bytes_live = 0;
+}
+
+std::size_t PoolResource::size_class(std::size_t bytes) noexcept {
+    std::size_t index = 0;
+    for (std::size_t block = min_block_size; block < bytes; block *= 2) {
+        ++index;
+    }
+    return index;
+}
+
+void* PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++m_stats.allocations;
+    const std::size_t index = size_class(bytes);
+    if (index >= class_count || alignment > alignof(std::max_align_t)) {
+        // oversized or over-aligned: straight to upstream, behind a header that links it into m_large
+        const std::size_t offset = large_offset(alignment);
+        auto* raw = static_cast<unsigned char*>(
+            m_upstream->allocate(offset + bytes, std::max(alignment, alignof(LargeBlock))));
+        auto* block = ::new (raw + offset - sizeof(LargeBlock)) LargeBlock{nullptr, m_large, bytes, alignment};
+        if (m_large) {
+            m_large->prev = block;
+        }
+        m_large = block;
+        ++m_stats.upstream_allocations;
+        m_stats.bytes_reserved += offset + bytes;
+        m_stats.bytes_used += bytes;
+        m_stats.bytes_live += bytes;
+        m_stats.high_water_mark = std::max(m_stats.high_water_mark, m_stats.bytes_used);
+        return raw + offset;
+    }
+    if (!m_free[index]) {
+        refill(index);
+    }
+    FreeBlock* block = m_free[index];
+    m_free[index] = block->next;
+    m_stats.bytes_used += min_block_size << index;
+    m_stats.bytes_live += bytes;
+    m_stats.high_water_mark = std::max(m_stats.high_water_mark, m_stats.bytes_used);
+    return block;
+}
+
+void PoolResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept {
+    const std::size_t index = size_class(bytes);
+    if (index >= class_count || alignment > alignof(std::max_align_t)) {
+        free_large(reinterpret_cast<LargeBlock*>(static_cast<unsigned char*>(ptr) - sizeof(LargeBlock)));
+        return;
+    }
+    m_stats.bytes_live -= bytes;
+    m_free[index] = ::new (ptr) FreeBlock{m_free[index]};
+    m_stats.bytes_used -= min_block_size << index;
+}
+
+// Splits one slab into equally sized blocks and pushes them onto the free list
+void PoolResource::refill(std::size_t index) {
+    const std::size_t block_size = min_block_size << index;
+    void* raw = m_upstream->allocate(m_slab_size, alignof(std::max_align_t));
+    m_slabs = ::new (raw) Slab{m_slabs, m_slab_size};
+    ++m_stats.upstream_allocations;
+    m_stats.bytes_reserved += m_slab_size;
+
+    // the slab header occupies the first block; push in reverse so the list runs in address order
+    unsigned char* base = static_cast<unsigned char*>(raw);
+    const std::size_t first = std::max(block_size, sizeof(Slab)) / block_size;
+    for (std::size_t i = m_slab_size / block_size; i-- > first;) {
+        m_free[index] = ::new (base + i * block_size) FreeBlock{m_free[index]};
+    }
+}
+
+// The header ends right where the block starts; rounding up to the alignment keeps the block aligned
+std::size_t PoolResource::large_offset(std::size_t alignment) noexcept {
+    const std::size_t align = std::max(alignment, alignof(LargeBlock));
+    return (sizeof(LargeBlock) + align - 1) / align * align;
+}
+
+void PoolResource::free_large(LargeBlock* block) noexcept {
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        m_large = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    const std::size_t bytes = block->bytes;
+    const std::size_t alignment = block->alignment;
+    const std::size_t offset = large_offset(alignment);
+    m_stats.bytes_reserved -= offset + bytes;
+    m_stats.bytes_used -= bytes;
+    m_stats.bytes_live -= bytes;
+    unsigned char* raw = reinterpret_cast<unsigned char*>(block) + sizeof(LargeBlock) - offset;
+    m_upstream->deallocate(raw, offset + bytes, std::max(alignment, alignof(LargeBlock)));
+}
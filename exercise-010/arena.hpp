@@ -0,0 +1,191 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <array>   // for std::array
+#include <cstddef> // for size_t, max_align_t
+
+/**
+ * @brief Pluggable memory resource interface for ResourceAllocator<T>
+ *
+ * A container such as MyVector<T, ResourceAllocator<T>> keeps its type no matter
+ * which resource (heap, arena, pool, ...) provides the memory at runtime.
+ */
+class MemoryResource {
+public:
+    virtual ~MemoryResource() = default;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        return do_allocate(bytes, alignment);
+    }
+    void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        do_deallocate(ptr, bytes, alignment);
+    }
+    bool is_equal(const MemoryResource& other) const noexcept { return this == &other; }
+
+private:
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept = 0;
+};
+
+// Returns the process-wide resource that forwards to ::operator new / ::operator delete
+MemoryResource* new_delete_resource() noexcept;
+
+// Usage numbers of a MonotonicArena or PoolResource, all sizes in bytes
+struct ArenaStats {
+    std::size_t bytes_reserved = 0;  // memory obtained from the upstream resource
+    std::size_t bytes_used = 0;      // memory handed out and not reclaimable (bump offset / blocks in use)
+    std::size_t bytes_live = 0;      // requested bytes that are still allocated
+    std::size_t high_water_mark = 0; // largest bytes_used seen since construction
+    std::size_t allocations = 0;     // number of allocate() calls
+    std::size_t upstream_allocations = 0; // number of chunks/slabs requested from upstream
+
+    // Share of the used memory that is not live anymore (padding, rounding, freed blocks)
+    double fragmentation() const noexcept {
+        return bytes_used ? 1.0 - static_cast<double>(bytes_live) / static_cast<double>(bytes_used) : 0.0;
+    }
+};
+
+/**
+ * @brief Bump allocator that releases all of its memory at once
+ *
+ * Allocation is a pointer increment inside the current chunk; deallocate() only
+ * rewinds if the block is the most recent one. All memory goes back to the
+ * upstream resource in release() or in the destructor. Not thread-safe:
+ * use one arena per request or per thread.
+ */
+class MonotonicArena : public MemoryResource {
+public:
+    explicit MonotonicArena(std::size_t initial_chunk_size = 64 * 1024,
+                            MemoryResource* upstream = new_delete_resource()) noexcept;
+    ~MonotonicArena() override;
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // Returns all chunks to the upstream resource; the high-water mark is kept
+    void release() noexcept;
+
+    const ArenaStats& stats() const noexcept { return m_stats; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t size; // usable bytes after the header
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept override;
+
+    // Private helper: requests a new chunk with room for at least 'bytes' aligned bytes
+    void add_chunk(std::size_t bytes, std::size_t alignment);
+
+    MemoryResource* m_upstream;
+    Chunk* m_chunks = nullptr;      // most recent chunk first
+    unsigned char* m_cursor = nullptr;
+    unsigned char* m_end = nullptr;
+    std::size_t m_next_chunk_size;
+    ArenaStats m_stats;
+};
+
+/**
+ * @brief Size-class pool with one free list per power-of-two block size
+ *
+ * Requests up to max_block_size bytes are rounded up to the next size class and
+ * served from a free list; freed blocks are reused by later requests of the same
+ * class. Free lists are refilled with slabs from the upstream resource, larger
+ * or over-aligned requests go to upstream directly but are still owned by the
+ * pool, so release() and the destructor return them as well. Not thread-safe.
+ */
+class PoolResource : public MemoryResource {
+public:
+    static constexpr std::size_t min_block_size = 16;
+    static constexpr std::size_t max_block_size = 4096;
+
+    explicit PoolResource(MemoryResource* upstream = new_delete_resource(), std::size_t slab_size = 64 * 1024) noexcept;
+    ~PoolResource() override;
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    // Returns all slabs and large blocks to the upstream resource; outstanding blocks become invalid
+    void release() noexcept;
+
+    const ArenaStats& stats() const noexcept { return m_stats; }
+
+private:
+    static constexpr std::size_t class_count = 9; // 16, 32, ..., 4096
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    struct Slab {
+        Slab* next;
+        std::size_t size; // bytes including this header
+    };
+    // Stored directly in front of every block that bypasses the size classes
+    struct LargeBlock {
+        LargeBlock* prev;
+        LargeBlock* next;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept override;
+
+    // Private helper: index of the size class for 'bytes', class_count if too large
+    static std::size_t size_class(std::size_t bytes) noexcept;
+
+    // Private helper: carves a new slab into blocks of size class 'index'
+    void refill(std::size_t index);
+
+    // Private helper: distance from the upstream allocation to a large block, a multiple of alignment
+    static std::size_t large_offset(std::size_t alignment) noexcept;
+
+    // Private helper: returns one large block to upstream and takes it out of the list and the stats
+    void free_large(LargeBlock* block) noexcept;
+
+    MemoryResource* m_upstream;
+    std::size_t m_slab_size;
+    std::array<FreeBlock*, class_count> m_free{};
+    Slab* m_slabs = nullptr;
+    LargeBlock* m_large = nullptr; // doubly linked, so deallocate() unlinks in constant time
+    ArenaStats m_stats;
+};
+
+/**
+ * @brief Standard-conforming allocator that draws memory from a MemoryResource
+ * @tparam T Element type
+ *
+ * Allocators compare equal if they share the resource. Copy construction keeps the
+ * resource; on assignment and swap a container keeps the resource it was created with.
+ */
+template <typename T>
+class ResourceAllocator {
+public:
+    using value_type = T;
+
+    ResourceAllocator() noexcept : m_resource(new_delete_resource()) {}
+    ResourceAllocator(MemoryResource* resource) noexcept : m_resource(resource) {}
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U>& other) noexcept : m_resource(other.resource()) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* ptr, std::size_t n) noexcept { m_resource->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    MemoryResource* resource() const noexcept { return m_resource; }
+
+private:
+    MemoryResource* m_resource;
+};
+
+template <typename T, typename U>
+bool operator==(const ResourceAllocator<T>& lhs, const ResourceAllocator<U>& rhs) noexcept {
+    return lhs.resource()->is_equal(*rhs.resource());
+}
+template <typename T, typename U>
+bool operator!=(const ResourceAllocator<T>& lhs, const ResourceAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+#endif /* ARENA_HPP */
@@ -0,0 +1,72 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <random>
+#include <string>
+#include "CLI/CLI.hpp"
+#include "../compressed_vector.hpp"
+#include "../myvector_simd.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Compression ratio plus decode and scan throughput, measured in uncompressed bytes per second
+void run(const std::string& name, const MyVector<int>& values, std::size_t repeat) {
+    const double bytes = static_cast<double>(values.size() * sizeof(int));
+    CompressedIntVector packed;
+    const double encode = best_of(repeat, [&] { packed = CompressedIntVector(values); });
+
+    MyVector<int> out;
+    out.resize_default_init(values.size());
+    const double decode = best_of(repeat, [&] {
+        packed.decode(out.data());
+        g_bench_sink = out[out.size() / 2];
+    });
+    const double scan_plain = best_of(repeat, [&] { g_bench_sink = simd::sum(values); });
+    const double scan_packed = best_of(repeat, [&] { g_bench_sink = packed.sum(); });
+
+    fmt::println("{:<12} {:>7.2f}x {:>10.2f} {:>10.2f} {:>12.2f} {:>12.2f}", name, packed.compression_ratio(),
+                 bytes / encode / 1e9, bytes / decode / 1e9, bytes / scan_plain / 1e9, bytes / scan_packed / 1e9);
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int
+{
+    CLI::App app{"CompressedIntVector benchmark"};
+
+    std::size_t elements = 1 << 24;
+    std::size_t repeat = 10;
+    app.add_option("-n,--elements", elements, "Number of ints per data set");
+    app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError &e)
+    {
+        return app.exit(e);
+    }
+
+    std::mt19937 gen(42);
+    MyVector<int> small_range;
+    MyVector<int> sorted_ids;
+    small_range.reserve(elements);
+    sorted_ids.reserve(elements);
+    std::uniform_int_distribution<int> values(1, 100);
+    std::uniform_int_distribution<int> gaps(1, 16);
+    int id = 0;
+    for (std::size_t i = 0; i < elements; ++i) {
+        small_range.push_back(values(gen));
+        id += gaps(gen);
+        sorted_ids.push_back(id);
+    }
+
+    fmt::println("{} ints, best of {} runs, throughput in GB/s of uncompressed data\n", elements, repeat);
+    fmt::println("{:<12} {:>8} {:>10} {:>10} {:>12} {:>12}", "data", "ratio", "encode", "decode", "sum plain",
+                 "sum packed");
+    run("1..100", small_range, repeat);
+    run("sorted ids", sorted_ids, repeat);
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CLI/CLI.hpp"
+#include "../concurrent_vector.hpp"
+#include "../myvector.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Starts 'threads' producers that each call append(thread, i) 'per_thread' times and waits for them
+template <typename Append>
+void produce(unsigned threads, std::size_t per_thread, Append&& append) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&append, t, per_thread] {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                append(t, i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int
+{
+    CLI::App app{"ConcurrentVector vs. mutex-protected MyVector append throughput"};
+
+    std::size_t elements = 1 << 22;
+    std::size_t repeat = 5;
+    unsigned max_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+    app.add_option("-n,--elements", elements, "Total number of appended ints per run");
+    app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+    app.add_option("-t,--threads", max_threads, "Largest thread count, doubled from 1");
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError &e)
+    {
+        return app.exit(e);
+    }
+
+    fmt::println("{} ints per run, best of {} runs\n", elements, repeat);
+    fmt::println("{:>8} {:>16} {:>16} {:>8}", "threads", "mutex Mops/s", "segmented Mops/s", "speedup");
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        const std::size_t per_thread = elements / threads;
+
+        const double locked = best_of(repeat, [&] {
+            MyVector<int> v;
+            std::mutex mutex;
+            produce(threads, per_thread, [&](unsigned t, std::size_t i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                v.push_back(static_cast<int>(t + i));
+            });
+            g_bench_sink = static_cast<long long>(v.size());
+        });
+
+        const double segmented = best_of(repeat, [&] {
+            ConcurrentVector<int> v;
+            produce(threads, per_thread, [&](unsigned t, std::size_t i) { v.push_back(static_cast<int>(t + i)); });
+            g_bench_sink = static_cast<long long>(v.size());
+        });
+
+        const double total = static_cast<double>(per_thread * threads);
+        fmt::println("{:>8} {:>16.1f} {:>16.1f} {:>7.2f}x", threads, total / locked / 1e6, total / segmented / 1e6,
+                     locked / segmented);
+    }
+
+    return 0;
+}
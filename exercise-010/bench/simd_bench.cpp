@@ -0,0 +1,130 @@
+#include <fmt/format.h>
+#include <cstddef>
+#include <random>
+#include <string>
+#include "CLI/CLI.hpp"
+#include "../myvector_simd.hpp"
+#include "bench_util.hpp"
+
+namespace {
+
+// Times one kernel against its operator[] loop and prints a table row per instruction set
+template <typename Loop, typename Kernel>
+void run(const std::string& name, std::size_t elements, std::size_t repeat, Loop&& loop, Kernel&& kernel) {
+    const double baseline = best_of(repeat, loop);
+    fmt::println("{:<14} {:>10} {:>10.3f} ms {:>8.2f} GB/s", name, "loop", baseline * 1e3,
+                 elements * sizeof(int) / baseline / 1e9);
+
+    const simd::Isa best = simd::detected_isa();
+    for (simd::Isa isa : {simd::Isa::Scalar, simd::Isa::SSE41, simd::Isa::AVX2}) {
+        if (static_cast<int>(isa) > static_cast<int>(best)) continue;
+        simd::force_isa(isa);
+        const double t = best_of(repeat, kernel);
+        fmt::println("{:<14} {:>10} {:>10.3f} ms {:>8.2f} GB/s  x{:.2f}", "", simd::isa_name(isa), t * 1e3,
+                     elements * sizeof(int) / t / 1e9, baseline / t);
+    }
+    simd::force_isa(best);
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int
+{
+    CLI::App app{"MyVector SIMD kernel benchmark"};
+
+    std::size_t elements = 1 << 22;
+    std::size_t repeat = 20;
+    app.add_option("-n,--elements", elements, "Number of ints per vector");
+    app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError &e)
+    {
+        return app.exit(e);
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(1, 100);
+    MyVector<int> a;
+    MyVector<int> b;
+    a.reserve(elements);
+    b.reserve(elements);
+    for (std::size_t i = 0; i < elements; ++i) {
+        a.push_back(dis(gen));
+        b.push_back(dis(gen));
+    }
+
+    fmt::println("{} ints, best of {} runs, detected ISA: {}\n", elements, repeat,
+                 simd::isa_name(simd::detected_isa()));
+
+    run("sum", elements, repeat,
+        [&] {
+            long long total = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) total += a[i];
+            g_bench_sink = total;
+        },
+        [&] { g_bench_sink = simd::sum(a); });
+
+    run("min/max", elements, repeat,
+        [&] {
+            int lo = a[0];
+            int hi = a[0];
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                lo = a[i] < lo ? a[i] : lo;
+                hi = a[i] > hi ? a[i] : hi;
+            }
+            g_bench_sink = lo + hi;
+        },
+        [&] { g_bench_sink = simd::min(a) + simd::max(a); });
+
+    run("find (miss)", elements, repeat,
+        [&] {
+            std::size_t i = 0;
+            while (i < a.size() && a[i] != -1) ++i;
+            g_bench_sink = static_cast<long long>(i);
+        },
+        [&] { g_bench_sink = static_cast<long long>(simd::find(a, -1)); });
+
+    run("count", elements, repeat,
+        [&] {
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) hits += a[i] == 42;
+            g_bench_sink = static_cast<long long>(hits);
+        },
+        [&] { g_bench_sink = static_cast<long long>(simd::count(a, 42)); });
+
+    run("fill", elements, repeat,
+        [&] {
+            for (std::size_t i = 0; i < b.size(); ++i) b[i] = 7;
+            g_bench_sink = b[b.size() / 2];
+        },
+        [&] {
+            simd::fill(b, 7);
+            g_bench_sink = b[b.size() / 2];
+        });
+
+    run("a *= 3", elements, repeat,
+        [&] {
+            for (std::size_t i = 0; i < a.size(); ++i) a[i] *= 3;
+            g_bench_sink = a[a.size() / 2];
+        },
+        [&] {
+            simd::transform(a, 3, simd::Op::Mul);
+            g_bench_sink = a[a.size() / 2];
+        });
+
+    run("a += b", elements, repeat,
+        [&] {
+            for (std::size_t i = 0; i < a.size(); ++i) a[i] += b[i];
+            g_bench_sink = a[a.size() / 2];
+        },
+        [&] {
+            simd::transform(a, b, simd::Op::Add);
+            g_bench_sink = a[a.size() / 2];
+        });
+
+    return 0;
+}
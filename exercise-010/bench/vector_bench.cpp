@@ -0,0 +1,202 @@
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "CLI/CLI.hpp"
+#include "config.h"
+#include "../myvector.hpp"
+#include "bench_util.hpp"
+
+#ifndef BENCH_REPORT_DIRECTORY
+#define BENCH_REPORT_DIRECTORY "."
+#endif
+
+namespace {
+
+// Fast pseudo-random index in [0, n); identical sequence for both containers
+struct IndexStream {
+    std::uint32_t state = 2463534242u;
+
+    std::size_t next(std::size_t n) noexcept {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(state) * n) >> 32);
+    }
+};
+
+// Small sizes are timed over several passes, so every run takes roughly 'work' element operations
+std::size_t passes_for(std::size_t n, std::size_t work) {
+    return std::max<std::size_t>(1, work / n);
+}
+
+// Benchmark cases, each run for MyVector<int> and std::vector<int>.
+// Every function returns the best time for one pass over n elements in seconds.
+template <typename Vector>
+double push_back_grow(std::size_t n, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            Vector v;
+            for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(i));
+            g_bench_sink = v[n - 1];
+        }
+    }) / passes;
+}
+
+template <typename Vector>
+double push_back_reserved(std::size_t n, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            Vector v;
+            v.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(i));
+            g_bench_sink = v[n - 1];
+        }
+    }) / passes;
+}
+
+template <typename Vector>
+double copy_construct(const Vector& source, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            Vector copy(source);
+            g_bench_sink = copy[copy.size() - 1];
+        }
+    }) / passes;
+}
+
+template <typename Vector>
+double resize(std::size_t n, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            Vector v;
+            v.resize(n);
+            g_bench_sink = v[n - 1];
+        }
+    }) / passes;
+}
+
+template <typename Vector>
+double random_at(const Vector& v, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        IndexStream indices;
+        long long total = 0;
+        for (std::size_t i = 0, count = v.size() * passes; i < count; ++i) total += v.at(indices.next(v.size()));
+        g_bench_sink = total;
+    }) / passes;
+}
+
+template <typename Vector>
+double random_index(const Vector& v, std::size_t repeat, std::size_t passes) {
+    return best_of(repeat, [&] {
+        IndexStream indices;
+        long long total = 0;
+        for (std::size_t i = 0, count = v.size() * passes; i < count; ++i) total += v[indices.next(v.size())];
+        g_bench_sink = total;
+    }) / passes;
+}
+
+template <typename Vector>
+double clear_refill(Vector& v, std::size_t repeat, std::size_t passes) {
+    const std::size_t n = v.size();
+    return best_of(repeat, [&] {
+        for (std::size_t p = 0; p < passes; ++p) {
+            v.clear();
+            for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(i));
+            g_bench_sink = v[n - 1];
+        }
+    }) / passes;
+}
+
+// Runs all cases for one container type and size, appending one JSON record per case
+template <typename Vector>
+void run_all(const std::string& container, std::size_t n, std::size_t repeat, std::size_t work,
+             nlohmann::json& results) {
+    const std::size_t passes = passes_for(n, work);
+    Vector filled;
+    filled.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) filled.push_back(static_cast<int>(i));
+
+    const std::pair<const char*, double> timings[] = {
+        {"push_back", push_back_grow<Vector>(n, repeat, passes)},
+        {"push_back_reserved", push_back_reserved<Vector>(n, repeat, passes)},
+        {"copy_construct", copy_construct(filled, repeat, passes)},
+        {"resize", resize<Vector>(n, repeat, passes)},
+        {"random_at", random_at(filled, repeat, passes)},
+        {"random_index", random_index(filled, repeat, passes)},
+        {"clear_refill", clear_refill(filled, repeat, passes)},
+    };
+    for (const auto& [name, seconds] : timings) {
+        results.push_back({{"case", name},
+                           {"container", container},
+                           {"size", n},
+                           {"seconds", seconds},
+                           {"ns_per_element", seconds * 1e9 / static_cast<double>(n)}});
+    }
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int
+{
+    CLI::App app{"MyVector vs. std::vector benchmark"};
+
+    std::size_t max_size = 100000000;
+    std::size_t repeat = 5;
+    std::size_t work = 1 << 22;
+    std::string output = std::string(BENCH_REPORT_DIRECTORY) + "/" + PROJECT_NAME + "-vector-bench.json";
+    app.add_option("-m,--max-size", max_size, "Largest element count, sizes run from 10 in powers of ten");
+    app.add_option("-r,--repeat", repeat, "Repetitions, the fastest run is reported");
+    app.add_option("-w,--work", work, "Element operations per timed run for small sizes");
+    app.add_option("-o,--output", output, "JSON report file");
+
+    try
+    {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError &e)
+    {
+        return app.exit(e);
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+    fmt::println("{:<20} {:>10} {:>14} {:>14} {:>8}", "case", "size", "MyVector ns/el", "std ns/el", "ratio");
+    for (std::size_t n = 10; n <= max_size; n *= 10) {
+        const std::size_t first = results.size();
+        run_all<MyVector<int>>("MyVector", n, repeat, work, results);
+        run_all<std::vector<int>>("std::vector", n, repeat, work, results);
+
+        const std::size_t cases = (results.size() - first) / 2;
+        for (std::size_t c = 0; c < cases; ++c) {
+            const nlohmann::json& mine = results[first + c];
+            const nlohmann::json& theirs = results[first + cases + c];
+            const double mine_ns = mine["ns_per_element"].get<double>();
+            const double theirs_ns = theirs["ns_per_element"].get<double>();
+            fmt::println("{:<20} {:>10} {:>14.3f} {:>14.3f} {:>8.2f}", mine["case"].get<std::string>(), n, mine_ns,
+                         theirs_ns, mine_ns / theirs_ns);
+        }
+        if (n > max_size / 10) break;
+    }
+
+    nlohmann::json report = {{"benchmark", "vector-bench"},
+                             {"project", PROJECT_NAME},
+                             {"version", PROJECT_VER},
+                             {"build_date", PROJECT_BUILD_DATE},
+                             {"repeat", repeat},
+                             {"results", results}};
+    std::ofstream file(output);
+    if (!file)
+    {
+        fmt::print(stderr, "cannot write report to {}\n", output);
+        return 1;
+    }
+    file << report.dump(2) << '\n';
+    fmt::println("\nreport written to {}", output);
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+#include "compressed_vector.hpp"
+#include <stdexcept>
+
+#include "myvector_simd.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Packed layout of one block: value i belongs to lane i % 4 and row i / 4. The 32 values of
+// a lane are concatenated bit by bit, and word w of lane l is stored at words[4 * w + l].
+// All four lanes of a row therefore sit at the same bit position, so one SSE2 shift by a
+// common count extracts a whole row.
+
+namespace {
+
+constexpr std::size_t lanes = 4;
+constexpr std::size_t rows = CompressedIntVector::block_size / lanes;
+
+// Number of bits needed to represent x (0 for x == 0)
+unsigned bit_width(std::uint32_t x) noexcept {
+    unsigned bits = 0;
+    while (x) {
+        ++bits;
+        x >>= 1;
+    }
+    return bits;
+}
+
+std::uint32_t low_mask(unsigned bits) noexcept {
+    return bits >= 32 ? 0xFFFFFFFFu : (std::uint32_t{1} << bits) - 1;
+}
+
+// Packs block_size unsigned values with 'bits' bits each into 4 * bits zeroed words
+void pack(const std::uint32_t* values, unsigned bits, std::uint32_t* words) noexcept {
+    for (std::size_t row = 0; row < rows; ++row) {
+        const std::size_t pos = row * bits;
+        const std::size_t word = pos / 32;
+        const unsigned shift = pos % 32;
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            const std::uint32_t value = values[row * lanes + lane];
+            words[lanes * word + lane] |= value << shift;
+            if (shift + bits > 32) {
+                words[lanes * (word + 1) + lane] |= value >> (32 - shift);
+            }
+        }
+    }
+}
+
+// Extracts the packed value with index i of a block
+std::uint32_t extract(const std::uint32_t* words, unsigned bits, std::size_t i) noexcept {
+    if (bits == 0) return 0;
+    const std::size_t pos = (i / lanes) * bits;
+    const std::size_t word = pos / 32;
+    const unsigned shift = pos % 32;
+    const std::size_t lane = i % lanes;
+    std::uint32_t value = words[lanes * word + lane] >> shift;
+    if (shift + bits > 32) {
+        value |= words[lanes * (word + 1) + lane] << (32 - shift);
+    }
+    return value & low_mask(bits);
+}
+
+// Unpacks a full block and undoes frame-of-reference or delta coding (wrap-around arithmetic).
+// Portable reference for unpack_sse2, used on targets without SSE2.
+[[maybe_unused]] void unpack_scalar(const std::uint32_t* words, unsigned bits, std::uint32_t reference, bool delta,
+                   std::uint32_t* out) noexcept {
+    std::uint32_t previous = reference;
+    for (std::size_t i = 0; i < CompressedIntVector::block_size; ++i) {
+        const std::uint32_t value = extract(words, bits, i);
+        if (delta) {
+            previous += value;
+            out[i] = previous;
+        } else {
+            out[i] = reference + value;
+        }
+    }
+}
+
+#if defined(__SSE2__)
+// Same result as unpack_scalar, one row of four values per iteration
+void unpack_sse2(const std::uint32_t* words, unsigned bits, std::uint32_t reference, bool delta,
+                 std::uint32_t* out) noexcept {
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(low_mask(bits)));
+    __m128i base = _mm_set1_epi32(static_cast<int>(reference));
+    const __m128i* in = reinterpret_cast<const __m128i*>(words);
+    for (std::size_t row = 0; row < rows; ++row) {
+        __m128i value = _mm_setzero_si128();
+        if (bits) {
+            const std::size_t pos = row * bits;
+            const std::size_t word = pos / 32;
+            const unsigned shift = pos % 32;
+            value = _mm_srl_epi32(_mm_loadu_si128(in + word), _mm_cvtsi32_si128(static_cast<int>(shift)));
+            if (shift + bits > 32) {
+                const __m128i high = _mm_sll_epi32(_mm_loadu_si128(in + word + 1),
+                                                   _mm_cvtsi32_si128(static_cast<int>(32 - shift)));
+                value = _mm_or_si128(value, high);
+            }
+            value = _mm_and_si128(value, mask);
+        }
+        if (delta) {
+            // prefix sum over the four lanes, then add the last value of the previous row
+            value = _mm_add_epi32(value, _mm_slli_si128(value, 4));
+            value = _mm_add_epi32(value, _mm_slli_si128(value, 8));
+            value = _mm_add_epi32(value, base);
+            base = _mm_shuffle_epi32(value, 0xFF);
+        } else {
+            value = _mm_add_epi32(value, base);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * lanes), value);
+    }
+}
+#endif
+
+void unpack(const std::uint32_t* words, unsigned bits, std::uint32_t reference, bool delta,
+            std::uint32_t* out) noexcept {
+#if defined(__SSE2__)
+    unpack_sse2(words, bits, reference, delta, out);
+#else
+    unpack_scalar(words, bits, reference, delta, out);
+#endif
+}
+
+} // namespace
+
+// Each block is encoded on its own; a partial last block is padded with its last value
+CompressedIntVector::CompressedIntVector(const int* data, size_type n) : m_size(n) {
+    const size_type blocks = (n + block_size - 1) / block_size;
+    m_blocks.reserve(blocks);
+
+    std::uint32_t values[block_size];
+    std::uint32_t offsets[block_size];
+    std::uint32_t deltas[block_size];
+    for (size_type b = 0; b < blocks; ++b) {
+        const size_type first = b * block_size;
+        const size_type count = n - first < block_size ? n - first : block_size;
+        for (size_type i = 0; i < block_size; ++i) {
+            values[i] = static_cast<std::uint32_t>(data[first + (i < count ? i : count - 1)]);
+        }
+
+        // frame of reference: offsets to the minimum; delta: only for non-decreasing blocks
+        int lowest = data[first];
+        int highest = data[first];
+        bool sorted = true;
+        for (size_type i = 1; i < count; ++i) {
+            lowest = data[first + i] < lowest ? data[first + i] : lowest;
+            highest = data[first + i] > highest ? data[first + i] : highest;
+            sorted = sorted && data[first + i - 1] <= data[first + i];
+        }
+        const auto minimum = static_cast<std::uint32_t>(lowest);
+        const unsigned for_bits = bit_width(static_cast<std::uint32_t>(highest) - minimum);
+
+        std::uint32_t largest_delta = 0;
+        if (sorted) {
+            deltas[0] = 0;
+            for (size_type i = 1; i < block_size; ++i) {
+                deltas[i] = values[i] - values[i - 1];
+                largest_delta = deltas[i] > largest_delta ? deltas[i] : largest_delta;
+            }
+        }
+        const bool delta = sorted && bit_width(largest_delta) < for_bits;
+
+        BlockHeader header{};
+        header.offset = m_words.size();
+        header.reference = delta ? values[0] : minimum;
+        header.bits = static_cast<std::uint8_t>(delta ? bit_width(largest_delta) : for_bits);
+        header.delta = delta ? 1 : 0;
+        m_blocks.push_back(header);
+
+        if (!delta) {
+            for (size_type i = 0; i < block_size; ++i) {
+                offsets[i] = values[i] - minimum;
+            }
+        }
+        std::uint32_t packed[lanes * 32] = {}; // pack() only sets bits
+        pack(delta ? deltas : offsets, header.bits, packed);
+        m_words.append(packed, packed + lanes * header.bits);
+    }
+}
+
+// Frame of reference needs one extraction, delta coding sums the differences up to the index
+int CompressedIntVector::at(size_type index) const {
+    if (index >= m_size) throw std::out_of_range("CompressedIntVector::at");
+    const BlockHeader& header = m_blocks[index / block_size];
+    const std::uint32_t* words = m_words.data() + header.offset;
+    const size_type i = index % block_size;
+    std::uint32_t value = header.reference;
+    if (header.delta) {
+        for (size_type k = 1; k <= i; ++k) {
+            value += extract(words, header.bits, k);
+        }
+    } else {
+        value += extract(words, header.bits, i);
+    }
+    return static_cast<int>(value);
+}
+
+CompressedIntVector::size_type CompressedIntVector::decode_block(size_type block, int* out) const {
+    if (block >= m_blocks.size()) throw std::out_of_range("CompressedIntVector::decode_block");
+    const BlockHeader& header = m_blocks[block];
+    unpack(m_words.data() + header.offset, header.bits, header.reference, header.delta != 0,
+           reinterpret_cast<std::uint32_t*>(out));
+    const size_type first = block * block_size;
+    return m_size - first < block_size ? m_size - first : block_size;
+}
+
+// Full blocks are decoded straight into out, only the last one goes through a buffer
+void CompressedIntVector::decode(int* out) const {
+    const size_type full = m_size / block_size;
+    for (size_type b = 0; b < full; ++b) {
+        decode_block(b, out + b * block_size);
+    }
+    if (full < m_blocks.size()) {
+        int buffer[block_size];
+        const size_type count = decode_block(full, buffer);
+        for (size_type i = 0; i < count; ++i) {
+            out[full * block_size + i] = buffer[i];
+        }
+    }
+}
+
+MyVector<int> CompressedIntVector::to_vector() const {
+    MyVector<int> result;
+    result.resize_default_init(m_size);
+    if (m_size) decode(result.data());
+    return result;
+}
+
+long long CompressedIntVector::sum() const {
+    long long total = 0;
+    for_each_block([&total](const int* values, size_type count) { total += simd::sum(values, count); });
+    return total;
+}
+
+CompressedIntVector::size_type CompressedIntVector::memory_bytes() const noexcept {
+    return m_blocks.size() * sizeof(BlockHeader) + m_words.size() * sizeof(std::uint32_t);
+}
+
+double CompressedIntVector::compression_ratio() const noexcept {
+    const size_type bytes = memory_bytes();
+    return bytes ? static_cast<double>(m_size * sizeof(int)) / static_cast<double>(bytes) : 1.0;
+}
@@ -0,0 +1,91 @@
+#ifndef COMPRESSED_VECTOR_HPP
+#define COMPRESSED_VECTOR_HPP
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t, uint32_t, uint8_t
+
+#include "myvector.hpp"
+
+/**
+ * @brief Read-optimized, bit-packed copy of an int sequence
+ *
+ * The values are split into blocks of block_size ints. Each block stores either
+ * the offsets to its minimum (frame of reference) or, for non-decreasing blocks,
+ * the differences between neighbours (delta), whichever needs fewer bits. The
+ * offsets are bit-packed with the smallest width that fits, in a 4-lane layout
+ * that SSE2 unpacks four values at a time. Values from a small range such as
+ * 1..100 take 7 bits, sorted IDs with small gaps often only 1-4 bits.
+ *
+ * Every block can be decoded independently (random block access); at() extracts
+ * a single value without decoding the rest of its block. The container is
+ * immutable: build it from a MyVector<int> and convert back with to_vector().
+ */
+class CompressedIntVector {
+public:
+    using value_type = int;
+    using size_type = std::size_t;
+
+    // Number of values per block, the unit of random access and of decoding
+    static constexpr size_type block_size = 128;
+
+    // Creates an empty sequence
+    CompressedIntVector() = default;
+
+    // Compresses n values starting at data
+    CompressedIntVector(const int* data, size_type n);
+
+    // Compresses the elements of a MyVector<int>
+    template <typename Alloc, typename Trace>
+    explicit CompressedIntVector(const MyVector<int, Alloc, Trace>& v) : CompressedIntVector(v.data(), v.size()) {}
+
+    // Number of stored values
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Number of blocks, the last one may be partially filled
+    size_type block_count() const noexcept { return m_blocks.size(); }
+
+    // Value at index with bounds checking; throws std::out_of_range if invalid
+    int at(size_type index) const;
+
+    // Decodes block 'block' into out (room for block_size ints) and returns its number of values
+    size_type decode_block(size_type block, int* out) const;
+
+    // Decodes all values into out (room for size() ints)
+    void decode(int* out) const;
+
+    // Decompresses into a MyVector<int>
+    MyVector<int> to_vector() const;
+
+    // Calls fn(values, count) for every decoded block in order; the pointer is only valid during the call
+    template <typename Fn>
+    void for_each_block(Fn&& fn) const {
+        alignas(16) int buffer[block_size];
+        for (size_type b = 0; b < block_count(); ++b) {
+            fn(static_cast<const int*>(buffer), decode_block(b, buffer));
+        }
+    }
+
+    // Sum of all values (sequential scan, decoded block by block)
+    long long sum() const;
+
+    // Bytes used by block headers and packed data
+    size_type memory_bytes() const noexcept;
+
+    // Uncompressed size divided by memory_bytes()
+    double compression_ratio() const noexcept;
+
+private:
+    struct BlockHeader {
+        std::uint64_t offset;    // index of the first packed word in m_words
+        std::uint32_t reference; // block minimum (frame of reference) or first value (delta)
+        std::uint8_t bits;       // packed width per value, 0..32
+        std::uint8_t delta;      // 1 if the packed values are differences to the previous value
+    };
+
+    MyVector<BlockHeader> m_blocks;
+    MyVector<std::uint32_t> m_words; // 4 * bits words per block
+    size_type m_size = 0;
+};
+
+#endif /* COMPRESSED_VECTOR_HPP */
@@ -0,0 +1,289 @@
+#ifndef CONCURRENT_VECTOR_HPP
+#define CONCURRENT_VECTOR_HPP
+
+#include <array>       // for std::array
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for size_t
+#include <iterator>    // for std::distance
+#include <new>         // for placement new, std::align_val_t
+#include <stdexcept>   // for std::out_of_range, std::length_error
+#include <thread>      // for std::this_thread::yield
+#include <type_traits> // for std::is_trivially_destructible
+#include <utility>     // for std::forward, std::move
+
+#include "myvector.hpp"
+
+/**
+ * @brief Thread-safe, append-only vector with stable element addresses
+ * @tparam T Element type
+ *
+ * Elements live in segments of 32, 64, 128, ... slots that are never moved, so
+ * references and pointers stay valid while other threads append. An append
+ * reserves its slot with a single atomic fetch-add, constructs the element
+ * without holding a lock and then marks the slot as ready. The segment that a
+ * slot falls into is allocated exactly once, by the first thread that needs it;
+ * threads that need it at the same time wait until it is published.
+ *
+ * Readers never block: size() counts reserved slots, ready(i) tells whether
+ * slot i is fully constructed, for_each() visits the ready elements in index
+ * order. Elements cannot be removed or modified concurrently by the container;
+ * use snapshot() to obtain an ordinary MyVector copy.
+ */
+template <typename T>
+class ConcurrentVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    // Number of slots of the first segment, every further segment doubles
+    static constexpr size_type first_segment_size = 32;
+
+    // Segments allocated at most; enough for more elements than fit into memory
+    static constexpr size_type max_segments = 48;
+
+    ConcurrentVector() noexcept = default;
+
+    // Appends happen from many threads, copying or moving the container does not make sense
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Destructor destroys the constructed elements and frees all segments; no thread may append anymore
+    ~ConcurrentVector();
+
+    // Adds an element to the end and returns its index; safe to call from any number of threads
+    size_type push_back(const T& value) { return emplace_back(value); }
+    size_type push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // Constructs an element in a newly reserved slot and returns its index.
+    // If the constructor throws, the slot stays unready and is skipped by readers.
+    template <typename... Args>
+    size_type emplace_back(Args&&... args);
+
+    // Appends the elements of the forward range [first, last) into consecutive slots reserved
+    // with one atomic operation and returns the index of the first one
+    template <typename ForwardIt>
+    size_type append(ForwardIt first, ForwardIt last);
+
+    // Element access without bounds checking; slot index must be ready
+    T& operator[](size_type index) noexcept { return *slot(index); }
+    const T& operator[](size_type index) const noexcept { return *slot(index); }
+
+    // Access with checking; throws std::out_of_range if slot index is not (yet) constructed
+    T& at(size_type index);
+    const T& at(size_type index) const;
+
+    // Number of reserved slots; slots near the end may still be under construction
+    size_type size() const noexcept { return m_size.load(std::memory_order_acquire); }
+
+    // True once the element in slot index is constructed and visible to this thread
+    bool ready(size_type index) const noexcept;
+
+    // Calls fn(index, element) for every ready element in index order, lock-free
+    template <typename Fn>
+    void for_each(Fn&& fn) const;
+
+    // Copies the longest prefix of ready elements into a MyVector (one reservation,
+    // memcpy per segment for trivially copyable T)
+    MyVector<T> snapshot() const;
+
+private:
+    // Segment number and offset within the segment for a slot index
+    static size_type segment_of(size_type index) noexcept;
+    static size_type segment_start(size_type segment) noexcept {
+        return first_segment_size * ((size_type{1} << segment) - 1);
+    }
+    static size_type segment_size(size_type segment) noexcept { return first_segment_size << segment; }
+
+    // Private helper: storage of a segment, allocated on first use by any thread
+    unsigned char* acquire_segment(size_type segment);
+
+    // Private helper: marks a segment whose storage is being allocated right now
+    static unsigned char* allocating() noexcept {
+        static unsigned char marker;
+        return &marker;
+    }
+
+    // Private helper: storage of a segment, nullptr while it is not published yet
+    unsigned char* published(size_type segment) const noexcept {
+        unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+        return block == allocating() ? nullptr : block;
+    }
+
+    // Private helper: the per-slot ready flags are stored behind the elements of a segment
+    static std::atomic<unsigned char>* flags(unsigned char* block, size_type segment) noexcept {
+        return reinterpret_cast<std::atomic<unsigned char>*>(block + segment_size(segment) * sizeof(T));
+    }
+
+    T* slot(size_type index) const noexcept {
+        const size_type segment = segment_of(index);
+        unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+        return reinterpret_cast<T*>(block) + (index - segment_start(segment));
+    }
+
+    std::atomic<size_type> m_size{0};                                   // number of reserved slots
+    std::array<std::atomic<unsigned char*>, max_segments> m_segments{}; // elements followed by ready flags
+};
+
+template <typename T>
+ConcurrentVector<T>::~ConcurrentVector() {
+    for (size_type segment = 0; segment < max_segments; ++segment) {
+        unsigned char* block = published(segment);
+        if (!block) continue;
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            std::atomic<unsigned char>* ready = flags(block, segment);
+            for (size_type i = 0; i < segment_size(segment); ++i) {
+                if (ready[i].load(std::memory_order_relaxed)) {
+                    reinterpret_cast<T*>(block)[i].~T();
+                }
+            }
+        }
+        ::operator delete(block, std::align_val_t(alignof(T)));
+    }
+}
+
+// The slot is reserved before anything else happens, so concurrent appends never wait on each other
+// except while the first thread to reach a new segment allocates it
+template <typename T>
+template <typename... Args>
+typename ConcurrentVector<T>::size_type ConcurrentVector<T>::emplace_back(Args&&... args) {
+    const size_type index = m_size.fetch_add(1, std::memory_order_relaxed);
+    const size_type segment = segment_of(index);
+    if (segment >= max_segments)
+        throw std::length_error("ConcurrentVector: maximum size exceeded");
+    unsigned char* block = acquire_segment(segment);
+    const size_type offset = index - segment_start(segment);
+    ::new (static_cast<void*>(reinterpret_cast<T*>(block) + offset)) T(std::forward<Args>(args)...);
+    flags(block, segment)[offset].store(1, std::memory_order_release);
+    return index;
+}
+
+template <typename T>
+template <typename ForwardIt>
+typename ConcurrentVector<T>::size_type ConcurrentVector<T>::append(ForwardIt first, ForwardIt last) {
+    const size_type count = static_cast<size_type>(std::distance(first, last));
+    const size_type start = m_size.fetch_add(count, std::memory_order_relaxed);
+    if (count && segment_of(start + count - 1) >= max_segments)
+        throw std::length_error("ConcurrentVector: maximum size exceeded");
+    size_type index = start;
+    while (index < start + count) {
+        // fill the part of the range that falls into one segment
+        const size_type segment = segment_of(index);
+        unsigned char* block = acquire_segment(segment);
+        std::atomic<unsigned char>* ready = flags(block, segment);
+        const size_type end = segment_start(segment) + segment_size(segment);
+        for (; index < start + count && index < end; ++index, ++first) {
+            const size_type offset = index - segment_start(segment);
+            ::new (static_cast<void*>(reinterpret_cast<T*>(block) + offset)) T(*first);
+            ready[offset].store(1, std::memory_order_release);
+        }
+    }
+    return start;
+}
+
+template <typename T>
+T& ConcurrentVector<T>::at(size_type index) {
+    if (!ready(index)) throw std::out_of_range("ConcurrentVector::at");
+    return *slot(index);
+}
+template <typename T>
+const T& ConcurrentVector<T>::at(size_type index) const {
+    if (!ready(index)) throw std::out_of_range("ConcurrentVector::at");
+    return *slot(index);
+}
+
+// Acquire on the flag pairs with the release store after construction
+template <typename T>
+bool ConcurrentVector<T>::ready(size_type index) const noexcept {
+    if (index >= size()) return false;
+    const size_type segment = segment_of(index);
+    unsigned char* block = published(segment);
+    return block && flags(block, segment)[index - segment_start(segment)].load(std::memory_order_acquire);
+}
+
+template <typename T>
+template <typename Fn>
+void ConcurrentVector<T>::for_each(Fn&& fn) const {
+    const size_type count = size();
+    for (size_type segment = 0; segment < max_segments && segment_start(segment) < count; ++segment) {
+        unsigned char* block = published(segment);
+        if (!block) continue; // reserved, but the segment is still being allocated
+        const std::atomic<unsigned char>* ready = flags(block, segment);
+        const size_type begin = segment_start(segment);
+        const size_type end = count < begin + segment_size(segment) ? count : begin + segment_size(segment);
+        for (size_type index = begin; index < end; ++index) {
+            if (ready[index - begin].load(std::memory_order_acquire)) {
+                fn(index, static_cast<const T&>(reinterpret_cast<const T*>(block)[index - begin]));
+            }
+        }
+    }
+}
+
+template <typename T>
+MyVector<T> ConcurrentVector<T>::snapshot() const {
+    const size_type count = size();
+    size_type prefix = 0;
+    while (prefix < count && ready(prefix)) {
+        ++prefix;
+    }
+    MyVector<T> result;
+    result.reserve(prefix);
+    for (size_type segment = 0; segment_start(segment) < prefix; ++segment) {
+        const T* data = reinterpret_cast<const T*>(m_segments[segment].load(std::memory_order_acquire));
+        const size_type begin = segment_start(segment);
+        const size_type end = prefix < begin + segment_size(segment) ? prefix : begin + segment_size(segment);
+        result.append(data, data + (end - begin));
+    }
+    return result;
+}
+
+// Segment k covers the indices [B * (2^k - 1), B * (2^(k+1) - 1)) with B = first_segment_size
+template <typename T>
+typename ConcurrentVector<T>::size_type ConcurrentVector<T>::segment_of(size_type index) noexcept {
+    const size_type scaled = index / first_segment_size + 1;
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_type>(sizeof(unsigned long long) * 8 - 1 -
+                                  __builtin_clzll(static_cast<unsigned long long>(scaled)));
+#else
+    size_type segment = 0;
+    while (scaled >> (segment + 1)) {
+        ++segment;
+    }
+    return segment;
+#endif
+}
+
+// The first thread to need a segment claims it with the allocating() marker, then allocates and
+// publishes it; threads that arrive meanwhile yield until the block is published instead of
+// allocating and zero-filling a block of their own
+template <typename T>
+unsigned char* ConcurrentVector<T>::acquire_segment(size_type segment) {
+    for (;;) {
+        unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+        if (block != nullptr && block != allocating()) return block;
+        if (block == nullptr && m_segments[segment].compare_exchange_strong(block, allocating(),
+                                                                            std::memory_order_acquire)) {
+            break;
+        }
+        std::this_thread::yield();
+    }
+
+    const size_type slots = segment_size(segment);
+    unsigned char* fresh = nullptr;
+    try {
+        fresh = static_cast<unsigned char*>(::operator new(slots * (sizeof(T) + 1), std::align_val_t(alignof(T))));
+    } catch (...) {
+        // give the next thread a chance to try again
+        m_segments[segment].store(nullptr, std::memory_order_release);
+        throw;
+    }
+    std::atomic<unsigned char>* ready = flags(fresh, segment);
+    for (size_type i = 0; i < slots; ++i) {
+        ::new (static_cast<void*>(ready + i)) std::atomic<unsigned char>(0);
+    }
+    m_segments[segment].store(fresh, std::memory_order_release);
+    return fresh;
+}
+
+#endif /* CONCURRENT_VECTOR_HPP */
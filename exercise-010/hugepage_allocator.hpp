@@ -0,0 +1,167 @@
+#ifndef HUGEPAGE_ALLOCATOR_HPP
+#define HUGEPAGE_ALLOCATOR_HPP
+
+#include <cstddef> // for size_t
+#include <cstdint> // for std::uintptr_t
+#include <cstring> // for std::memcpy
+#include <new>     // for std::bad_alloc, std::bad_array_new_length
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Allocator with a separate path for very large buffers
+ * @tparam T Element type
+ *
+ * Buffers of at least threshold() bytes are mapped directly with mmap, start on a
+ * huge page boundary and are marked for transparent huge pages (fewer TLB misses
+ * on scans). Such buffers grow with mremap, which moves page table entries
+ * instead of copying the data; MyVector uses reallocate() for trivially copyable
+ * element types. Smaller buffers use
+ * ::operator new as usual. On non-Linux systems every buffer takes the small path.
+ */
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    // 2 MiB, the size of a transparent huge page on x86-64
+    static constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+    static constexpr std::size_t default_threshold = huge_page_size;
+
+    HugePageAllocator() noexcept = default;
+    explicit HugePageAllocator(std::size_t threshold_bytes) noexcept : m_threshold(threshold_bytes) {}
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept : m_threshold(other.threshold()) {}
+
+    std::size_t threshold() const noexcept { return m_threshold; }
+
+    // True if a buffer of n elements is (or would be) memory-mapped
+    bool is_mapped(std::size_t n) const noexcept {
+#if defined(__linux__)
+        return n * sizeof(T) >= m_threshold;
+#else
+        (void)n;
+        return false;
+#endif
+    }
+
+    T* allocate(std::size_t n) {
+        if (n > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        if (is_mapped(n)) {
+            return map(n * sizeof(T));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (is_mapped(n)) {
+            unmap(ptr, n * sizeof(T));
+            return;
+        }
+        ::operator delete(ptr, n * sizeof(T), std::align_val_t(alignof(T)));
+    }
+
+    // Resizes a buffer of old_n elements to new_n elements and returns its (possibly
+    // new) address; the first min(old_n, new_n) elements are preserved bytewise.
+    // Mapped-to-mapped growth is done by mremap without copying: in place if the
+    // following pages are free, else into a fresh huge page aligned region.
+    T* reallocate(T* ptr, std::size_t old_n, std::size_t new_n) {
+#if defined(__linux__)
+        if (is_mapped(old_n) && is_mapped(new_n)) {
+            const std::size_t old_bytes = old_n * sizeof(T);
+            const std::size_t new_bytes = new_n * sizeof(T);
+            void* result = ::mremap(ptr, old_bytes, new_bytes, 0);
+            if (result == MAP_FAILED) {
+                void* target = map(new_bytes);
+                result = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+                if (result == MAP_FAILED) {
+                    unmap(static_cast<T*>(target), new_bytes);
+                    throw std::bad_alloc();
+                }
+            }
+            advise(result, new_bytes);
+            return static_cast<T*>(result);
+        }
+#endif
+        T* new_ptr = allocate(new_n);
+        std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr),
+                    (old_n < new_n ? old_n : new_n) * sizeof(T));
+        deallocate(ptr, old_n);
+        return new_ptr;
+    }
+
+    std::size_t max_size() const noexcept { return static_cast<std::size_t>(-1) / 2 / sizeof(T); }
+
+private:
+    // Maps one huge page more than needed, then unmaps the unaligned head and the
+    // rest of the tail, so the buffer starts on a huge page boundary
+    static T* map(std::size_t bytes) {
+#if defined(__linux__)
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t length = (bytes + page - 1) / page * page;
+        if (length > static_cast<std::size_t>(-1) - huge_page_size) {
+            throw std::bad_alloc();
+        }
+        const std::size_t reserved = length + huge_page_size;
+        void* raw = ::mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const auto begin = reinterpret_cast<std::uintptr_t>(raw);
+        const std::uintptr_t aligned = (begin + huge_page_size - 1) & ~std::uintptr_t{huge_page_size - 1};
+        const std::size_t head = aligned - begin;
+        if (head > 0) {
+            ::munmap(raw, head);
+        }
+        if (reserved - head > length) {
+            ::munmap(reinterpret_cast<void*>(aligned + length), reserved - head - length);
+        }
+        void* ptr = reinterpret_cast<void*>(aligned);
+        advise(ptr, bytes);
+        return static_cast<T*>(ptr);
+#else
+        (void)bytes;
+        throw std::bad_alloc();
+#endif
+    }
+
+    static void unmap(T* ptr, std::size_t bytes) noexcept {
+#if defined(__linux__)
+        ::munmap(ptr, bytes);
+#else
+        (void)ptr;
+        (void)bytes;
+#endif
+    }
+
+#if defined(__linux__)
+    // Ask for transparent huge pages; a kernel without THP simply ignores the hint
+    static void advise(void* ptr, std::size_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+        ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#else
+        (void)ptr;
+        (void)bytes;
+#endif
+    }
+#endif
+
+    std::size_t m_threshold = default_threshold;
+};
+
+// Allocators are interchangeable if they take the same path for every size
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>& lhs, const HugePageAllocator<U>& rhs) noexcept {
+    return lhs.threshold() == rhs.threshold();
+}
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>& lhs, const HugePageAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+#endif /* HUGEPAGE_ALLOCATOR_HPP */
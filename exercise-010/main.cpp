@@ -27,7 +27,7 @@ auto main(int argc, char **argv) -> int
 
     {
         // Create a MyVector object with default constructor (empty vector)
-        MyVector vec;
+        MyVector<int> vec;
         // Add two elements to the vector
         vec.push_back(42);
         vec.push_back(7);
@@ -37,7 +37,7 @@ auto main(int argc, char **argv) -> int
     } // 'vec' goes out of scope here and its destructor is called, freeing memory
 
     // Create a MyVector object with initial size of 5 elements
-    MyVector vec2(5);
+    MyVector<int> vec2(5);
     // Assign value 99 to the element at index 2 using operator[]
     vec2[2] = 99;
     fmt::println("vec2.size() = {}, vec2[2] = {}", vec2.size(), vec2[2]);
@@ -48,6 +48,15 @@ auto main(int argc, char **argv) -> int
     vec2.clear();
     fmt::println("After clear, vec2.size() = {}", vec2.size());
 
+    // Print the lifecycle counters (all zero unless built with -DMYVECTOR_TRACE=ON)
+    if (MyVectorTrace::enabled) {
+        const MyVectorStats stats = MyVectorTrace::stats();
+        fmt::println("MyVector stats: constructions = {}, copies = {}, moves = {}, reallocations = {}, "
+                     "bytes copied = {}, peak capacity = {}",
+                     stats.constructions, stats.copies, stats.moves, stats.reallocations, stats.bytes_copied,
+                     stats.peak_capacity);
+    }
+
     // Print an ending message
     fmt::println("Hello exercise number 3 after Vector");
     return 0;
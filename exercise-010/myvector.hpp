@@ -1,16 +1,271 @@
 #ifndef MY_VECTOR_HPP
 #define MY_VECTOR_HPP
 
-#include <cstddef>   // for size_t
-#include <stdexcept> // for std::out_of_range
+#include <algorithm>   // for std::rotate
+#include <cstddef>     // for size_t
+#include <cstring>     // for std::memcpy, std::memmove
+#include <functional>  // for std::less, std::less_equal
+#include <iterator>    // for std::iterator_traits, std::distance, std::reverse_iterator
+#include <memory>      // for std::allocator, std::allocator_traits
+#include <new>         // for placement new
+#include <stdexcept>   // for std::out_of_range, std::length_error
+#include <type_traits> // for std::is_trivially_copyable, std::void_t
+#include <utility>     // for std::forward, std::move, std::move_if_noexcept
 
+#include "myvector_trace.hpp"
+
+namespace myvector_detail {
+
+// Destroys the elements [first, first + count) through the allocator
+template <typename Alloc, typename T>
+void destroy_n(Alloc& alloc, T* first, std::size_t count) noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::allocator_traits<Alloc>::destroy(alloc, first + i);
+        }
+    }
+}
+
+// Moves 'count' elements from src into the uninitialized storage at dst and destroys the
+// originals. Trivially copyable types are relocated with a single memcpy, all other types
+// are moved if their move constructor is noexcept and copied otherwise, so that a throwing
+// element constructor leaves the source range untouched (strong exception guarantee).
+template <typename Alloc, typename T>
+void relocate(Alloc& alloc, T* src, std::size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (count) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    } else {
+        std::size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                std::allocator_traits<Alloc>::construct(alloc, dst + done, std::move_if_noexcept(src[done]));
+            }
+        } catch (...) {
+            destroy_n(alloc, dst, done);
+            throw;
+        }
+        destroy_n(alloc, src, count);
+    }
+}
+
+// Copies 'count' elements from src into the uninitialized storage at dst
+template <typename Alloc, typename T>
+void copy_construct(Alloc& alloc, const T* src, std::size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (count) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    } else {
+        std::size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                std::allocator_traits<Alloc>::construct(alloc, dst + done, src[done]);
+            }
+        } catch (...) {
+            destroy_n(alloc, dst, done);
+            throw;
+        }
+    }
+}
+
+// Value-initializes 'count' elements in the uninitialized storage at dst (ints become 0)
+template <typename Alloc, typename T>
+void value_construct(Alloc& alloc, T* dst, std::size_t count) {
+    std::size_t done = 0;
+    try {
+        for (; done < count; ++done) {
+            std::allocator_traits<Alloc>::construct(alloc, dst + done);
+        }
+    } catch (...) {
+        destroy_n(alloc, dst, done);
+        throw;
+    }
+}
+
+// True if It is T* or const T*, i.e. a range that may be copied bytewise or lie inside a MyVector<T>
+template <typename It, typename T>
+constexpr bool is_pointer_to =
+    std::is_pointer<It>::value && std::is_same<std::remove_cv_t<std::remove_pointer_t<It>>, T>::value;
+
+// Copies 'count' elements starting at iterator first into the uninitialized storage at dst.
+// Pointers to T take the memcpy path of copy_construct.
+template <typename Alloc, typename InputIt, typename T>
+void copy_construct_range(Alloc& alloc, InputIt first, std::size_t count, T* dst) {
+    if constexpr (is_pointer_to<InputIt, T>) {
+        copy_construct(alloc, static_cast<const T*>(first), count, dst);
+    } else {
+        std::size_t done = 0;
+        try {
+            for (; done < count; ++done, ++first) {
+                std::allocator_traits<Alloc>::construct(alloc, dst + done, *first);
+            }
+        } catch (...) {
+            destroy_n(alloc, dst, done);
+            throw;
+        }
+    }
+}
+
+// Default-initializes 'count' elements at dst: trivial types (int, double, ...) are left
+// uninitialized, so no memory is touched at all. Bypasses Alloc::construct on purpose,
+// allocator_traits::construct without arguments would value-initialize.
+template <typename Alloc, typename T>
+void default_construct(Alloc& alloc, T* dst, std::size_t count) {
+    if constexpr (!std::is_trivially_default_constructible<T>::value) {
+        std::size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                ::new (static_cast<void*>(dst + done)) T;
+            }
+        } catch (...) {
+            destroy_n(alloc, dst, done);
+            throw;
+        }
+    } else {
+        (void)alloc;
+        (void)dst;
+        (void)count;
+    }
+}
+
+// True for iterator types that support multi-pass traversal (and hence std::distance up front)
+template <typename It>
+constexpr bool is_forward_iterator =
+    std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+/**
+ * @brief Contiguous random-access iterator over MyVector storage
+ * @tparam T Element type, const T for the const_iterator
+ *
+ * A thin wrapper around T* rather than the raw pointer itself, so that an index
+ * argument such as insert(0, first, last) never competes with the iterator overload.
+ */
+template <typename T>
+class Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+#if defined(__cpp_lib_concepts)
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr Iterator() noexcept : m_ptr(nullptr) {}
+    constexpr explicit Iterator(T* ptr) noexcept : m_ptr(ptr) {}
+
+    // iterator converts to const_iterator, not the other way round
+    template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    constexpr Iterator(const Iterator<U>& other) noexcept : m_ptr(other.base()) {}
+
+    // Underlying pointer
+    constexpr T* base() const noexcept { return m_ptr; }
+
+    constexpr reference operator*() const noexcept { return *m_ptr; }
+    constexpr pointer operator->() const noexcept { return m_ptr; }
+    constexpr reference operator[](difference_type n) const noexcept { return m_ptr[n]; }
+
+    constexpr Iterator& operator++() noexcept { ++m_ptr; return *this; }
+    constexpr Iterator operator++(int) noexcept { return Iterator(m_ptr++); }
+    constexpr Iterator& operator--() noexcept { --m_ptr; return *this; }
+    constexpr Iterator operator--(int) noexcept { return Iterator(m_ptr--); }
+    constexpr Iterator& operator+=(difference_type n) noexcept { m_ptr += n; return *this; }
+    constexpr Iterator& operator-=(difference_type n) noexcept { m_ptr -= n; return *this; }
+
+    friend constexpr Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+    friend constexpr Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+    friend constexpr Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+
+private:
+    T* m_ptr;
+};
+
+// Distance and comparisons, also between iterator and const_iterator
+template <typename T, typename U>
+constexpr std::ptrdiff_t operator-(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() - rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator==(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() == rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator!=(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() != rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator<(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() < rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator>(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() > rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator<=(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() <= rhs.base();
+}
+template <typename T, typename U>
+constexpr bool operator>=(const Iterator<T>& lhs, const Iterator<U>& rhs) noexcept {
+    return lhs.base() >= rhs.base();
+}
+
+// True for MyVector iterators, which bulk operations unwrap to raw pointers (memcpy, alias checks)
+template <typename It>
+struct is_vector_iterator : std::false_type {};
+template <typename T>
+struct is_vector_iterator<Iterator<T>> : std::true_type {};
+
+// Detects allocators that can resize a buffer in place (e.g. via mremap), see HugePageAllocator
+template <typename Alloc, typename T, typename = void>
+struct has_reallocate : std::false_type {};
+template <typename Alloc, typename T>
+struct has_reallocate<Alloc, T,
+                      std::void_t<decltype(std::declval<Alloc&>().reallocate(
+                          std::declval<T*>(), std::declval<std::size_t>(), std::declval<std::size_t>()))>>
+    : std::true_type {};
+
+} // namespace myvector_detail
+
+/**
+ * @brief Dynamic array built on raw, uninitialized storage
+ * @tparam T Element type
+ * @tparam Alloc Allocator used for the element storage
+ * @tparam Trace Lifecycle trace policy (NoTrace or CountingTrace), see myvector_trace.hpp
+ *
+ * Storage is obtained from the allocator without initializing it, elements are
+ * constructed only where they are needed. Growth relocates the existing elements,
+ * with memcpy for trivially copyable types and move-if-noexcept otherwise. If the
+ * allocator offers reallocate(ptr, old_n, new_n), trivially copyable elements are
+ * grown through it instead (e.g. mremap for huge buffers).
+ */
+template <typename T, typename Alloc = std::allocator<T>, typename Trace = MyVectorTrace>
 class MyVector {
+    using alloc_traits = std::allocator_traits<Alloc>;
+
 public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+    using iterator = myvector_detail::Iterator<T>;
+    using const_iterator = myvector_detail::Iterator<const T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
     // Default constructor: creates empty vector with zero size and capacity
-    MyVector();
+    MyVector() noexcept(noexcept(Alloc())) : MyVector(Alloc()) {}
+    explicit MyVector(const Alloc& alloc) noexcept;
 
-    // Constructor with initial size: allocates storage for 'size' elements
-    MyVector(unsigned int size);
+    // Constructor with initial size: allocates storage for 'size' value-initialized elements
+    explicit MyVector(size_type size, const Alloc& alloc = Alloc());
 
     // Copy constructor for deep copying another MyVector
     MyVector(const MyVector& other);
@@ -18,42 +273,539 @@ public:
     // Copy assignment operator for deep copying with self-assignment check
     MyVector& operator=(const MyVector& other);
 
-    // Destructor frees allocated memory
+    // Move constructor: takes over the buffer of other without allocating
+    MyVector(MyVector&& other) noexcept;
+
+    // Move assignment operator: releases own storage and takes over the buffer of other
+    MyVector& operator=(MyVector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                   alloc_traits::is_always_equal::value);
+
+    // Exchanges the contents of two vectors in O(1) (pointer swap, no allocation)
+    void swap(MyVector& other) noexcept;
+
+    // Destructor destroys the elements and frees allocated memory
     ~MyVector();
 
     // Adds an element to the end of the vector, resizing if needed
-    void push_back(int value);
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Constructs an element in place at the end of the vector and returns a reference to it
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
 
     // Access element with bounds checking; throws std::out_of_range if invalid
-    int& at(size_t index);
-    const int& at(size_t index) const;
+    T& at(size_t index);
+    const T& at(size_t index) const;
 
     // Access element without bounds checking (like operator[])
-    int& operator[](size_t index) { return m_data[index]; }
-    const int& operator[](size_t index) const { return m_data[index]; }
+    T& operator[](size_t index) { return m_data[index]; }
+    const T& operator[](size_t index) const { return m_data[index]; }
+
+    // Direct access to the contiguous element storage (nullptr while nothing is allocated)
+    T* data() noexcept { return m_data; }
+    const T* data() const noexcept { return m_data; }
+
+    // Iterators for <algorithm>, range-based for and the parallel algorithms
+    iterator begin() noexcept { return iterator(m_data); }
+    const_iterator begin() const noexcept { return const_iterator(m_data); }
+    iterator end() noexcept { return iterator(m_data + m_size); }
+    const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Returns true if the vector holds no elements
+    bool empty() const noexcept { return m_size == 0; }
 
     // Returns current number of elements stored
-    unsigned int size() const noexcept;
+    size_type size() const noexcept { return m_size; }
 
     // Returns current capacity (allocated storage size)
-    unsigned int capacity() const noexcept;
+    size_type capacity() const noexcept { return m_capacity; }
+
+    // Returns the largest possible number of elements
+    size_type max_size() const noexcept { return alloc_traits::max_size(m_alloc); }
 
-    // Allocates storage to hold at least new_cap elements
-    void reserve(unsigned int new_cap);
+    // Returns a copy of the allocator
+    allocator_type get_allocator() const noexcept { return m_alloc; }
 
-    // Changes the size to new_size, default-filling new elements if enlarged
-    void resize(unsigned int new_size);
+    // Allocates storage to hold at least new_cap elements; throws std::length_error above max_size()
+    void reserve(size_type new_cap);
+
+    // Changes the size to new_size, value-initializing new elements if enlarged
+    void resize(size_type new_size);
+
+    // Like resize(), but new elements are default-initialized: for trivial types such as
+    // int the memory is left as is, meant for buffers that are overwritten next (e.g. by read())
+    void resize_default_init(size_type new_size);
+
+    // Appends the elements of [first, last); forward ranges reserve the storage once up front
+    template <typename InputIt>
+    void append(InputIt first, InputIt last);
+
+    // Inserts the elements of [first, last) before index pos and returns pos;
+    // throws std::out_of_range if pos > size()
+    template <typename InputIt>
+    size_type insert(size_type pos, InputIt first, InputIt last);
+
+    // Iterator form of insert(): returns an iterator to the first inserted element
+    template <typename InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        return begin() + static_cast<difference_type>(insert(static_cast<size_type>(pos - cbegin()), first, last));
+    }
 
     // Clears the vector (size becomes zero, capacity unchanged)
     void clear() noexcept;
 
 private:
-    // Private helper: reallocate storage to new capacity and copy existing data
-    void reallocate(unsigned int new_cap);
+    // Private helper: reallocate storage to new capacity and relocate existing data
+    void reallocate(size_type new_cap);
+
+    // Private helper: destroys all elements and returns the storage to the allocator
+    void release() noexcept;
+
+    // Private helper: constructs 'count' new elements via construct(T* dst) at the end of a
+    // fresh buffer of new_cap elements, then relocates the existing elements in front of them
+    template <typename Construct>
+    void grow_and_construct(size_type new_cap, size_type count, Construct construct);
+
+    // Private helper: true unless first is a pointer that provably lies outside the elements
+    template <typename InputIt>
+    bool may_alias(InputIt first) const noexcept;
+
+    // Growth policy: double capacity or start at 1, clamped to max_size()
+    size_type next_capacity() const;
 
-    int* m_data;              // pointer to dynamically allocated array
-    unsigned int m_size;      // current number of elements
-    unsigned int m_capacity;  // allocated capacity of array
+    // Growth policy for bulk operations: at least 'required', at least next_capacity()
+    size_type next_capacity(size_type required) const;
+
+    // Elements are resized through Alloc::reallocate when the allocator offers it
+    static constexpr bool grows_in_place =
+        myvector_detail::has_reallocate<Alloc, T>::value && std::is_trivially_copyable<T>::value;
+
+    T* m_data;               // pointer to allocated, partially constructed storage
+    size_type m_size;        // current number of constructed elements
+    size_type m_capacity;    // allocated capacity of storage
+    Alloc m_alloc;           // allocator providing the storage
 };
 
+// Non-member swap so that `using std::swap; swap(a, b);` picks the O(1) version
+template <typename T, typename Alloc, typename Trace>
+void swap(MyVector<T, Alloc, Trace>& lhs, MyVector<T, Alloc, Trace>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Constructor with allocator initializes empty vector with no allocated data
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>::MyVector(const Alloc& alloc) noexcept
+    : m_data(nullptr), m_size(0), m_capacity(0), m_alloc(alloc)
+{
+    Trace::on_construct();
+}
+
+// Constructor with initial size, allocates memory for 'size' elements, value-initialized
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>::MyVector(size_type size, const Alloc& alloc)
+    : m_data(nullptr), m_size(0), m_capacity(0), m_alloc(alloc)
+{
+    if (size) {
+        m_data = alloc_traits::allocate(m_alloc, size);
+        m_capacity = size;
+        try {
+            myvector_detail::value_construct(m_alloc, m_data, size);
+        } catch (...) {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+            throw;
+        }
+        m_size = size;
+    }
+    Trace::on_construct();
+    Trace::on_capacity(m_capacity);
+}
+
+// Copy constructor performs deep copy of other's data
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>::MyVector(const MyVector& other)
+    : m_data(nullptr), m_size(0), m_capacity(0),
+      m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+{
+    if (other.m_capacity) {
+        m_data = alloc_traits::allocate(m_alloc, other.m_capacity);
+        m_capacity = other.m_capacity;
+        try {
+            myvector_detail::copy_construct(m_alloc, other.m_data, other.m_size, m_data);
+        } catch (...) {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+            throw;
+        }
+        m_size = other.m_size;
+    }
+    Trace::on_construct();
+    Trace::on_copy(m_size * sizeof(T));
+    Trace::on_capacity(m_capacity);
+}
+
+// Copy assignment operator with self-assignment check, deep copies data.
+// The existing buffer is reused when it is large enough.
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>& MyVector<T, Alloc, Trace>::operator=(const MyVector& other) {
+    if (this != &other) {
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (m_alloc != other.m_alloc) {
+                release();
+            }
+            m_alloc = other.m_alloc;
+        }
+        if (other.m_size > m_capacity) {
+            // copy into a fresh buffer first, so *this stays untouched if a copy throws
+            T* new_data = alloc_traits::allocate(m_alloc, other.m_capacity);
+            try {
+                myvector_detail::copy_construct(m_alloc, other.m_data, other.m_size, new_data);
+            } catch (...) {
+                alloc_traits::deallocate(m_alloc, new_data, other.m_capacity);
+                throw;
+            }
+            release();
+            m_data = new_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+        } else {
+            clear();
+            myvector_detail::copy_construct(m_alloc, other.m_data, other.m_size, m_data);
+            m_size = other.m_size;
+        }
+        Trace::on_copy(m_size * sizeof(T));
+        Trace::on_capacity(m_capacity);
+    }
+    return *this;
+}
+
+// Move constructor steals the buffer of other and leaves it empty
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>::MyVector(MyVector&& other) noexcept
+    : m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity), m_alloc(std::move(other.m_alloc))
+{
+    Trace::on_construct();
+    Trace::on_move();
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
+
+// Move assignment operator releases own storage and steals the buffer of other.
+// Only an allocator that neither propagates nor compares equal forces an element-wise move.
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>& MyVector<T, Alloc, Trace>::operator=(MyVector&& other) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+{
+    if (this != &other) {
+        constexpr bool steal = alloc_traits::propagate_on_container_move_assignment::value ||
+                               alloc_traits::is_always_equal::value;
+        if (steal || m_alloc == other.m_alloc) {
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                m_alloc = std::move(other.m_alloc);
+            }
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_capacity = 0;
+        } else {
+            clear();
+            reserve(other.m_size);
+            for (size_type i = 0; i < other.m_size; ++i) {
+                alloc_traits::construct(m_alloc, m_data + i, std::move(other.m_data[i]));
+                ++m_size;
+            }
+            other.clear();
+        }
+        Trace::on_move();
+    }
+    return *this;
+}
+
+// Swaps pointers and bookkeeping with other, no element is copied
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::swap(MyVector& other) noexcept {
+    using std::swap;
+    swap(m_data, other.m_data);
+    swap(m_size, other.m_size);
+    swap(m_capacity, other.m_capacity);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        swap(m_alloc, other.m_alloc);
+    }
+}
+
+// Destructor destroys the elements and releases allocated memory
+template <typename T, typename Alloc, typename Trace>
+MyVector<T, Alloc, Trace>::~MyVector() {
+    Trace::on_destruct();
+    release();
+}
+
+// Constructs the new element first, so arguments referring into the vector stay valid
+// while the buffer is relocated on growth
+template <typename T, typename Alloc, typename Trace>
+template <typename... Args>
+T& MyVector<T, Alloc, Trace>::emplace_back(Args&&... args) {
+    if (m_size < m_capacity) {
+        alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+        return m_data[m_size++];
+    }
+    if constexpr (grows_in_place) {
+        T tmp(std::forward<Args>(args)...); // args may refer to an element of *this
+        reallocate(next_capacity());
+        alloc_traits::construct(m_alloc, m_data + m_size, tmp);
+        return m_data[m_size++];
+    }
+    grow_and_construct(next_capacity(), 1,
+                       [&](T* dst) { alloc_traits::construct(m_alloc, dst, std::forward<Args>(args)...); });
+    return m_data[m_size++];
+}
+
+// Returns a reference to element at index with bounds checking
+template <typename T, typename Alloc, typename Trace>
+T& MyVector<T, Alloc, Trace>::at(size_t index) {
+    if (index >= m_size) throw std::out_of_range("MyVector::at");
+    return m_data[index];
+}
+template <typename T, typename Alloc, typename Trace>
+const T& MyVector<T, Alloc, Trace>::at(size_t index) const {
+    if (index >= m_size) throw std::out_of_range("MyVector::at");
+    return m_data[index];
+}
+
+// Reserves memory for at least new_cap elements, reallocates if needed
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::reserve(size_type new_cap) {
+    if (new_cap > max_size())
+        throw std::length_error("MyVector::reserve");
+    if (new_cap > m_capacity)
+        reallocate(new_cap);
+}
+
+// Resizes the vector to new_size, value-initializes extended elements (0 for int)
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::resize(size_type new_size) {
+    if (new_size > m_size) {
+        if (new_size > m_capacity)
+            reserve(new_size);
+        myvector_detail::value_construct(m_alloc, m_data + m_size, new_size - m_size);
+    } else {
+        myvector_detail::destroy_n(m_alloc, m_data + new_size, m_size - new_size);
+    }
+    m_size = new_size;
+}
+
+// Resizes the vector to new_size without initializing extended trivial elements
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::resize_default_init(size_type new_size) {
+    if (new_size > m_size) {
+        if (new_size > m_capacity)
+            reserve(new_size);
+        myvector_detail::default_construct(m_alloc, m_data + m_size, new_size - m_size);
+    } else {
+        myvector_detail::destroy_n(m_alloc, m_data + new_size, m_size - new_size);
+    }
+    m_size = new_size;
+}
+
+// Forward ranges are measured first, so there is at most one reallocation and no per-element
+// capacity check. Single-pass ranges (e.g. std::istream_iterator) fall back to emplace_back.
+template <typename T, typename Alloc, typename Trace>
+template <typename InputIt>
+void MyVector<T, Alloc, Trace>::append(InputIt first, InputIt last) {
+    if constexpr (myvector_detail::is_vector_iterator<InputIt>::value) {
+        append(first.base(), last.base());
+    } else if constexpr (!myvector_detail::is_forward_iterator<InputIt>) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } else {
+        const size_type count = static_cast<size_type>(std::distance(first, last));
+        if (count > max_size() - m_size)
+            throw std::length_error("MyVector::append");
+        if (m_size + count > m_capacity) {
+            const size_type new_cap = next_capacity(m_size + count);
+            if (!grows_in_place || may_alias(first)) {
+                // the range may point into the old buffer: copy it before relocating
+                grow_and_construct(new_cap, count, [&](T* dst) {
+                    myvector_detail::copy_construct_range(m_alloc, first, count, dst);
+                });
+                m_size += count;
+                return;
+            }
+            reallocate(new_cap);
+        }
+        myvector_detail::copy_construct_range(m_alloc, first, count, m_data + m_size);
+        m_size += count;
+    }
+}
+
+// Trivially copyable elements from a foreign array are placed with memmove/memcpy; on growth
+// prefix, new elements and suffix are copied straight to their final position. Everything
+// else is appended and rotated into place, which only gives the basic exception guarantee
+// if a move constructor or assignment throws (same as std::vector).
+template <typename T, typename Alloc, typename Trace>
+template <typename InputIt>
+typename MyVector<T, Alloc, Trace>::size_type MyVector<T, Alloc, Trace>::insert(size_type pos, InputIt first,
+                                                                                 InputIt last) {
+    if (pos > m_size)
+        throw std::out_of_range("MyVector::insert");
+    if constexpr (myvector_detail::is_vector_iterator<InputIt>::value) {
+        return insert(pos, first.base(), last.base());
+    }
+    if constexpr (std::is_trivially_copyable<T>::value && myvector_detail::is_pointer_to<InputIt, T>) {
+        if (!may_alias(first)) {
+            const size_type count = static_cast<size_type>(last - first);
+            if (count > max_size() - m_size)
+                throw std::length_error("MyVector::insert");
+            const size_type tail = m_size - pos;
+            if (m_size + count > m_capacity && !grows_in_place) {
+                const size_type new_cap = next_capacity(m_size + count);
+                T* new_data = alloc_traits::allocate(m_alloc, new_cap);
+                myvector_detail::copy_construct(m_alloc, m_data, pos, new_data);
+                myvector_detail::copy_construct(m_alloc, m_data + pos, tail, new_data + pos + count);
+                Trace::on_reallocate(m_size * sizeof(T), new_cap);
+                if (m_data) {
+                    alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+                }
+                m_data = new_data;
+                m_capacity = new_cap;
+            } else {
+                if (m_size + count > m_capacity)
+                    reallocate(next_capacity(m_size + count));
+                if (tail && count) {
+                    std::memmove(static_cast<void*>(m_data + pos + count), static_cast<const void*>(m_data + pos),
+                                 tail * sizeof(T));
+                }
+            }
+            myvector_detail::copy_construct(m_alloc, static_cast<const T*>(first), count, m_data + pos);
+            m_size += count;
+            return pos;
+        }
+    }
+    const size_type old_size = m_size;
+    append(first, last);
+    std::rotate(m_data + pos, m_data + old_size, m_data + m_size);
+    return pos;
+}
+
+// Destroys all elements by setting size to zero (capacity is unchanged)
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::clear() noexcept {
+    myvector_detail::destroy_n(m_alloc, m_data, m_size);
+    m_size = 0;
+}
+
+// Private helper reallocates uninitialized storage and relocates existing elements into it.
+// The new buffer is not zero-filled, every byte is written exactly once.
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::reallocate(size_type new_cap) {
+    if constexpr (grows_in_place) {
+        if (m_data) {
+            Trace::on_reallocate(0, new_cap); // the allocator resizes the buffer itself
+            m_data = m_alloc.reallocate(m_data, m_capacity, new_cap);
+            m_capacity = new_cap;
+            return;
+        }
+    }
+    Trace::on_reallocate(m_size * sizeof(T), new_cap);
+    T* new_data = alloc_traits::allocate(m_alloc, new_cap);
+    try {
+        myvector_detail::relocate(m_alloc, m_data, m_size, new_data);
+    } catch (...) {
+        alloc_traits::deallocate(m_alloc, new_data, new_cap);
+        throw;
+    }
+    if (m_data) {
+        alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+    }
+    m_data = new_data;
+    m_capacity = new_cap;
+}
+
+// Shared growth path of emplace_back and append. The new elements are constructed before the
+// old ones are relocated, so arguments referring into the old buffer stay valid, and a
+// throwing constructor leaves *this untouched.
+template <typename T, typename Alloc, typename Trace>
+template <typename Construct>
+void MyVector<T, Alloc, Trace>::grow_and_construct(size_type new_cap, size_type count, Construct construct) {
+    T* new_data = alloc_traits::allocate(m_alloc, new_cap);
+    try {
+        construct(new_data + m_size);
+    } catch (...) {
+        alloc_traits::deallocate(m_alloc, new_data, new_cap);
+        throw;
+    }
+    try {
+        myvector_detail::relocate(m_alloc, m_data, m_size, new_data);
+    } catch (...) {
+        myvector_detail::destroy_n(m_alloc, new_data + m_size, count);
+        alloc_traits::deallocate(m_alloc, new_data, new_cap);
+        throw;
+    }
+    Trace::on_reallocate(m_size * sizeof(T), new_cap);
+    if (m_data) {
+        alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+    }
+    m_data = new_data;
+    m_capacity = new_cap;
+}
+
+// Only raw pointers can be checked; std::less gives a total order even across unrelated arrays
+template <typename T, typename Alloc, typename Trace>
+template <typename InputIt>
+bool MyVector<T, Alloc, Trace>::may_alias(InputIt first) const noexcept {
+    if constexpr (myvector_detail::is_pointer_to<InputIt, T>) {
+        const T* p = first;
+        return std::less_equal<const T*>()(m_data, p) && std::less<const T*>()(p, m_data + m_size);
+    } else if constexpr (std::is_pointer<InputIt>::value) {
+        (void)first;
+        return false; // pointer to another type, cannot point into our elements
+    } else {
+        (void)first;
+        return true;
+    }
+}
+
+// Doubling would overflow long before memory runs out with a 32 bit size, hence the explicit checks
+template <typename T, typename Alloc, typename Trace>
+typename MyVector<T, Alloc, Trace>::size_type MyVector<T, Alloc, Trace>::next_capacity() const {
+    const size_type limit = max_size();
+    if (m_capacity >= limit)
+        throw std::length_error("MyVector: maximum size exceeded");
+    if (m_capacity > limit / 2)
+        return limit;
+    return m_capacity ? m_capacity * 2 : 1;
+}
+
+// Bulk growth keeps the doubling, so repeated appends of small ranges stay amortized O(1)
+template <typename T, typename Alloc, typename Trace>
+typename MyVector<T, Alloc, Trace>::size_type MyVector<T, Alloc, Trace>::next_capacity(size_type required) const {
+    if (required > max_size())
+        throw std::length_error("MyVector: maximum size exceeded");
+    const size_type doubled = m_capacity > max_size() / 2 ? max_size() : (m_capacity ? m_capacity * 2 : 1);
+    return doubled > required ? doubled : required;
+}
+
+// Private helper destroys the elements and gives the storage back to the allocator
+template <typename T, typename Alloc, typename Trace>
+void MyVector<T, Alloc, Trace>::release() noexcept {
+    clear();
+    if (m_data) {
+        alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+    }
+    m_data = nullptr;
+    m_capacity = 0;
+}
+
 #endif /* MY_VECTOR_HPP */
@@ -0,0 +1,77 @@
+#ifndef MY_VECTOR_PARALLEL_HPP
+#define MY_VECTOR_PARALLEL_HPP
+
+#include <algorithm>  // for std::sort, std::transform
+#include <functional> // for std::less, std::plus
+#include <numeric>    // for std::reduce
+
+#if MYVECTOR_PARALLEL_STL
+#include <execution>  // for std::execution::par_unseq
+#endif
+
+#include "myvector.hpp"
+
+/**
+ * Parallel entry points for MyVector on top of the C++17 parallel algorithms.
+ *
+ * With MYVECTOR_PARALLEL_STL=1 the calls run with std::execution::par_unseq
+ * (CMake sets it when TBB is found, libstdc++ uses TBB as its backend); without
+ * it they fall back to the sequential algorithms with the same results. The
+ * element operations must be free of data races and must not throw, since
+ * par_unseq calls std::terminate on an escaping exception.
+ */
+namespace parallel {
+
+// True if the algorithms below actually run on several threads
+#if MYVECTOR_PARALLEL_STL
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+// Sorts the elements with comp (not stable)
+template <typename T, typename Alloc, typename Trace, typename Compare = std::less<>>
+void sort(MyVector<T, Alloc, Trace>& v, Compare comp = Compare()) {
+#if MYVECTOR_PARALLEL_STL
+    std::sort(std::execution::par_unseq, v.begin(), v.end(), comp);
+#else
+    std::sort(v.begin(), v.end(), comp);
+#endif
+}
+
+// Combines all elements and init with op in unspecified order; op must be associative and
+// commutative. Pass a wider init (e.g. 0LL for MyVector<int>) to avoid overflow.
+template <typename T, typename Alloc, typename Trace, typename U = T, typename BinaryOp = std::plus<>>
+U reduce(const MyVector<T, Alloc, Trace>& v, U init = U(), BinaryOp op = BinaryOp()) {
+#if MYVECTOR_PARALLEL_STL
+    return std::reduce(std::execution::par_unseq, v.begin(), v.end(), init, op);
+#else
+    return std::reduce(v.begin(), v.end(), init, op);
+#endif
+}
+
+// Applies v[i] = op(v[i]) in place
+template <typename T, typename Alloc, typename Trace, typename UnaryOp>
+void transform(MyVector<T, Alloc, Trace>& v, UnaryOp op) {
+#if MYVECTOR_PARALLEL_STL
+    std::transform(std::execution::par_unseq, v.begin(), v.end(), v.begin(), op);
+#else
+    std::transform(v.begin(), v.end(), v.begin(), op);
+#endif
+}
+
+// Stores op(in[i]) in out[i]; out is resized to in.size() without zero-filling first
+template <typename T, typename Alloc, typename Trace, typename U, typename Alloc2, typename Trace2,
+          typename UnaryOp>
+void transform(const MyVector<T, Alloc, Trace>& in, MyVector<U, Alloc2, Trace2>& out, UnaryOp op) {
+    out.resize_default_init(in.size());
+#if MYVECTOR_PARALLEL_STL
+    std::transform(std::execution::par_unseq, in.begin(), in.end(), out.begin(), op);
+#else
+    std::transform(in.begin(), in.end(), out.begin(), op);
+#endif
+}
+
+} // namespace parallel
+
+#endif /* MY_VECTOR_PARALLEL_HPP */
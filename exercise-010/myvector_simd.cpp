@@ -0,0 +1,432 @@
+#include "myvector_simd.hpp"
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MYVECTOR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd {
+namespace {
+
+// One function pointer per kernel, filled for each instruction set
+struct Kernels {
+    long long (*sum)(const int*, std::size_t);
+    int (*min)(const int*, std::size_t);
+    int (*max)(const int*, std::size_t);
+    std::size_t (*find)(const int*, std::size_t, int);
+    std::size_t (*count)(const int*, std::size_t, int);
+    void (*fill)(int*, std::size_t, int);
+    void (*transform_scalar)(int*, const int*, int, std::size_t, Op);
+    void (*transform_vector)(int*, const int*, const int*, std::size_t, Op);
+};
+
+// Wrap-around arithmetic without signed overflow UB
+int apply(int a, int b, Op op) noexcept {
+    const auto ua = static_cast<unsigned int>(a);
+    const auto ub = static_cast<unsigned int>(b);
+    switch (op) {
+        case Op::Add: return static_cast<int>(ua + ub);
+        case Op::Sub: return static_cast<int>(ua - ub);
+        case Op::Mul: return static_cast<int>(ua * ub);
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Portable scalar kernels, also used for the tails of the vector kernels
+// ---------------------------------------------------------------------------
+
+long long sum_scalar(const int* data, std::size_t n) {
+    long long total = 0;
+    for (std::size_t i = 0; i < n; ++i) total += data[i];
+    return total;
+}
+
+int min_scalar(const int* data, std::size_t n) {
+    int result = INT_MAX;
+    for (std::size_t i = 0; i < n; ++i) result = data[i] < result ? data[i] : result;
+    return result;
+}
+
+int max_scalar(const int* data, std::size_t n) {
+    int result = INT_MIN;
+    for (std::size_t i = 0; i < n; ++i) result = data[i] > result ? data[i] : result;
+    return result;
+}
+
+std::size_t find_scalar(const int* data, std::size_t n, int value) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (data[i] == value) return i;
+    }
+    return n;
+}
+
+std::size_t count_scalar(const int* data, std::size_t n, int value) {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < n; ++i) result += data[i] == value;
+    return result;
+}
+
+void fill_scalar(int* data, std::size_t n, int value) {
+    for (std::size_t i = 0; i < n; ++i) data[i] = value;
+}
+
+// The switch stays outside the loops so that each loop body is branch-free
+void transform_scalar_scalar(int* dst, const int* a, int b, std::size_t n, Op op) {
+    switch (op) {
+        case Op::Add: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b, Op::Add); break;
+        case Op::Sub: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b, Op::Sub); break;
+        case Op::Mul: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b, Op::Mul); break;
+    }
+}
+
+void transform_vector_scalar(int* dst, const int* a, const int* b, std::size_t n, Op op) {
+    switch (op) {
+        case Op::Add: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b[i], Op::Add); break;
+        case Op::Sub: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b[i], Op::Sub); break;
+        case Op::Mul: for (std::size_t i = 0; i < n; ++i) dst[i] = apply(a[i], b[i], Op::Mul); break;
+    }
+}
+
+constexpr Kernels scalar_kernels{sum_scalar,   min_scalar,  max_scalar,
+                                 find_scalar,  count_scalar, fill_scalar,
+                                 transform_scalar_scalar,   transform_vector_scalar};
+
+#if defined(MYVECTOR_SIMD_X86)
+
+// ---------------------------------------------------------------------------
+// SSE4.1 kernels: 4 ints per register
+// ---------------------------------------------------------------------------
+
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+
+TARGET_SSE41 long long sum_sse41(const int* data, std::size_t n) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(v));
+        acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + sum_scalar(data + i, n - i);
+}
+
+TARGET_SSE41 int min_sse41(const int* data, std::size_t n) {
+    __m128i acc = _mm_set1_epi32(INT_MAX);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_min_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    const int tail = min_scalar(data + i, n - i);
+    return min_scalar(lanes, 4) < tail ? min_scalar(lanes, 4) : tail;
+}
+
+TARGET_SSE41 int max_sse41(const int* data, std::size_t n) {
+    __m128i acc = _mm_set1_epi32(INT_MIN);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_max_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    const int tail = max_scalar(data + i, n - i);
+    return max_scalar(lanes, 4) > tail ? max_scalar(lanes, 4) : tail;
+}
+
+TARGET_SSE41 std::size_t find_sse41(const int* data, std::size_t n, int value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+    }
+    return i + find_scalar(data + i, n - i, value);
+}
+
+TARGET_SSE41 std::size_t count_sse41(const int* data, std::size_t n, int value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    std::size_t result = 0;
+    std::size_t i = 0;
+    while (i + 4 <= n) {
+        // 32 bit lane counters are flushed before they can overflow
+        __m128i acc = _mm_setzero_si128();
+        const std::size_t block_end = (n - i) / 4 > (1u << 30) ? i + (std::size_t{1} << 32) : n;
+        for (; i + 4 <= block_end; i += 4) {
+            const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+            acc = _mm_sub_epi32(acc, eq); // eq lanes are -1
+        }
+        alignas(16) unsigned int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        result += std::size_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+    }
+    return result + count_scalar(data + i, n - i, value);
+}
+
+TARGET_SSE41 void fill_sse41(int* data, std::size_t n, int value) {
+    const __m128i v = _mm_set1_epi32(value);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+    }
+    fill_scalar(data + i, n - i, value);
+}
+
+TARGET_SSE41 __m128i apply_sse41(__m128i a, __m128i b, Op op) {
+    switch (op) {
+        case Op::Add: return _mm_add_epi32(a, b);
+        case Op::Sub: return _mm_sub_epi32(a, b);
+        case Op::Mul: return _mm_mullo_epi32(a, b);
+    }
+    return a;
+}
+
+TARGET_SSE41 void transform_scalar_sse41(int* dst, const int* a, int b, std::size_t n, Op op) {
+    const __m128i vb = _mm_set1_epi32(b);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), apply_sse41(va, vb, op));
+    }
+    transform_scalar_scalar(dst + i, a + i, b, n - i, op);
+}
+
+TARGET_SSE41 void transform_vector_sse41(int* dst, const int* a, const int* b, std::size_t n, Op op) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), apply_sse41(va, vb, op));
+    }
+    transform_vector_scalar(dst + i, a + i, b + i, n - i, op);
+}
+
+constexpr Kernels sse41_kernels{sum_sse41,   min_sse41,   max_sse41,
+                                find_sse41,  count_sse41, fill_sse41,
+                                transform_scalar_sse41,   transform_vector_sse41};
+
+// ---------------------------------------------------------------------------
+// AVX2 kernels: 8 ints per register
+// ---------------------------------------------------------------------------
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+TARGET_AVX2 long long sum_avx2(const int* data, std::size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(data + i, n - i);
+}
+
+TARGET_AVX2 int min_avx2(const int* data, std::size_t n) {
+    __m256i acc = _mm256_set1_epi32(INT_MAX);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    const int tail = min_scalar(data + i, n - i);
+    return min_scalar(lanes, 8) < tail ? min_scalar(lanes, 8) : tail;
+}
+
+TARGET_AVX2 int max_avx2(const int* data, std::size_t n) {
+    __m256i acc = _mm256_set1_epi32(INT_MIN);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    const int tail = max_scalar(data + i, n - i);
+    return max_scalar(lanes, 8) > tail ? max_scalar(lanes, 8) : tail;
+}
+
+TARGET_AVX2 std::size_t find_avx2(const int* data, std::size_t n, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i eq =
+            _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+    }
+    return i + find_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 std::size_t count_avx2(const int* data, std::size_t n, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    std::size_t result = 0;
+    std::size_t i = 0;
+    while (i + 8 <= n) {
+        // 32 bit lane counters are flushed before they can overflow
+        __m256i acc = _mm256_setzero_si256();
+        const std::size_t block_end = (n - i) / 8 > (1u << 30) ? i + (std::size_t{1} << 33) : n;
+        for (; i + 8 <= block_end; i += 8) {
+            const __m256i eq =
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+            acc = _mm256_sub_epi32(acc, eq); // eq lanes are -1
+        }
+        alignas(32) unsigned int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (unsigned int lane : lanes) result += lane;
+    }
+    return result + count_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 void fill_avx2(int* data, std::size_t n, int value) {
+    const __m256i v = _mm256_set1_epi32(value);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), v);
+    }
+    fill_scalar(data + i, n - i, value);
+}
+
+TARGET_AVX2 __m256i apply_avx2(__m256i a, __m256i b, Op op) {
+    switch (op) {
+        case Op::Add: return _mm256_add_epi32(a, b);
+        case Op::Sub: return _mm256_sub_epi32(a, b);
+        case Op::Mul: return _mm256_mullo_epi32(a, b);
+    }
+    return a;
+}
+
+TARGET_AVX2 void transform_scalar_avx2(int* dst, const int* a, int b, std::size_t n, Op op) {
+    const __m256i vb = _mm256_set1_epi32(b);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), apply_avx2(va, vb, op));
+    }
+    transform_scalar_scalar(dst + i, a + i, b, n - i, op);
+}
+
+TARGET_AVX2 void transform_vector_avx2(int* dst, const int* a, const int* b, std::size_t n, Op op) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), apply_avx2(va, vb, op));
+    }
+    transform_vector_scalar(dst + i, a + i, b + i, n - i, op);
+}
+
+constexpr Kernels avx2_kernels{sum_avx2,   min_avx2,   max_avx2,
+                               find_avx2,  count_avx2, fill_avx2,
+                               transform_scalar_avx2,  transform_vector_avx2};
+
+#undef TARGET_SSE41
+#undef TARGET_AVX2
+
+#endif // MYVECTOR_SIMD_X86
+
+const Kernels* kernels_for(Isa isa) noexcept {
+#if defined(MYVECTOR_SIMD_X86)
+    switch (isa) {
+        case Isa::AVX2: return &avx2_kernels;
+        case Isa::SSE41: return &sse41_kernels;
+        case Isa::Scalar: break;
+    }
+#else
+    (void)isa;
+#endif
+    return &scalar_kernels;
+}
+
+std::atomic<Isa>& active() noexcept {
+    static std::atomic<Isa> isa{detected_isa()};
+    return isa;
+}
+
+const Kernels& kernels() noexcept {
+    return *kernels_for(active().load(std::memory_order_relaxed));
+}
+
+} // namespace
+
+Isa detected_isa() noexcept {
+#if defined(MYVECTOR_SIMD_X86)
+    static const Isa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return Isa::SSE41;
+        return Isa::Scalar;
+    }();
+    return isa;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+Isa active_isa() noexcept {
+    return active().load(std::memory_order_relaxed);
+}
+
+Isa force_isa(Isa isa) noexcept {
+    if (static_cast<int>(isa) > static_cast<int>(detected_isa())) {
+        isa = detected_isa();
+    }
+    active().store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::AVX2: return "avx2";
+        case Isa::SSE41: return "sse4.1";
+        case Isa::Scalar: break;
+    }
+    return "scalar";
+}
+
+long long sum(const int* data, std::size_t n) noexcept {
+    return kernels().sum(data, n);
+}
+
+int min(const int* data, std::size_t n) {
+    if (!n) throw std::invalid_argument("simd::min: empty range");
+    return kernels().min(data, n);
+}
+
+int max(const int* data, std::size_t n) {
+    if (!n) throw std::invalid_argument("simd::max: empty range");
+    return kernels().max(data, n);
+}
+
+std::size_t find(const int* data, std::size_t n, int value) noexcept {
+    return kernels().find(data, n, value);
+}
+
+std::size_t count(const int* data, std::size_t n, int value) noexcept {
+    return kernels().count(data, n, value);
+}
+
+void fill(int* data, std::size_t n, int value) noexcept {
+    kernels().fill(data, n, value);
+}
+
+void transform(int* dst, const int* a, int scalar, std::size_t n, Op op) noexcept {
+    kernels().transform_scalar(dst, a, scalar, n, op);
+}
+
+void transform(int* dst, const int* a, const int* b, std::size_t n, Op op) noexcept {
+    kernels().transform_vector(dst, a, b, n, op);
+}
+
+} // namespace simd
@@ -0,0 +1,107 @@
+#ifndef MY_VECTOR_SIMD_HPP
+#define MY_VECTOR_SIMD_HPP
+
+#include <cstddef>   // for size_t
+#include <stdexcept> // for std::invalid_argument
+
+#include "myvector.hpp"
+
+/**
+ * Vectorized bulk kernels over contiguous int storage.
+ *
+ * Every kernel has an AVX2, an SSE4.1 and a portable scalar implementation. The
+ * variant is chosen once at runtime from the CPUID feature flags; force_isa()
+ * overrides the choice (tests, benchmarks). The MyVector overloads at the end
+ * forward to the pointer/length kernels.
+ */
+namespace simd {
+
+// Instruction set used by the kernels
+enum class Isa { Scalar, SSE41, AVX2 };
+
+// Elementwise operation for transform()
+enum class Op { Add, Sub, Mul };
+
+// Best instruction set supported by this CPU
+Isa detected_isa() noexcept;
+
+// Instruction set currently used by the kernels
+Isa active_isa() noexcept;
+
+// Uses 'isa' from now on; falls back to the best supported set if the CPU lacks it.
+// Returns the instruction set that is actually active afterwards.
+Isa force_isa(Isa isa) noexcept;
+
+// Name of an instruction set for log output ("scalar", "sse4.1", "avx2")
+const char* isa_name(Isa isa) noexcept;
+
+// Sum of all elements, accumulated in 64 bit so it cannot overflow
+long long sum(const int* data, std::size_t n) noexcept;
+
+// Smallest / largest element; throws std::invalid_argument for an empty range
+int min(const int* data, std::size_t n);
+int max(const int* data, std::size_t n);
+
+// Index of the first element equal to value, or n if there is none
+std::size_t find(const int* data, std::size_t n, int value) noexcept;
+
+// Number of elements equal to value
+std::size_t count(const int* data, std::size_t n, int value) noexcept;
+
+// Sets every element to value
+void fill(int* data, std::size_t n, int value) noexcept;
+
+// dst[i] = a[i] <op> scalar, dst may be the same array as a (wrap-around on overflow)
+void transform(int* dst, const int* a, int scalar, std::size_t n, Op op) noexcept;
+
+// dst[i] = a[i] <op> b[i], dst may be the same array as a or b (wrap-around on overflow)
+void transform(int* dst, const int* a, const int* b, std::size_t n, Op op) noexcept;
+
+// --- MyVector<int> overloads ---------------------------------------------
+
+template <typename Alloc, typename Trace>
+long long sum(const MyVector<int, Alloc, Trace>& v) noexcept {
+    return v.size() ? sum(&v[0], v.size()) : 0;
+}
+
+template <typename Alloc, typename Trace>
+int min(const MyVector<int, Alloc, Trace>& v) {
+    return min(v.size() ? &v[0] : nullptr, v.size());
+}
+
+template <typename Alloc, typename Trace>
+int max(const MyVector<int, Alloc, Trace>& v) {
+    return max(v.size() ? &v[0] : nullptr, v.size());
+}
+
+template <typename Alloc, typename Trace>
+std::size_t find(const MyVector<int, Alloc, Trace>& v, int value) noexcept {
+    return v.size() ? find(&v[0], v.size(), value) : 0;
+}
+
+template <typename Alloc, typename Trace>
+std::size_t count(const MyVector<int, Alloc, Trace>& v, int value) noexcept {
+    return v.size() ? count(&v[0], v.size(), value) : 0;
+}
+
+template <typename Alloc, typename Trace>
+void fill(MyVector<int, Alloc, Trace>& v, int value) noexcept {
+    if (v.size()) fill(&v[0], v.size(), value);
+}
+
+// Applies v[i] = v[i] <op> scalar in place
+template <typename Alloc, typename Trace>
+void transform(MyVector<int, Alloc, Trace>& v, int scalar, Op op) noexcept {
+    if (v.size()) transform(&v[0], &v[0], scalar, v.size(), op);
+}
+
+// Applies v[i] = v[i] <op> other[i] in place; throws std::invalid_argument on a size mismatch
+template <typename Alloc, typename Trace, typename Alloc2, typename Trace2>
+void transform(MyVector<int, Alloc, Trace>& v, const MyVector<int, Alloc2, Trace2>& other, Op op) {
+    if (v.size() != other.size()) throw std::invalid_argument("simd::transform: size mismatch");
+    if (v.size()) transform(&v[0], &v[0], &other[0], v.size(), op);
+}
+
+} // namespace simd
+
+#endif /* MY_VECTOR_SIMD_HPP */
@@ -0,0 +1,100 @@
+#ifndef MY_VECTOR_TRACE_HPP
+#define MY_VECTOR_TRACE_HPP
+
+#include <atomic>
+#include <cstddef> // for size_t
+
+// Snapshot of the lifecycle counters recorded by CountingTrace
+struct MyVectorStats {
+    std::size_t constructions = 0;  // all constructor calls (default, size, copy, move)
+    std::size_t destructions = 0;   // destructor calls
+    std::size_t copies = 0;         // copy constructions and copy assignments
+    std::size_t moves = 0;          // move constructions and move assignments
+    std::size_t reallocations = 0;  // buffer growths performed by reserve/push_back/resize
+    std::size_t bytes_copied = 0;   // element bytes copied by copies and reallocations
+    std::size_t peak_capacity = 0;  // largest capacity (in elements) ever allocated
+};
+
+// Tracing policy that records nothing: every hook is an empty inline function,
+// so an optimizing build removes the calls completely
+struct NoTrace {
+    static constexpr bool enabled = false;
+
+    static void on_construct() noexcept {}
+    static void on_destruct() noexcept {}
+    static void on_copy(std::size_t /*bytes*/) noexcept {}
+    static void on_move() noexcept {}
+    static void on_reallocate(std::size_t /*bytes*/, std::size_t /*new_capacity*/) noexcept {}
+    static void on_capacity(std::size_t /*capacity*/) noexcept {}
+
+    static MyVectorStats stats() noexcept { return {}; }
+    static void reset() noexcept {}
+};
+
+// Tracing policy that counts lifecycle events in process-wide relaxed atomics.
+// No I/O and no locks are involved, the numbers are queried via stats().
+struct CountingTrace {
+    static constexpr bool enabled = true;
+
+    static void on_construct() noexcept { bump(s_constructions); }
+    static void on_destruct() noexcept { bump(s_destructions); }
+    static void on_copy(std::size_t bytes) noexcept {
+        bump(s_copies);
+        bump(s_bytes_copied, bytes);
+    }
+    static void on_move() noexcept { bump(s_moves); }
+    static void on_reallocate(std::size_t bytes, std::size_t new_capacity) noexcept {
+        bump(s_reallocations);
+        bump(s_bytes_copied, bytes);
+        on_capacity(new_capacity);
+    }
+    static void on_capacity(std::size_t capacity) noexcept {
+        std::size_t peak = s_peak_capacity.load(std::memory_order_relaxed);
+        while (capacity > peak &&
+               !s_peak_capacity.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Returns a snapshot of all counters
+    static MyVectorStats stats() noexcept {
+        MyVectorStats s;
+        s.constructions = s_constructions.load(std::memory_order_relaxed);
+        s.destructions = s_destructions.load(std::memory_order_relaxed);
+        s.copies = s_copies.load(std::memory_order_relaxed);
+        s.moves = s_moves.load(std::memory_order_relaxed);
+        s.reallocations = s_reallocations.load(std::memory_order_relaxed);
+        s.bytes_copied = s_bytes_copied.load(std::memory_order_relaxed);
+        s.peak_capacity = s_peak_capacity.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Sets all counters back to zero
+    static void reset() noexcept {
+        for (auto* counter : {&s_constructions, &s_destructions, &s_copies, &s_moves, &s_reallocations,
+                              &s_bytes_copied, &s_peak_capacity}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static void bump(std::atomic<std::size_t>& counter, std::size_t n = 1) noexcept {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static inline std::atomic<std::size_t> s_constructions{0};
+    static inline std::atomic<std::size_t> s_destructions{0};
+    static inline std::atomic<std::size_t> s_copies{0};
+    static inline std::atomic<std::size_t> s_moves{0};
+    static inline std::atomic<std::size_t> s_reallocations{0};
+    static inline std::atomic<std::size_t> s_bytes_copied{0};
+    static inline std::atomic<std::size_t> s_peak_capacity{0};
+};
+
+// The policy used by MyVector is selected at build time (CMake option MYVECTOR_TRACE)
+#if defined(MYVECTOR_TRACE) && MYVECTOR_TRACE
+using MyVectorTrace = CountingTrace;
+#else
+using MyVectorTrace = NoTrace;
+#endif
+
+#endif /* MY_VECTOR_TRACE_HPP */
@@ -0,0 +1,260 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <cstddef>     // for size_t
+#include <memory>      // for std::allocator, std::allocator_traits
+#include <stdexcept>   // for std::out_of_range, std::length_error
+#include <type_traits> // for std::is_nothrow_move_constructible
+#include <utility>     // for std::forward, std::move
+
+#include "myvector.hpp"
+
+/**
+ * @brief MyVector variant with N elements of inline storage
+ * @tparam T Element type
+ * @tparam N Number of elements kept inside the object before spilling to the heap
+ * @tparam Alloc Allocator used once the inline storage is exhausted
+ *
+ * Offers the same interface as MyVector (push_back, emplace_back, at, operator[],
+ * reserve, resize, clear, ...). As long as size() <= N no heap allocation happens,
+ * beyond that the elements are relocated to allocator storage transparently.
+ */
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>>
+class SmallVector {
+    static_assert(N > 0, "SmallVector<T, N>: N must be at least 1, use MyVector<T> otherwise");
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    // Heap buffers may change owner on move assignment only if the allocators need not compare equal
+    static constexpr bool steals_on_move =
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = typename MyVector<T, Alloc>::size_type;
+    using reference = T&;
+    using const_reference = const T&;
+
+    // Number of elements that fit into the inline buffer
+    static constexpr size_type inline_capacity = N;
+
+    // Default constructor: empty vector using the inline buffer
+    SmallVector() noexcept(noexcept(Alloc())) : SmallVector(Alloc()) {}
+    explicit SmallVector(const Alloc& alloc) noexcept
+        : m_data(inline_data()), m_size(0), m_capacity(N), m_alloc(alloc) {}
+
+    // Constructor with initial size: value-initializes 'size' elements
+    explicit SmallVector(size_type size, const Alloc& alloc = Alloc()) : SmallVector(alloc) {
+        resize(size);
+    }
+
+    // Copy constructor: copies the elements, heap storage only if they do not fit inline
+    SmallVector(const SmallVector& other)
+        : SmallVector(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+        reserve(other.m_size);
+        myvector_detail::copy_construct(m_alloc, other.m_data, other.m_size, m_data);
+        m_size = other.m_size;
+    }
+
+    // Copy assignment operator with self-assignment check
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.m_size);
+            myvector_detail::copy_construct(m_alloc, other.m_data, other.m_size, m_data);
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+
+    // Move constructor: steals heap storage, relocates inline elements
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : SmallVector(other.m_alloc)
+    {
+        take(other);
+    }
+
+    // Move assignment operator: releases own storage, then behaves like the move constructor.
+    // A heap buffer from an allocator that neither propagates nor compares equal must not be
+    // taken over (it would later be freed through the wrong resource): its elements are moved.
+    SmallVector& operator=(SmallVector&& other) noexcept(steals_on_move &&
+                                                         std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            if (steals_on_move || other.is_inline() || m_alloc == other.m_alloc) {
+                release();
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                    m_alloc = other.m_alloc;
+                }
+                take(other);
+            } else {
+                clear();
+                reserve(other.m_size);
+                for (size_type i = 0; i < other.m_size; ++i) {
+                    alloc_traits::construct(m_alloc, m_data + i, std::move(other.m_data[i]));
+                    ++m_size;
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // Exchanges the contents; O(1) pointer swap if both vectors live on the heap and
+    // the buffers may change owner, element moves through the move assignment otherwise
+    void swap(SmallVector& other) noexcept(steals_on_move && std::is_nothrow_move_constructible<T>::value) {
+        constexpr bool propagate = alloc_traits::propagate_on_container_swap::value;
+        if (!is_inline() && !other.is_inline() &&
+            (propagate || alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)) {
+            using std::swap;
+            swap(m_data, other.m_data);
+            swap(m_size, other.m_size);
+            swap(m_capacity, other.m_capacity);
+            if constexpr (propagate) {
+                swap(m_alloc, other.m_alloc);
+            }
+            return;
+        }
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Destructor destroys the elements and frees heap storage (if any)
+    ~SmallVector() { release(); }
+
+    // Adds an element to the end of the vector, spilling to the heap if needed
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Constructs an element in place at the end of the vector and returns a reference to it
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            // construct into a temporary first: args may refer to an element of *this
+            T tmp(std::forward<Args>(args)...);
+            if (m_capacity > max_size() / 2)
+                throw std::length_error("SmallVector: maximum size exceeded");
+            reallocate(m_capacity * 2);
+            alloc_traits::construct(m_alloc, m_data + m_size, std::move(tmp));
+        } else {
+            alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+        }
+        return m_data[m_size++];
+    }
+
+    // Access element with bounds checking; throws std::out_of_range if invalid
+    T& at(size_t index) {
+        if (index >= m_size) throw std::out_of_range("SmallVector::at");
+        return m_data[index];
+    }
+    const T& at(size_t index) const {
+        if (index >= m_size) throw std::out_of_range("SmallVector::at");
+        return m_data[index];
+    }
+
+    // Access element without bounds checking (like operator[])
+    T& operator[](size_t index) { return m_data[index]; }
+    const T& operator[](size_t index) const { return m_data[index]; }
+
+    // Returns current number of elements stored
+    size_type size() const noexcept { return m_size; }
+
+    // Returns current capacity (N while the inline buffer is used)
+    size_type capacity() const noexcept { return m_capacity; }
+
+    // Returns the largest possible number of elements
+    size_type max_size() const noexcept { return alloc_traits::max_size(m_alloc); }
+
+    // True while the elements live in the inline buffer
+    bool is_inline() const noexcept { return m_data == inline_data(); }
+
+    // Returns a copy of the allocator
+    allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    // Allocates heap storage for at least new_cap elements if new_cap exceeds the capacity
+    void reserve(size_type new_cap) {
+        if (new_cap > max_size())
+            throw std::length_error("SmallVector::reserve");
+        if (new_cap > m_capacity)
+            reallocate(new_cap);
+    }
+
+    // Changes the size to new_size, value-initializing new elements if enlarged
+    void resize(size_type new_size) {
+        if (new_size > m_capacity)
+            reserve(new_size);
+        if (new_size > m_size) {
+            myvector_detail::value_construct(m_alloc, m_data + m_size, new_size - m_size);
+        } else {
+            myvector_detail::destroy_n(m_alloc, m_data + new_size, m_size - new_size);
+        }
+        m_size = new_size;
+    }
+
+    // Clears the vector (size becomes zero, capacity unchanged)
+    void clear() noexcept {
+        myvector_detail::destroy_n(m_alloc, m_data, m_size);
+        m_size = 0;
+    }
+
+private:
+    T* inline_data() noexcept { return reinterpret_cast<T*>(m_inline); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(m_inline); }
+
+    // Private helper: moves the elements to heap storage of new_cap elements
+    void reallocate(size_type new_cap) {
+        T* new_data = alloc_traits::allocate(m_alloc, new_cap);
+        try {
+            myvector_detail::relocate(m_alloc, m_data, m_size, new_data);
+        } catch (...) {
+            alloc_traits::deallocate(m_alloc, new_data, new_cap);
+            throw;
+        }
+        if (!is_inline()) {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+        m_data = new_data;
+        m_capacity = new_cap;
+    }
+
+    // Private helper: destroys the elements and returns to the (empty) inline buffer
+    void release() noexcept {
+        clear();
+        if (!is_inline()) {
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+        m_data = inline_data();
+        m_capacity = N;
+    }
+
+    // Private helper: takes over the contents of other, which must be empty on our side.
+    // Heap storage changes owner, inline elements are relocated one by one.
+    void take(SmallVector& other) {
+        if (other.is_inline()) {
+            myvector_detail::relocate(m_alloc, other.m_data, other.m_size, m_data);
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inline_data();
+            other.m_capacity = N;
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+
+    T* m_data;               // points to m_inline or to heap storage
+    size_type m_size;        // current number of constructed elements
+    size_type m_capacity;    // N while inline, heap capacity otherwise
+    Alloc m_alloc;           // allocator for the heap storage
+    alignas(T) unsigned char m_inline[N * sizeof(T)]; // inline storage for N elements
+};
+
+// Non-member swap
+template <typename T, std::size_t N, typename Alloc>
+void swap(SmallVector<T, N, Alloc>& lhs, SmallVector<T, N, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+#endif /* SMALL_VECTOR_HPP */
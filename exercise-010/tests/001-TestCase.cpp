@@ -2,7 +2,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 TEST_CASE("MyVector basic functionality") {
-    MyVector v;
+    MyVector<int> v;
 
     SECTION("initial size is zero") {
         REQUIRE(v.size() == 0);
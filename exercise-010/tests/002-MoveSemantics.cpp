@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../myvector.hpp"
+#include "counting_allocator.hpp"
+#include <utility>
+
+using CountedVector = MyVector<int, CountingAllocator<int>>;
+
+static CountedVector make_filled(int count) {
+    CountedVector v;
+    for (int i = 0; i < count; ++i) {
+        v.push_back(i);
+    }
+    return v;
+}
+
+TEST_CASE("MyVector move semantics never allocate") {
+    CountedVector src = make_filled(100);
+    const auto capacity = src.capacity();
+
+    SECTION("move constructor steals the buffer") {
+        const auto before = g_allocations;
+        CountedVector dst(std::move(src));
+        REQUIRE(g_allocations == before);
+        REQUIRE(dst.size() == 100);
+        REQUIRE(dst.capacity() == capacity);
+        REQUIRE(dst[99] == 99);
+        REQUIRE(src.size() == 0);
+        REQUIRE(src.capacity() == 0);
+    }
+
+    SECTION("move assignment steals the buffer") {
+        CountedVector dst = make_filled(3);
+        const auto before = g_allocations;
+        dst = std::move(src);
+        REQUIRE(g_allocations == before);
+        REQUIRE(dst.size() == 100);
+        REQUIRE(dst.at(42) == 42);
+        REQUIRE(src.size() == 0);
+    }
+
+    SECTION("swap exchanges buffers") {
+        CountedVector other = make_filled(5);
+        const auto before = g_allocations;
+        swap(src, other);
+        REQUIRE(g_allocations == before);
+        REQUIRE(src.size() == 5);
+        REQUIRE(other.size() == 100);
+        REQUIRE(other[7] == 7);
+    }
+
+    SECTION("moved-from vector is reusable") {
+        CountedVector dst(std::move(src));
+        src.push_back(1);
+        REQUIRE(src.size() == 1);
+        REQUIRE(src.at(0) == 1);
+    }
+
+    SECTION("copy still allocates exactly once") {
+        const auto before = g_allocations;
+        CountedVector copy(src);
+        REQUIRE(g_allocations == before + 1);
+        REQUIRE(copy.size() == src.size());
+    }
+}
+
+TEST_CASE("MyVector emplace_back and rvalue push_back") {
+    CountedVector v;
+    v.reserve(4);
+    const auto before = g_allocations;
+
+    int value = 7;
+    v.push_back(std::move(value));
+    REQUIRE(v.emplace_back(3) == 3);
+    REQUIRE(v.emplace_back() == 0);
+    REQUIRE(g_allocations == before);
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[0] == 7);
+    REQUIRE(v[1] == 3);
+    REQUIRE(v[2] == 0);
+}
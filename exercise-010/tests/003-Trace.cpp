@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../myvector.hpp"
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using TracedVector = MyVector<int, std::allocator<int>, CountingTrace>;
+
+TEST_CASE("MyVector lifecycle counters") {
+    CountingTrace::reset();
+
+    {
+        TracedVector v;
+        for (int i = 0; i < 5; ++i) {
+            v.push_back(i); // grows 0 -> 1 -> 2 -> 4 -> 8
+        }
+        TracedVector copy(v);
+        TracedVector moved(std::move(copy));
+    }
+
+    const MyVectorStats stats = CountingTrace::stats();
+    REQUIRE(stats.constructions == 3);
+    REQUIRE(stats.destructions == 3);
+    REQUIRE(stats.copies == 1);
+    REQUIRE(stats.moves == 1);
+    REQUIRE(stats.reallocations == 4);
+    REQUIRE(stats.peak_capacity == 8);
+    // reallocations copied 0 + 1 + 2 + 4 elements, the copy constructor 5 elements
+    REQUIRE(stats.bytes_copied == (7 + 5) * sizeof(int));
+}
+
+TEST_CASE("NoTrace policy has no state") {
+    STATIC_REQUIRE(!NoTrace::enabled);
+    STATIC_REQUIRE(std::is_empty<NoTrace>::value);
+}
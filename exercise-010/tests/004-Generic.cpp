@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../myvector.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Element type that tracks how many instances are alive
+struct Tracked {
+    static inline int alive = 0;
+    int value;
+
+    Tracked(int v = 0) : value(v) { ++alive; }
+    Tracked(const Tracked& other) : value(other.value) { ++alive; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { --alive; }
+};
+
+// Element type whose move constructor may throw, so relocation must copy
+struct ThrowingMove {
+    static inline int copies = 0;
+    int value;
+
+    ThrowingMove(int v) : value(v) {}
+    ThrowingMove(const ThrowingMove& other) : value(other.value) { ++copies; }
+    ThrowingMove(ThrowingMove&& other) noexcept(false) : value(other.value) {}
+};
+
+// Trivially copyable aggregate, relocated with memcpy
+struct Sample {
+    int id;
+    double weight;
+};
+
+} // namespace
+
+TEST_CASE("MyVector<T> with non-trivial element types") {
+    SECTION("std::string survives growth and copies") {
+        MyVector<std::string> v;
+        for (int i = 0; i < 20; ++i) {
+            v.push_back("element number " + std::to_string(i));
+        }
+        MyVector<std::string> copy(v);
+        REQUIRE(copy.size() == 20);
+        REQUIRE(copy.at(19) == "element number 19");
+        copy.resize(2);
+        REQUIRE(copy.size() == 2);
+        REQUIRE(v.size() == 20);
+    }
+
+    SECTION("push_back of an own element survives reallocation") {
+        MyVector<std::string> v;
+        v.push_back("a long enough string to defeat the small string optimization");
+        REQUIRE(v.capacity() == 1);
+        v.push_back(v[0]);
+        REQUIRE(v[1] == v[0]);
+    }
+
+    SECTION("move-only elements") {
+        MyVector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.emplace_back(std::make_unique<int>(i));
+        }
+        REQUIRE(*v[9] == 9);
+    }
+
+    SECTION("every constructed element is destroyed") {
+        {
+            MyVector<Tracked> v(3);
+            for (int i = 0; i < 30; ++i) {
+                v.emplace_back(i);
+            }
+            MyVector<Tracked> copy = v;
+            copy.resize(5);
+            v = copy;
+            REQUIRE(Tracked::alive == 10);
+            v.clear();
+            REQUIRE(Tracked::alive == 5);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("throwing move constructors are not used for relocation") {
+        MyVector<ThrowingMove> v;
+        v.reserve(1);
+        v.emplace_back(1);
+        ThrowingMove::copies = 0;
+        v.reserve(8);
+        REQUIRE(ThrowingMove::copies == 1);
+        REQUIRE(v[0].value == 1);
+    }
+
+    SECTION("trivially copyable structs") {
+        MyVector<Sample> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back({i, i * 0.5});
+        }
+        REQUIRE(v.at(99).id == 99);
+        REQUIRE(v.at(99).weight == 49.5);
+        v.resize(150);
+        REQUIRE(v[149].id == 0); // value-initialized
+        REQUIRE_THROWS_AS(v.at(150), std::out_of_range);
+    }
+}
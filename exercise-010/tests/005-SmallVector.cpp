@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../smallvector.hpp"
+#include "../arena.hpp"
+#include "counting_allocator.hpp"
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using SmallInts = SmallVector<int, 16, CountingAllocator<int>>;
+
+namespace {
+
+// Resource that remembers its blocks and counts frees of blocks it never handed out
+class TrackingResource : public MemoryResource {
+public:
+    std::set<void*> live;
+    int foreign_frees = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* p = new_delete_resource()->allocate(bytes, alignment);
+        live.insert(p);
+        return p;
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept override {
+        if (live.erase(p) == 0) {
+            ++foreign_frees;
+            return;
+        }
+        new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+};
+
+} // namespace
+
+TEST_CASE("SmallVector keeps up to N elements inline") {
+    const auto before = g_allocations;
+    SmallInts v;
+    for (int i = 0; i < 16; ++i) {
+        v.push_back(i);
+    }
+    const auto after_inline = g_allocations;
+    REQUIRE(after_inline == before);
+    REQUIRE(v.is_inline());
+    REQUIRE(v.capacity() == 16);
+    REQUIRE(v.at(15) == 15);
+
+    SECTION("the 17th element spills to the heap") {
+        v.push_back(16);
+        const auto after_spill = g_allocations;
+        REQUIRE(after_spill == before + 1);
+        REQUIRE_FALSE(v.is_inline());
+        REQUIRE(v.capacity() == 32);
+        for (int i = 0; i < 17; ++i) {
+            REQUIRE(v[i] == i);
+        }
+    }
+
+    SECTION("resize and clear behave like MyVector") {
+        v.resize(4);
+        REQUIRE(v.size() == 4);
+        v.resize(8);
+        REQUIRE(v[7] == 0);
+        v.clear();
+        REQUIRE(v.size() == 0);
+        REQUIRE_THROWS_AS(v.at(0), std::out_of_range);
+        REQUIRE(v.is_inline());
+    }
+}
+
+TEST_CASE("SmallVector copy, move and swap") {
+    SmallVector<std::string, 2> inline_vec;
+    inline_vec.push_back("a");
+    SmallVector<std::string, 2> heap_vec;
+    for (int i = 0; i < 5; ++i) {
+        heap_vec.push_back(std::to_string(i));
+    }
+    REQUIRE_FALSE(heap_vec.is_inline());
+
+    SECTION("copies") {
+        SmallVector<std::string, 2> a(inline_vec);
+        SmallVector<std::string, 2> b(heap_vec);
+        REQUIRE(a.is_inline());
+        REQUIRE(a.at(0) == "a");
+        REQUIRE(b.size() == 5);
+        a = b;
+        REQUIRE(a.at(4) == "4");
+    }
+
+    SECTION("moving an inline vector relocates the elements") {
+        SmallVector<std::string, 2> moved(std::move(inline_vec));
+        REQUIRE(moved.is_inline());
+        REQUIRE(moved.at(0) == "a");
+        REQUIRE(inline_vec.size() == 0);
+    }
+
+    SECTION("moving a heap vector steals the buffer") {
+        const std::string* data = &heap_vec[0];
+        SmallVector<std::string, 2> moved(std::move(heap_vec));
+        REQUIRE(&moved[0] == data);
+        REQUIRE(heap_vec.is_inline());
+        REQUIRE(heap_vec.size() == 0);
+    }
+
+    SECTION("swap between inline and heap storage") {
+        swap(inline_vec, heap_vec);
+        REQUIRE(inline_vec.size() == 5);
+        REQUIRE(inline_vec.at(3) == "3");
+        REQUIRE(heap_vec.size() == 1);
+        REQUIRE(heap_vec.at(0) == "a");
+    }
+
+    SECTION("push_back of an own element while spilling") {
+        SmallVector<std::string, 2> v;
+        v.push_back("a long enough string to defeat the small string optimization");
+        v.push_back("x");
+        v.push_back(v[0]);
+        REQUIRE(v[2] == v[0]);
+    }
+}
+
+TEST_CASE("SmallVector move and swap across different memory resources") {
+    using Strings = SmallVector<std::string, 2, ResourceAllocator<std::string>>;
+    TrackingResource first;
+    TrackingResource second;
+    {
+        Strings a(&first);
+        Strings b(&second);
+        for (int i = 0; i < 5; ++i) {
+            a.push_back("a" + std::to_string(i));
+            b.push_back("b" + std::to_string(i));
+        }
+        b.push_back("b5");
+
+        SECTION("move assignment moves the elements instead of the foreign buffer") {
+            a = std::move(b);
+            REQUIRE(a.size() == 6);
+            REQUIRE(a.at(5) == "b5");
+            REQUIRE(first.live.count(&a[0]) == 1);
+            REQUIRE(b.size() == 0);
+        }
+
+        SECTION("swap keeps every buffer with its resource") {
+            swap(a, b);
+            REQUIRE(a.size() == 6);
+            REQUIRE(a.at(0) == "b0");
+            REQUIRE(b.at(4) == "a4");
+            REQUIRE(first.live.count(&a[0]) == 1);
+            REQUIRE(second.live.count(&b[0]) == 1);
+        }
+
+        SECTION("equal resources still steal the buffer") {
+            Strings c(&first);
+            c.push_back("c");
+            const std::string* data = &a[0];
+            c = std::move(a);
+            REQUIRE(&c[0] == data);
+        }
+    }
+    REQUIRE(first.foreign_frees == 0);
+    REQUIRE(second.foreign_frees == 0);
+    REQUIRE(first.live.empty());
+    REQUIRE(second.live.empty());
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../arena.hpp"
+#include "../myvector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+using ArenaVector = MyVector<int, ResourceAllocator<int>>;
+
+TEST_CASE("MonotonicArena bump-allocates MyVector storage") {
+    MonotonicArena arena(1024);
+
+    {
+        ArenaVector v{ResourceAllocator<int>(&arena)};
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(v.at(99) == 99);
+        REQUIRE(v.get_allocator().resource() == &arena);
+    }
+
+    const ArenaStats& stats = arena.stats();
+    // growth 1, 2, 4, ..., 128 elements: 8 allocations, all returned by the vector
+    REQUIRE(stats.allocations == 8);
+    REQUIRE(stats.bytes_live == 0);
+    REQUIRE(stats.high_water_mark >= 255 * sizeof(int));
+    REQUIRE(stats.bytes_reserved >= stats.high_water_mark);
+    REQUIRE(stats.fragmentation() == 1.0);
+
+    arena.release();
+    REQUIRE(arena.stats().bytes_reserved == 0);
+    REQUIRE(arena.stats().high_water_mark >= 255 * sizeof(int));
+}
+
+TEST_CASE("MonotonicArena honours alignment and grows chunks") {
+    MonotonicArena arena(64);
+    void* a = arena.allocate(1, 1);
+    void* b = arena.allocate(8, 64);
+    void* c = arena.allocate(1000, 16);
+    REQUIRE(a != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 16 == 0);
+    REQUIRE(arena.stats().upstream_allocations >= 2);
+    REQUIRE(arena.stats().bytes_live == 1009);
+
+    // the most recent block can be rewound and handed out again
+    arena.deallocate(c, 1000, 16);
+    void* d = arena.allocate(1000, 16);
+    REQUIRE(d == c);
+}
+
+TEST_CASE("PoolResource reuses freed blocks of the same size class") {
+    PoolResource pool;
+
+    void* first = pool.allocate(24);
+    pool.deallocate(first, 24);
+    void* second = pool.allocate(32); // same 32 byte class
+    REQUIRE(second == first);
+    REQUIRE(pool.stats().upstream_allocations == 1);
+
+    void* big = pool.allocate(PoolResource::max_block_size + 1);
+    REQUIRE(pool.stats().upstream_allocations == 2);
+    pool.deallocate(big, PoolResource::max_block_size + 1);
+    pool.deallocate(second, 32);
+    REQUIRE(pool.stats().bytes_live == 0);
+
+    SECTION("vectors on a pool") {
+        using PoolVector = MyVector<int, ResourceAllocator<int>>;
+        PoolVector a{ResourceAllocator<int>(&pool)};
+        PoolVector b{ResourceAllocator<int>(&pool)};
+        for (int i = 0; i < 500; ++i) {
+            a.push_back(i);
+            b.push_back(-i);
+        }
+        a = std::move(b); // same resource: the buffer is stolen
+        REQUIRE(a.at(499) == -499);
+        REQUIRE(b.size() == 0);
+    }
+    REQUIRE(pool.stats().bytes_live == 0);
+}
+
+namespace {
+
+// Upstream that counts the bytes it has handed out and not got back
+class CountingResource : public MemoryResource {
+public:
+    std::size_t live = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        live += bytes;
+        return new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) noexcept override {
+        live -= bytes;
+        new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+};
+
+} // namespace
+
+TEST_CASE("PoolResource returns outstanding large blocks in release()") {
+    CountingResource upstream;
+    {
+        PoolResource pool(&upstream);
+        void* small = pool.allocate(64);
+        void* large = pool.allocate(1024 * 1024);
+        void* aligned = pool.allocate(100, 256);
+        REQUIRE(small != nullptr);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(large) % alignof(std::max_align_t) == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 256 == 0);
+        REQUIRE(pool.stats().bytes_live == 64 + 1024 * 1024 + 100);
+
+        // freeing one large block only takes its own share out of the stats
+        pool.deallocate(aligned, 100, 256);
+        REQUIRE(pool.stats().bytes_live == 64 + 1024 * 1024);
+        REQUIRE(pool.stats().bytes_used == PoolResource::min_block_size * 4 + 1024 * 1024);
+
+        pool.release();
+        REQUIRE(upstream.live == 0);
+        REQUIRE(pool.stats().bytes_reserved == 0);
+        REQUIRE(pool.stats().bytes_used == 0);
+        REQUIRE(pool.stats().bytes_live == 0);
+
+        // a block beyond the size classes that is never deallocated, the destructor frees it
+        pool.allocate(5000 * sizeof(int), alignof(int));
+        REQUIRE(upstream.live > 5000 * sizeof(int));
+    }
+    REQUIRE(upstream.live == 0);
+}
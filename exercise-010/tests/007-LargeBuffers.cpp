@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../hugepage_allocator.hpp"
+#include "../myvector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+TEST_CASE("MyVector uses 64 bit sizes") {
+    STATIC_REQUIRE(std::is_same<MyVector<int>::size_type, std::size_t>::value);
+
+    MyVector<int> v;
+    REQUIRE(v.max_size() > std::size_t{0xFFFFFFFFu});
+    REQUIRE_THROWS_AS(v.reserve(v.max_size() + 1), std::length_error);
+}
+
+TEST_CASE("HugePageAllocator grows large buffers in place") {
+    // a small threshold keeps the test fast: everything from 4 KiB on is memory-mapped
+    using MappedVector = MyVector<int, HugePageAllocator<int>>;
+    STATIC_REQUIRE(myvector_detail::has_reallocate<HugePageAllocator<int>, int>::value);
+    HugePageAllocator<int> alloc(4096);
+    MappedVector v{alloc};
+
+    const int count = 1 << 20;
+    for (int i = 0; i < count; ++i) {
+        v.push_back(i);
+    }
+    REQUIRE(v.get_allocator().is_mapped(v.capacity()));
+    REQUIRE(v.size() == static_cast<std::size_t>(count));
+
+    bool intact = true;
+    for (int i = 0; i < count; ++i) {
+        intact = intact && v[i] == i;
+    }
+    REQUIRE(intact);
+
+    SECTION("reserve and copy across the threshold") {
+        v.resize(10);
+        MappedVector copy(v);
+        REQUIRE(copy.at(9) == 9);
+        copy.reserve(100000);
+        REQUIRE(copy.at(9) == 9);
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("HugePageAllocator maps buffers on huge page boundaries") {
+    constexpr std::size_t huge = HugePageAllocator<char>::huge_page_size;
+    auto aligned = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) % huge == 0; };
+    HugePageAllocator<char> alloc(4096);
+
+    // sizes just above the threshold and not a multiple of a page
+    char* small = alloc.allocate(5000);
+    REQUIRE(aligned(small));
+    small[4999] = 'x';
+    char* large = alloc.allocate(huge + 123);
+    REQUIRE(aligned(large));
+    large[0] = 'a';
+    large[huge + 122] = 'z';
+
+    // growth keeps the alignment and the contents, in place or moved
+    large = alloc.reallocate(large, huge + 123, 3 * huge);
+    REQUIRE(aligned(large));
+    REQUIRE(large[0] == 'a');
+    REQUIRE(large[huge + 122] == 'z');
+    large[3 * huge - 1] = 'e';
+    small = alloc.reallocate(small, 5000, 4 * huge);
+    REQUIRE(aligned(small));
+    REQUIRE(small[4999] == 'x');
+
+    alloc.deallocate(small, 4 * huge);
+    alloc.deallocate(large, 3 * huge);
+}
+#endif
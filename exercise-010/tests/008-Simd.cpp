@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../myvector_simd.hpp"
+#include <climits>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+MyVector<int> random_vector(std::size_t size, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(-1000, 1000);
+    MyVector<int> v;
+    for (std::size_t i = 0; i < size; ++i) {
+        v.push_back(dis(gen));
+    }
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("simd kernels match the scalar loops on every instruction set") {
+    const simd::Isa best = simd::detected_isa();
+
+    for (simd::Isa isa : {simd::Isa::Scalar, simd::Isa::SSE41, simd::Isa::AVX2}) {
+        if (static_cast<int>(isa) > static_cast<int>(best)) {
+            continue; // not supported by this CPU
+        }
+        REQUIRE(simd::force_isa(isa) == isa);
+
+        // sizes around the register widths exercise the scalar tails
+        for (std::size_t size : {1u, 3u, 4u, 7u, 8u, 9u, 31u, 1000u}) {
+            DYNAMIC_SECTION(simd::isa_name(isa) << " size " << size) {
+                MyVector<int> v = random_vector(size, static_cast<unsigned int>(size));
+
+                long long sum = 0;
+                int lo = INT_MAX;
+                int hi = INT_MIN;
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    sum += v[i];
+                    lo = v[i] < lo ? v[i] : lo;
+                    hi = v[i] > hi ? v[i] : hi;
+                }
+                REQUIRE(simd::sum(v) == sum);
+                REQUIRE(simd::min(v) == lo);
+                REQUIRE(simd::max(v) == hi);
+
+                const int needle = v[size - 1];
+                std::size_t first = 0;
+                std::size_t hits = 0;
+                while (v[first] != needle) ++first;
+                for (std::size_t i = 0; i < v.size(); ++i) hits += v[i] == needle;
+                REQUIRE(simd::find(v, needle) == first);
+                REQUIRE(simd::find(v, 5000) == size);
+                REQUIRE(simd::count(v, needle) == hits);
+
+                MyVector<int> other = random_vector(size, 42);
+                MyVector<int> expected = v;
+                for (std::size_t i = 0; i < v.size(); ++i) expected[i] = (v[i] * 3 - other[i]) + 1;
+                simd::transform(v, 3, simd::Op::Mul);
+                simd::transform(v, other, simd::Op::Sub);
+                simd::transform(v, 1, simd::Op::Add);
+                for (std::size_t i = 0; i < v.size(); ++i) REQUIRE(v[i] == expected[i]);
+
+                simd::fill(v, 7);
+                REQUIRE(simd::count(v, 7) == size);
+            }
+        }
+    }
+    simd::force_isa(best);
+}
+
+TEST_CASE("simd kernels on edge cases") {
+    MyVector<int> empty;
+    REQUIRE(simd::sum(empty) == 0);
+    REQUIRE(simd::count(empty, 0) == 0);
+    REQUIRE_THROWS_AS(simd::min(empty), std::invalid_argument);
+
+    MyVector<int> big(100);
+    simd::fill(big, INT_MAX);
+    REQUIRE(simd::sum(big) == 100LL * INT_MAX); // no 32 bit overflow
+
+    MyVector<int> shorter(99);
+    REQUIRE_THROWS_AS(simd::transform(big, shorter, simd::Op::Add), std::invalid_argument);
+}
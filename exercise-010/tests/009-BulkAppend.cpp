@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../hugepage_allocator.hpp"
+#include "../myvector.hpp"
+#include "counting_allocator.hpp"
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+template <typename Vector>
+std::string join(const Vector& v) {
+    std::string result;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        result += std::to_string(v[i]);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("MyVector::append reserves once for forward ranges") {
+    const int source[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    SECTION("single allocation for a range into an empty vector") {
+        MyVector<int, CountingAllocator<int>> v;
+        g_allocations = 0;
+        v.append(std::begin(source), std::end(source));
+        REQUIRE(g_allocations == 1);
+        REQUIRE(v.size() == 9);
+        REQUIRE(join(v) == "123456789");
+    }
+
+    SECTION("repeated appends keep the doubling") {
+        MyVector<int> v;
+        v.append(source, source + 3);
+        v.append(source, source + 1);
+        REQUIRE(v.capacity() == 6);
+        REQUIRE(join(v) == "1231");
+    }
+
+    SECTION("non-pointer forward iterators and single-pass ranges") {
+        const std::list<int> list{4, 5, 6};
+        std::istringstream input("7 8 9");
+        MyVector<int> v;
+        v.append(list.begin(), list.end());
+        v.append(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        REQUIRE(join(v) == "456789");
+    }
+
+    SECTION("appending the vector to itself") {
+        MyVector<std::string> v;
+        v.push_back("a long enough string to defeat the small string optimization");
+        v.push_back("b");
+        v.append(&v[0], &v[0] + v.size());
+        REQUIRE(v.size() == 4);
+        REQUIRE(v[2] == v[0]);
+        REQUIRE(v[3] == "b");
+    }
+
+    SECTION("self-append with an allocator that grows in place") {
+        HugePageAllocator<int> alloc(64);
+        MyVector<int, HugePageAllocator<int>> v{alloc};
+        v.append(source, source + 9);
+        for (int round = 0; round < 4; ++round) {
+            v.append(&v[0], &v[0] + v.size());
+        }
+        REQUIRE(v.size() == 9 * 16);
+        REQUIRE(v[9 * 15 + 8] == 9);
+    }
+}
+
+TEST_CASE("MyVector::insert places ranges at any position") {
+    const int source[] = {7, 8, 9};
+
+    MyVector<int> v;
+    const int start[] = {1, 2, 3};
+    v.append(start, start + 3);
+
+    SECTION("front, middle and back") {
+        REQUIRE(v.insert(0, source, source + 1) == 0);
+        REQUIRE(v.insert(2, source + 1, source + 2) == 2);
+        REQUIRE(v.insert(v.size(), source + 2, source + 3) == 5);
+        REQUIRE(join(v) == "718239");
+    }
+
+    SECTION("insert with spare capacity shifts the tail in place") {
+        v.reserve(10);
+        v.insert(1, source, source + 3);
+        REQUIRE(v.capacity() == 10);
+        REQUIRE(join(v) == "178923");
+    }
+
+    SECTION("insert of an own subrange") {
+        v.insert(1, &v[1], &v[1] + 2);
+        REQUIRE(join(v) == "12323");
+    }
+
+    SECTION("position past the end throws and leaves the vector unchanged") {
+        REQUIRE_THROWS_AS(v.insert(4, source, source + 3), std::out_of_range);
+        REQUIRE(join(v) == "123");
+    }
+
+    SECTION("non-trivial elements from a list") {
+        MyVector<std::string> words;
+        words.push_back("a");
+        words.push_back("d");
+        const std::list<std::string> middle{"b", "c"};
+        words.insert(1, middle.begin(), middle.end());
+        REQUIRE(words.size() == 4);
+        REQUIRE(words[1] == "b");
+        REQUIRE(words[2] == "c");
+        REQUIRE(words[3] == "d");
+    }
+}
+
+TEST_CASE("MyVector::resize_default_init") {
+    SECTION("keeps existing elements and grows without zero-filling") {
+        MyVector<int> v;
+        const int start[] = {1, 2};
+        v.append(start, start + 2);
+        v.resize_default_init(1000);
+        REQUIRE(v.size() == 1000);
+        REQUIRE(v[1] == 2);
+        for (std::size_t i = 2; i < v.size(); ++i) {
+            v[i] = static_cast<int>(i); // the caller overwrites the new elements
+        }
+        REQUIRE(v.at(999) == 999);
+        v.resize_default_init(3);
+        REQUIRE(join(v) == "122");
+    }
+
+    SECTION("class types are still default-constructed") {
+        MyVector<std::string> v;
+        v.resize_default_init(3);
+        REQUIRE(v.size() == 3);
+        REQUIRE(v[2].empty());
+    }
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../concurrent_vector.hpp"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentVector single-threaded basics") {
+    ConcurrentVector<std::string> v;
+    REQUIRE(v.size() == 0);
+    REQUIRE_FALSE(v.ready(0));
+    REQUIRE_THROWS_AS(v.at(0), std::out_of_range);
+
+    REQUIRE(v.push_back("first") == 0);
+    const std::string* address = &v[0];
+    for (int i = 1; i < 1000; ++i) {
+        v.emplace_back(std::to_string(i));
+    }
+    REQUIRE(v.size() == 1000);
+    REQUIRE(&v[0] == address); // growth never relocates
+    REQUIRE(v.at(999) == "999");
+
+    const std::string words[] = {"a", "b", "c"};
+    REQUIRE(v.append(std::begin(words), std::end(words)) == 1000);
+    REQUIRE(v.at(1002) == "c");
+
+    const MyVector<std::string> copy = v.snapshot();
+    REQUIRE(copy.size() == 1003);
+    REQUIRE(copy[0] == "first");
+    REQUIRE(copy[1001] == "b");
+}
+
+TEST_CASE("ConcurrentVector stress test with concurrent readers") {
+    constexpr int threads = 8;
+    constexpr int per_thread = 20000;
+    ConcurrentVector<int> v;
+    std::atomic<bool> done{false};
+    std::atomic<bool> reader_ok{true};
+
+    // the reader must only ever see fully written values of a known shape
+    std::thread reader([&] {
+        while (!done.load()) {
+            v.for_each([&](std::size_t, int value) {
+                if (value < 0 || value >= threads * per_thread) reader_ok = false;
+            });
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                v.push_back(t * per_thread + i);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE(reader_ok);
+    REQUIRE(v.size() == static_cast<std::size_t>(threads * per_thread));
+
+    // every value appears exactly once, and each thread's values keep their order
+    std::vector<int> seen(threads * per_thread, 0);
+    std::vector<int> last(threads, -1);
+    bool ordered = true;
+    v.for_each([&](std::size_t, int value) {
+        ++seen[value];
+        ordered = ordered && value > last[value / per_thread];
+        last[value / per_thread] = value;
+    });
+    bool unique = true;
+    for (int count : seen) {
+        unique = unique && count == 1;
+    }
+    REQUIRE(unique);
+    REQUIRE(ordered);
+    REQUIRE(v.snapshot().size() == v.size());
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../myvector.hpp"
+#include "../myvector_parallel.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("MyVector iterators work with <algorithm>") {
+    using Vector = MyVector<int>;
+    STATIC_REQUIRE(std::is_same<std::iterator_traits<Vector::iterator>::iterator_category,
+                                std::random_access_iterator_tag>::value);
+    STATIC_REQUIRE(std::is_convertible<Vector::iterator, Vector::const_iterator>::value);
+    STATIC_REQUIRE_FALSE(std::is_convertible<Vector::const_iterator, Vector::iterator>::value);
+
+    Vector v;
+    REQUIRE(v.begin() == v.end());
+    REQUIRE(v.empty());
+    for (int value : {5, 3, 9, 1, 7}) {
+        v.push_back(value);
+    }
+
+    SECTION("data() and iterators address the same storage") {
+        REQUIRE(v.data() == &v[0]);
+        REQUIRE(&*v.begin() == v.data());
+        REQUIRE(v.end() - v.begin() == 5);
+        REQUIRE(v.cend() - v.begin() == 5);
+        REQUIRE(v.begin()[4] == 7);
+    }
+
+    SECTION("sort, accumulate and reverse iteration") {
+        std::sort(v.begin(), v.end());
+        REQUIRE(std::is_sorted(v.cbegin(), v.cend()));
+        REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 25);
+        REQUIRE(std::vector<int>(v.rbegin(), v.rend()) == std::vector<int>{9, 7, 5, 3, 1});
+    }
+
+    SECTION("range-based for over a const vector") {
+        const Vector& view = v;
+        int total = 0;
+        for (const int& value : view) {
+            total += value;
+        }
+        REQUIRE(total == 25);
+        REQUIRE(std::find(view.begin(), view.end(), 9) - view.begin() == 2);
+    }
+
+    SECTION("insert and append with MyVector iterators") {
+        Vector other;
+        other.append(v.begin() + 1, v.begin() + 3);
+        REQUIRE(other.size() == 2);
+        const auto it = other.insert(other.begin() + 1, v.cbegin(), v.cbegin() + 1);
+        REQUIRE(*it == 5);
+        REQUIRE(std::vector<int>(other.begin(), other.end()) == std::vector<int>{3, 5, 9});
+        other.insert(0, v.begin(), v.end()); // literal 0 still selects the index overload
+        REQUIRE(other.size() == 8);
+    }
+}
+
+TEST_CASE("MyVector parallel sort, reduce and transform") {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dis(-1000, 1000);
+    MyVector<int> v;
+    std::vector<int> expected;
+    for (int i = 0; i < 200000; ++i) {
+        const int value = dis(gen);
+        v.push_back(value);
+        expected.push_back(value);
+    }
+
+    SECTION("sort matches std::sort") {
+        parallel::sort(v);
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+        parallel::sort(v, [](int a, int b) { return a > b; });
+        REQUIRE(std::is_sorted(v.begin(), v.end(), [](int a, int b) { return a > b; }));
+    }
+
+    SECTION("reduce with a wider accumulator") {
+        const long long sum = parallel::reduce(v, 0LL);
+        REQUIRE(sum == std::accumulate(expected.begin(), expected.end(), 0LL));
+        const int largest = parallel::reduce(v, v[0], [](int a, int b) { return a > b ? a : b; });
+        REQUIRE(largest == *std::max_element(expected.begin(), expected.end()));
+    }
+
+    SECTION("transform in place and into another vector") {
+        parallel::transform(v, [](int x) { return x * 2; });
+        REQUIRE(v[123] == expected[123] * 2);
+
+        MyVector<std::string> text;
+        parallel::transform(v, text, [](int x) { return std::to_string(x); });
+        REQUIRE(text.size() == v.size());
+        REQUIRE(text[999] == std::to_string(expected[999] * 2));
+    }
+}
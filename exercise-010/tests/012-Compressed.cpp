@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../compressed_vector.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Checks at(), block-wise and full decoding against the original values
+template <typename Vector>
+bool round_trip(const Vector& original, const CompressedIntVector& packed) {
+    if (packed.size() != original.size()) return false;
+    const MyVector<int> restored = packed.to_vector();
+    bool equal = restored.size() == original.size();
+    for (std::size_t i = 0; equal && i < original.size(); ++i) {
+        equal = restored[i] == original[i] && packed.at(i) == original[i];
+    }
+    return equal;
+}
+
+} // namespace
+
+TEST_CASE("CompressedIntVector round trip") {
+    std::mt19937 gen(3);
+
+    SECTION("empty and tiny inputs") {
+        const CompressedIntVector empty(MyVector<int>{});
+        REQUIRE(empty.empty());
+        REQUIRE(empty.block_count() == 0);
+        REQUIRE(empty.to_vector().size() == 0);
+        REQUIRE_THROWS_AS(empty.at(0), std::out_of_range);
+
+        MyVector<int> one;
+        one.push_back(-42);
+        REQUIRE(round_trip(one, CompressedIntVector(one)));
+    }
+
+    SECTION("every bit width, partial last blocks") {
+        for (unsigned bits = 0; bits <= 32; ++bits) {
+            const std::uint32_t range = bits == 32 ? 0xFFFFFFFFu : (std::uint32_t{1} << bits) - 1;
+            std::uniform_int_distribution<std::uint32_t> dis(0, range);
+            MyVector<int> v;
+            for (int i = 0; i < 1000; ++i) {
+                v.push_back(static_cast<int>(dis(gen) - range / 2));
+            }
+            const CompressedIntVector packed(v);
+            REQUIRE(packed.block_count() == 8);
+            REQUIRE(round_trip(v, packed));
+        }
+    }
+
+    SECTION("extreme values") {
+        MyVector<int> v;
+        for (int value : {INT_MIN, INT_MAX, 0, -1, INT_MAX, INT_MIN}) {
+            v.push_back(value);
+        }
+        REQUIRE(round_trip(v, CompressedIntVector(v)));
+    }
+
+    SECTION("sorted sequences use delta coding, including wrap-around gaps") {
+        MyVector<int> ids;
+        int id = INT_MIN;
+        for (int i = 0; i < 5000; ++i) {
+            ids.push_back(id);
+            id += 1 + static_cast<int>(gen() % 4);
+        }
+        ids.push_back(INT_MAX);
+        const CompressedIntVector packed(ids);
+        REQUIRE(round_trip(ids, packed));
+        REQUIRE(packed.compression_ratio() > 6.0);
+    }
+}
+
+TEST_CASE("CompressedIntVector memory and scans") {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> dis(1, 100);
+    MyVector<int> v;
+    long long expected = 0;
+    for (int i = 0; i < 100000; ++i) {
+        v.push_back(dis(gen));
+        expected += v[i];
+    }
+    const CompressedIntVector packed(v);
+
+    // 7 bits per value plus a block header
+    REQUIRE(packed.compression_ratio() > 3.5);
+    REQUIRE(packed.memory_bytes() < v.size() * sizeof(int) / 3);
+    REQUIRE(packed.sum() == expected);
+
+    SECTION("random block access") {
+        int buffer[CompressedIntVector::block_size];
+        const std::size_t last = packed.block_count() - 1;
+        REQUIRE(packed.decode_block(last, buffer) == v.size() - last * CompressedIntVector::block_size);
+        REQUIRE(buffer[0] == v[last * CompressedIntVector::block_size]);
+        REQUIRE(packed.decode_block(17, buffer) == CompressedIntVector::block_size);
+        REQUIRE(buffer[127] == v[17 * CompressedIntVector::block_size + 127]);
+        REQUIRE_THROWS_AS(packed.decode_block(last + 1, buffer), std::out_of_range);
+    }
+}
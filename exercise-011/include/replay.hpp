@@ -0,0 +1,282 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <chrono>    // for std::chrono::steady_clock
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint8_t, uint32_t, uint64_t
+#include <memory>    // for std::allocator
+#include <new>       // for std::bad_alloc
+#include <stdexcept> // for std::out_of_range, std::length_error
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * Trace replay engine for the JSON operation vectors of this exercise.
+ *
+ * A trace is one "case" of the test-vector schema (initial state plus a list of
+ * push_back/resize/at/clear/reserve operations), either loaded from JSON or
+ * generated. Traces are kept in a compact binary form, so millions of operations
+ * replay without JSON overhead. The same trace drives
+ *  - throughput and latency measurements for any vector type (run<Vector>()),
+ *  - a differential check of MyVector against std::vector (differential()),
+ *  - the "expect" block of hand-written cases (check_expectations()).
+ */
+namespace replay {
+
+enum class OpCode : std::uint8_t { PushBack, Resize, At, Clear, Reserve };
+
+// One operation; arg is new_size, index or new_cap depending on the code
+struct Operation {
+    OpCode code;
+    int value;
+    std::size_t arg;
+};
+
+struct Trace {
+    std::string name = "<unnamed>";
+    std::size_t initial_capacity = 0;
+    std::size_t initial_size = 0;
+    std::vector<int> initial_values; // if not empty, replaces initial_size
+    std::vector<Operation> operations;
+    nlohmann::json expect;           // null if the case has no expectations
+};
+
+// Converts one case of the schema; throws std::invalid_argument on malformed input
+Trace parse_case(const nlohmann::json& tc);
+
+// Converts all entries of a document's "cases" array
+std::vector<Trace> parse_traces(const nlohmann::json& doc);
+
+// Inverse of parse_case (without "expect" if the trace has none)
+nlohmann::json to_json(const Trace& trace);
+
+// Schema form of one operation, e.g. {"op": "at", "index": 3}
+nlohmann::json to_json(const Operation& op);
+
+// Operation mix of generated traces, the weights need not add up to one
+struct GeneratorOptions {
+    std::size_t operations = 1000000;
+    std::uint32_t seed = 1;
+    std::size_t max_size = 1 << 16;   // the vector is cleared when it would grow beyond this
+    double push_back = 0.60;
+    double at = 0.30;
+    double resize = 0.04;
+    double reserve = 0.04;
+    double clear = 0.02;
+    double out_of_range = 0.01;       // share of at() calls with an invalid index
+};
+
+// Produces a reproducible random trace with the given mix
+Trace generate(const GeneratorOptions& options);
+
+enum class ErrorKind : std::uint8_t { None, OutOfRange, LengthError, BadAlloc, Other };
+
+// Name used in the "errors" list of the schema ("out_of_range", ...)
+const char* error_name(ErrorKind kind) noexcept;
+
+// Observable outcome of one operation, compared in differential mode
+struct OpResult {
+    ErrorKind error = ErrorKind::None;
+    int read = 0; // value returned by at()
+
+    bool operator==(const OpResult& other) const noexcept {
+        return error == other.error && read == other.read;
+    }
+    bool operator!=(const OpResult& other) const noexcept { return !(*this == other); }
+};
+
+// Applies one operation to any vector with the std::vector/MyVector interface
+template <typename Vector>
+OpResult apply(Vector& v, const Operation& op) {
+    OpResult result;
+    try {
+        switch (op.code) {
+            case OpCode::PushBack: v.push_back(op.value); break;
+            case OpCode::Resize: v.resize(op.arg); break;
+            case OpCode::At: result.read = v.at(op.arg); break;
+            case OpCode::Clear: v.clear(); break;
+            case OpCode::Reserve: v.reserve(op.arg); break;
+        }
+    } catch (const std::out_of_range&) {
+        result.error = ErrorKind::OutOfRange;
+    } catch (const std::length_error&) {
+        result.error = ErrorKind::LengthError;
+    } catch (const std::bad_alloc&) {
+        result.error = ErrorKind::BadAlloc;
+    } catch (const std::exception&) {
+        result.error = ErrorKind::Other;
+    }
+    return result;
+}
+
+// Sets up the initial state of a trace (reserve, then initial values or size)
+template <typename Vector>
+void prepare(Vector& v, const Trace& trace) {
+    if (trace.initial_capacity) v.reserve(trace.initial_capacity);
+    if (!trace.initial_values.empty()) {
+        v.resize(trace.initial_values.size());
+        for (std::size_t i = 0; i < trace.initial_values.size(); ++i) v[i] = trace.initial_values[i];
+    } else if (trace.initial_size) {
+        v.resize(trace.initial_size);
+    }
+}
+
+// Heap traffic of CountingAllocator since the last reset
+struct AllocationStats {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t bytes_allocated = 0;
+    std::size_t peak_bytes = 0; // largest amount of live memory
+};
+
+namespace detail {
+// Replays are single-threaded, plain counters are sufficient
+inline AllocationStats g_allocation_stats;
+inline std::size_t g_live_bytes = 0;
+} // namespace detail
+
+inline AllocationStats allocation_stats() noexcept { return detail::g_allocation_stats; }
+inline void reset_allocation_stats() noexcept {
+    detail::g_allocation_stats = AllocationStats{};
+    detail::g_live_bytes = 0;
+}
+
+// std::allocator that records every allocation in the global AllocationStats
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        T* ptr = std::allocator<T>{}.allocate(n);
+        AllocationStats& stats = detail::g_allocation_stats;
+        ++stats.allocations;
+        stats.bytes_allocated += n * sizeof(T);
+        detail::g_live_bytes += n * sizeof(T);
+        stats.peak_bytes = detail::g_live_bytes > stats.peak_bytes ? detail::g_live_bytes : stats.peak_bytes;
+        return ptr;
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        ++detail::g_allocation_stats.deallocations;
+        detail::g_live_bytes -= n * sizeof(T);
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+// Per-operation latencies in nanoseconds
+struct LatencyStats {
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+};
+
+// Computes the percentiles; reorders samples
+LatencyStats percentiles(std::vector<std::uint32_t>& samples);
+
+struct ReplayOptions {
+    bool latency = true;      // second pass with a clock read around every operation
+    bool record = false;      // keep reads, errors and final values for check_expectations()
+};
+
+struct ReplayResult {
+    std::string container;
+    std::size_t operations = 0;
+    std::size_t errors = 0;
+    std::size_t final_size = 0;
+    std::size_t final_capacity = 0;
+    std::uint64_t checksum = 0; // over all operation results and the final contents
+    double seconds = 0;         // throughput pass without per-operation timing
+    double ops_per_second = 0;
+    LatencyStats latency;
+    AllocationStats allocations; // of the throughput pass
+    nlohmann::json reads = nlohmann::json::array();  // only with ReplayOptions::record
+    nlohmann::json error_log = nlohmann::json::array();
+    std::vector<int> final_values;
+};
+
+// Mixes one operation result into a running checksum (FNV-1a over the fields)
+std::uint64_t mix(std::uint64_t hash, const OpResult& result) noexcept;
+
+// Replays a trace against Vector; use a CountingAllocator-based Vector for allocation numbers
+template <typename Vector>
+ReplayResult run(const Trace& trace, const std::string& container, const ReplayOptions& options = {}) {
+    using clock = std::chrono::steady_clock;
+    ReplayResult result;
+    result.container = container;
+    result.operations = trace.operations.size();
+    result.checksum = 14695981039346656037ull;
+
+    reset_allocation_stats();
+    {
+        Vector v;
+        prepare(v, trace);
+        const auto start = clock::now();
+        for (const Operation& op : trace.operations) {
+            const OpResult r = apply(v, op);
+            result.checksum = mix(result.checksum, r);
+            if (r.error != ErrorKind::None) {
+                ++result.errors;
+                if (options.record) {
+                    nlohmann::json entry = to_json(op);
+                    entry["error"] = error_name(r.error);
+                    result.error_log.push_back(entry);
+                }
+            } else if (options.record && op.code == OpCode::At) {
+                result.reads.push_back({{"index", op.arg}, {"value", r.read}});
+            }
+        }
+        result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        result.final_size = v.size();
+        result.final_capacity = v.capacity();
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            result.checksum = mix(result.checksum, OpResult{ErrorKind::None, v[i]});
+            if (options.record) result.final_values.push_back(v[i]);
+        }
+    }
+    result.allocations = allocation_stats();
+    result.ops_per_second = result.seconds > 0 ? static_cast<double>(result.operations) / result.seconds : 0.0;
+
+    if (options.latency && !trace.operations.empty()) {
+        std::vector<std::uint32_t> samples;
+        samples.reserve(trace.operations.size());
+        Vector v;
+        prepare(v, trace);
+        for (const Operation& op : trace.operations) {
+            const auto start = clock::now();
+            apply(v, op);
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+            samples.push_back(static_cast<std::uint32_t>(ns));
+        }
+        result.latency = percentiles(samples);
+    }
+    return result;
+}
+
+// First operation where MyVector and std::vector disagree
+struct Mismatch {
+    bool found = false;
+    std::size_t operation = 0; // index into Trace::operations, or the operation count for the final state
+    std::string detail;
+};
+
+// Replays the trace on MyVector<int> and std::vector<int> in lock step
+Mismatch differential(const Trace& trace);
+
+// Compares a recorded replay with the "expect" block of its trace; returns the violated rules
+std::vector<std::string> check_expectations(const Trace& trace, const ReplayResult& result);
+
+} // namespace replay
+
+#endif /* REPLAY_HPP */
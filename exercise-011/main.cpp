@@ -1,24 +1,124 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
 #include "CLI/CLI.hpp"
 #include "config.h"
+#include "myvector.hpp"
+#include "replay.hpp"
 
 // for convenience
 using json = nlohmann::json;
 
+namespace {
+
+using CountedMyVector = MyVector<int, replay::CountingAllocator<int>>;
+using CountedStdVector = std::vector<int, replay::CountingAllocator<int>>;
+
+// One table row per container
+void print_result(const replay::ReplayResult& r) {
+    fmt::print("  {:<12} {:>12.0f} {:>8.0f} {:>8.0f} {:>8.0f} {:>8.0f} {:>10} {:>12}\n", r.container,
+               r.ops_per_second, r.latency.p50, r.latency.p99, r.latency.p999, r.latency.max,
+               r.allocations.allocations, r.allocations.bytes_allocated);
+}
+
+json result_to_json(const replay::ReplayResult& r) {
+    return {{"container", r.container},
+            {"operations", r.operations},
+            {"errors", r.errors},
+            {"final_size", r.final_size},
+            {"seconds", r.seconds},
+            {"ops_per_second", r.ops_per_second},
+            {"latency_ns",
+             {{"p50", r.latency.p50}, {"p90", r.latency.p90}, {"p99", r.latency.p99}, {"p999", r.latency.p999},
+              {"max", r.latency.max}}},
+            {"allocations",
+             {{"count", r.allocations.allocations},
+              {"bytes", r.allocations.bytes_allocated},
+              {"peak_bytes", r.allocations.peak_bytes}}}};
+}
+
+// Differential check, expectations and measurements for one trace; returns false on any failure
+bool run_trace(const replay::Trace& trace, bool latency, json& report) {
+    fmt::print("{} ({} operations)\n", trace.name, trace.operations.size());
+
+    const replay::Mismatch mismatch = replay::differential(trace);
+    if (mismatch.found) {
+        fmt::print("  MISMATCH at operation {}: {}\n", mismatch.operation, mismatch.detail);
+    }
+
+    replay::ReplayOptions options;
+    options.latency = latency;
+    options.record = !trace.expect.is_null();
+    const replay::ReplayResult mine = replay::run<CountedMyVector>(trace, "MyVector", options);
+    const replay::ReplayResult reference = replay::run<CountedStdVector>(trace, "std::vector", options);
+
+    const std::vector<std::string> failures = replay::check_expectations(trace, mine);
+    for (const std::string& failure : failures) {
+        fmt::print("  EXPECTATION FAILED: {}\n", failure);
+    }
+
+    fmt::print("  {:<12} {:>12} {:>8} {:>8} {:>8} {:>8} {:>10} {:>12}\n", "container", "ops/s", "p50 ns",
+               "p99 ns", "p999 ns", "max ns", "allocs", "bytes");
+    print_result(mine);
+    print_result(reference);
+    fmt::print("  checksums {}\n\n", mine.checksum == reference.checksum ? "match" : "DIFFER");
+
+    const bool ok = !mismatch.found && failures.empty() && mine.checksum == reference.checksum;
+    report.push_back({{"name", trace.name},
+                      {"ok", ok},
+                      {"mismatch", mismatch.found ? json(mismatch.detail) : json(nullptr)},
+                      {"expectation_failures", failures},
+                      {"results", {result_to_json(mine), result_to_json(reference)}}});
+    return ok;
+}
+
+} // namespace
+
 auto main(int argc, char **argv) -> int
 {
-    /**
-     * CLI11 is a command line parser to add command line options
-     * More info at https://github.com/CLIUtils/CLI11#usage
-     */
     CLI::App app{PROJECT_NAME};
+
+    replay::GeneratorOptions generator;
+    auto add_generator_options = [&generator](CLI::App* cmd) {
+        cmd->add_option("-n,--operations", generator.operations, "Number of generated operations");
+        cmd->add_option("-s,--seed", generator.seed, "Random seed");
+        cmd->add_option("-m,--max-size", generator.max_size, "Largest vector size of the generated trace");
+    };
+
+    // Subcommand for replaying traces (JSON file or generated)
+    auto* replay_cmd = app.add_subcommand("replay", "Replay operation traces against MyVector and std::vector");
+    std::string input;
+    std::string report_file;
+    bool generated = false;
+    bool no_latency = false;
+    replay_cmd->add_option("file", input, "JSON file with a \"cases\" array (test-vector schema)");
+    replay_cmd->add_flag("-g,--generate", generated, "Replay a generated trace instead of a file");
+    replay_cmd->add_flag("--no-latency", no_latency, "Skip the per-operation latency pass");
+    replay_cmd->add_option("-o,--report", report_file, "Write the results as JSON");
+    add_generator_options(replay_cmd);
+
+    // Subcommand for writing a generated trace
+    auto* generate_cmd = app.add_subcommand("generate", "Write a generated trace as JSON");
+    std::string output;
+    generate_cmd->add_option("-o,--output", output, "Output file")->required();
+    add_generator_options(generate_cmd);
+
+    // Subcommand for differential fuzzing with many seeds
+    auto* fuzz_cmd = app.add_subcommand("fuzz", "Compare MyVector with std::vector on many generated traces");
+    std::size_t iterations = 100;
+    fuzz_cmd->add_option("-i,--iterations", iterations, "Number of traces, seeds seed .. seed + iterations - 1");
+    add_generator_options(fuzz_cmd);
+
     try
     {
         app.set_version_flag("-V,--version", fmt::format("{} {}", PROJECT_VER, PROJECT_BUILD_DATE));
+        app.require_subcommand(1);
         app.parse(argc, argv);
     }
     catch (const CLI::ParseError &e)
@@ -26,14 +126,57 @@ auto main(int argc, char **argv) -> int
         return app.exit(e);
     }
 
-    /**
-     * The {fmt} lib is a cross platform library for printing and formatting text
-     * it is much more convenient than std::cout and printf
-     * More info at https://fmt.dev/latest/api.html
-     */
-    fmt::print("Hello, {}!\n", app.get_name());
+    try
+    {
+        if (generate_cmd->parsed()) {
+            const json doc = {{"cases", json::array({replay::to_json(replay::generate(generator))})}};
+            std::ofstream out(output);
+            out << doc.dump() << '\n';
+            fmt::print("wrote {} operations to {}\n", generator.operations, output);
+            return out ? 0 : 1;
+        }
+
+        if (fuzz_cmd->parsed()) {
+            const std::uint32_t first_seed = generator.seed;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                generator.seed = first_seed + static_cast<std::uint32_t>(i);
+                const replay::Mismatch mismatch = replay::differential(replay::generate(generator));
+                if (mismatch.found) {
+                    fmt::print("seed {}: mismatch at operation {}: {}\n", generator.seed, mismatch.operation,
+                               mismatch.detail);
+                    return 1;
+                }
+            }
+            fmt::print("{} traces of {} operations: no mismatch\n", iterations, generator.operations);
+            return 0;
+        }
 
-    /* INSERT YOUR CODE HERE */
+        std::vector<replay::Trace> traces;
+        if (generated) {
+            traces.push_back(replay::generate(generator));
+        } else {
+            std::ifstream in(input);
+            if (!in) {
+                fmt::print(stderr, "cannot open {}\n", input);
+                return 1;
+            }
+            traces = replay::parse_traces(json::parse(in));
+        }
 
-    return 0; /* exit gracefully*/
+        json report = json::array();
+        bool ok = true;
+        for (const replay::Trace& trace : traces) {
+            ok = run_trace(trace, !no_latency, report) && ok;
+        }
+        if (!report_file.empty()) {
+            std::ofstream out(report_file);
+            out << report.dump(2) << '\n';
+        }
+        return ok ? 0 : 1;
+    }
+    catch (const std::exception &e)
+    {
+        fmt::print(stderr, "error: {}\n", e.what());
+        return 1;
+    }
 }
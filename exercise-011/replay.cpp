@@ -0,0 +1,263 @@
+#include "replay.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "myvector.hpp"
+
+namespace replay {
+namespace {
+
+// Reads a required non-negative integer field of an operation or case
+std::size_t size_field(const nlohmann::json& object, const char* key) {
+    if (!object.contains(key) || !object[key].is_number_integer() || object[key].get<long long>() < 0) {
+        throw std::invalid_argument(fmt::format("replay: \"{}\" must be a non-negative integer", key));
+    }
+    return object[key].get<std::size_t>();
+}
+
+// True for integers in the range of int; unsigned values are compared unsigned, so 2^64 - 1 is not -1
+bool is_int(const nlohmann::json& v) {
+    if (v.is_number_unsigned()) {
+        return v.get<unsigned long long>() <= static_cast<unsigned long long>(std::numeric_limits<int>::max());
+    }
+    return v.is_number_integer() && v.get<long long>() >= std::numeric_limits<int>::min() &&
+           v.get<long long>() <= std::numeric_limits<int>::max();
+}
+
+Operation parse_operation(const nlohmann::json& op, const std::string& case_name) {
+    const std::string name = op.value("op", "");
+    if (name == "push_back") {
+        if (!op.contains("value") || !is_int(op["value"])) {
+            throw std::invalid_argument(
+                fmt::format("replay: push_back in case \"{}\" needs an int \"value\"", case_name));
+        }
+        return {OpCode::PushBack, op["value"].get<int>(), 0};
+    }
+    if (name == "resize") return {OpCode::Resize, 0, size_field(op, "new_size")};
+    if (name == "at") return {OpCode::At, 0, size_field(op, "index")};
+    if (name == "clear") return {OpCode::Clear, 0, 0};
+    if (name == "reserve") return {OpCode::Reserve, 0, size_field(op, "new_cap")};
+    throw std::invalid_argument(fmt::format("replay: unknown operation \"{}\"", name));
+}
+
+} // namespace
+
+Trace parse_case(const nlohmann::json& tc) {
+    if (!tc.is_object()) throw std::invalid_argument("replay: a case must be a JSON object");
+    Trace trace;
+    trace.name = tc.value("name", "<unnamed>");
+    if (tc.contains("initial_capacity")) trace.initial_capacity = size_field(tc, "initial_capacity");
+    if (tc.contains("initial_size")) trace.initial_size = size_field(tc, "initial_size");
+    if (tc.contains("initial_values")) {
+        const nlohmann::json& values = tc["initial_values"];
+        if (!values.is_array() || !std::all_of(values.begin(), values.end(), is_int)) {
+            throw std::invalid_argument(
+                fmt::format("replay: \"initial_values\" of case \"{}\" must be an array of int values", trace.name));
+        }
+        for (const auto& value : values) trace.initial_values.push_back(value.get<int>());
+    }
+    if (tc.contains("operations")) {
+        trace.operations.reserve(tc["operations"].size());
+        for (const auto& op : tc["operations"]) trace.operations.push_back(parse_operation(op, trace.name));
+    }
+    if (tc.contains("expect")) {
+        // check_expectations() reads the sizes without further checks
+        const nlohmann::json& expect = tc["expect"];
+        const auto is_size = [&](const char* key) {
+            if (!expect.contains(key)) return true;
+            const nlohmann::json& v = expect[key];
+            return v.is_number_unsigned() || (v.is_number_integer() && v.get<long long>() >= 0);
+        };
+        if (!expect.is_object() || !is_size("final_size") || !is_size("min_capacity")) {
+            throw std::invalid_argument(fmt::format(
+                "replay: \"expect\" of case \"{}\" must be an object with non-negative integer sizes", trace.name));
+        }
+        trace.expect = expect;
+    }
+    return trace;
+}
+
+std::vector<Trace> parse_traces(const nlohmann::json& doc) {
+    if (!doc.contains("cases") || !doc["cases"].is_array()) {
+        throw std::invalid_argument("replay: document has no \"cases\" array");
+    }
+    std::vector<Trace> traces;
+    for (const auto& tc : doc["cases"]) traces.push_back(parse_case(tc));
+    return traces;
+}
+
+nlohmann::json to_json(const Operation& op) {
+    switch (op.code) {
+        case OpCode::PushBack: return {{"op", "push_back"}, {"value", op.value}};
+        case OpCode::Resize: return {{"op", "resize"}, {"new_size", op.arg}};
+        case OpCode::At: return {{"op", "at"}, {"index", op.arg}};
+        case OpCode::Clear: return {{"op", "clear"}};
+        case OpCode::Reserve: return {{"op", "reserve"}, {"new_cap", op.arg}};
+    }
+    return nullptr;
+}
+
+nlohmann::json to_json(const Trace& trace) {
+    nlohmann::json tc = {{"name", trace.name}};
+    if (trace.initial_capacity) tc["initial_capacity"] = trace.initial_capacity;
+    if (!trace.initial_values.empty()) {
+        tc["initial_values"] = trace.initial_values;
+    } else if (trace.initial_size) {
+        tc["initial_size"] = trace.initial_size;
+    }
+    nlohmann::json operations = nlohmann::json::array();
+    for (const Operation& op : trace.operations) operations.push_back(to_json(op));
+    tc["operations"] = std::move(operations);
+    if (!trace.expect.is_null()) tc["expect"] = trace.expect;
+    return tc;
+}
+
+// The generator tracks the size the vector will have, so that most at() calls hit and the
+// remaining ones are out of range by design
+Trace generate(const GeneratorOptions& options) {
+    std::mt19937_64 gen(options.seed);
+    std::uniform_int_distribution<int> values(-1000000, 1000000);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::discrete_distribution<int> kind(
+        {options.push_back, options.at, options.resize, options.reserve, options.clear});
+
+    Trace trace;
+    trace.name = fmt::format("generated-{}-{}", options.operations, options.seed);
+    trace.operations.reserve(options.operations);
+    std::size_t size = 0;
+    const std::size_t limit = options.max_size ? options.max_size : 1;
+    for (std::size_t i = 0; i < options.operations; ++i) {
+        Operation op{OpCode::Clear, 0, 0};
+        switch (kind(gen)) {
+            case 0:
+                if (size < limit) {
+                    op = {OpCode::PushBack, values(gen), 0};
+                    ++size;
+                } else {
+                    size = 0; // keep the footprint bounded
+                }
+                break;
+            case 1:
+                if (size == 0 || chance(gen) < options.out_of_range) {
+                    op = {OpCode::At, 0, size + gen() % 16};
+                } else {
+                    op = {OpCode::At, 0, gen() % size};
+                }
+                break;
+            case 2:
+                size = gen() % (limit + 1);
+                op = {OpCode::Resize, 0, size};
+                break;
+            case 3: op = {OpCode::Reserve, 0, gen() % (2 * limit + 1)}; break;
+            default: size = 0; break;
+        }
+        trace.operations.push_back(op);
+    }
+    return trace;
+}
+
+const char* error_name(ErrorKind kind) noexcept {
+    switch (kind) {
+        case ErrorKind::None: return "none";
+        case ErrorKind::OutOfRange: return "out_of_range";
+        case ErrorKind::LengthError: return "length_error";
+        case ErrorKind::BadAlloc: return "bad_alloc";
+        case ErrorKind::Other: return "exception";
+    }
+    return "exception";
+}
+
+std::uint64_t mix(std::uint64_t hash, const OpResult& result) noexcept {
+    const std::uint64_t fields[2] = {static_cast<std::uint64_t>(result.error),
+                                     static_cast<std::uint64_t>(static_cast<std::uint32_t>(result.read))};
+    for (std::uint64_t field : fields) {
+        hash ^= field;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Nearest-rank percentiles via nth_element, O(n) per percentile
+LatencyStats percentiles(std::vector<std::uint32_t>& samples) {
+    LatencyStats stats;
+    if (samples.empty()) return stats;
+    auto rank = [&samples](double p) {
+        const auto k = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+        return static_cast<double>(samples[k]);
+    };
+    stats.p50 = rank(0.50);
+    stats.p90 = rank(0.90);
+    stats.p99 = rank(0.99);
+    stats.p999 = rank(0.999);
+    stats.max = static_cast<double>(*std::max_element(samples.begin(), samples.end()));
+    return stats;
+}
+
+Mismatch differential(const Trace& trace) {
+    MyVector<int> mine;
+    std::vector<int> reference;
+    prepare(mine, trace);
+    prepare(reference, trace);
+
+    Mismatch mismatch;
+    for (std::size_t i = 0; i < trace.operations.size(); ++i) {
+        const OpResult a = apply(mine, trace.operations[i]);
+        const OpResult b = apply(reference, trace.operations[i]);
+        if (a != b || mine.size() != reference.size()) {
+            mismatch.found = true;
+            mismatch.operation = i;
+            mismatch.detail = fmt::format("{}: MyVector gave {} / {} (size {}), std::vector gave {} / {} (size {})",
+                                          to_json(trace.operations[i]).dump(), error_name(a.error), a.read,
+                                          mine.size(), error_name(b.error), b.read, reference.size());
+            return mismatch;
+        }
+    }
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        if (mine[i] != reference[i]) {
+            mismatch.found = true;
+            mismatch.operation = trace.operations.size();
+            mismatch.detail = fmt::format("final contents differ at index {}: {} vs {}", i, mine[i], reference[i]);
+            return mismatch;
+        }
+    }
+    return mismatch;
+}
+
+// Same rules as the README: exact final_size, capacity only as a lower bound, lists in order
+std::vector<std::string> check_expectations(const Trace& trace, const ReplayResult& result) {
+    std::vector<std::string> failures;
+    const nlohmann::json& expect = trace.expect;
+    if (expect.is_null()) return failures;
+
+    if (!expect.contains("final_size")) {
+        failures.push_back("expect.final_size is missing");
+    } else if (expect["final_size"].get<std::size_t>() != result.final_size) {
+        failures.push_back(fmt::format("final_size: expected {}, got {}", expect["final_size"].get<std::size_t>(),
+                                       result.final_size));
+    }
+    if (expect.contains("min_capacity") && result.final_capacity < expect["min_capacity"].get<std::size_t>()) {
+        failures.push_back(fmt::format("capacity {} is below min_capacity {}", result.final_capacity,
+                                       expect["min_capacity"].get<std::size_t>()));
+    }
+    if (expect.contains("reads") && expect["reads"] != result.reads) {
+        failures.push_back(fmt::format("reads: expected {}, got {}", expect["reads"].dump(), result.reads.dump()));
+    }
+    if (expect.contains("errors") && expect["errors"] != result.error_log) {
+        failures.push_back(
+            fmt::format("errors: expected {}, got {}", expect["errors"].dump(), result.error_log.dump()));
+    }
+    if (expect.contains("final_values") &&
+        expect["final_values"] != nlohmann::json(result.final_values)) {
+        failures.push_back(fmt::format("final_values: expected {}, got {}", expect["final_values"].dump(),
+                                       nlohmann::json(result.final_values).dump()));
+    }
+    return failures;
+}
+
+} // namespace replay
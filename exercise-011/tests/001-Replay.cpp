@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "myvector.hpp"
+#include "replay.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+TEST_CASE("JSON-driven test cases for MyVector<int>", "[json][myvector]") {
+    std::ifstream in(TEST_VECTORS_FILE);
+    REQUIRE(in);
+    const std::vector<replay::Trace> traces = replay::parse_traces(json::parse(in));
+    REQUIRE(traces.size() >= 5);
+
+    replay::ReplayOptions options;
+    options.record = true;
+    options.latency = false;
+    for (const replay::Trace& trace : traces) {
+        DYNAMIC_SECTION(trace.name) {
+            const replay::ReplayResult result = replay::run<MyVector<int>>(trace, "MyVector", options);
+            for (const std::string& failure : replay::check_expectations(trace, result)) {
+                FAIL_CHECK(failure);
+            }
+            REQUIRE_FALSE(replay::differential(trace).found);
+        }
+    }
+}
+
+TEST_CASE("Trace parsing and serialization") {
+    const json tc = {{"name", "round trip"},
+                     {"initial_values", {1, 2}},
+                     {"operations",
+                      {{{"op", "push_back"}, {"value", -3}},
+                       {{"op", "resize"}, {"new_size", 1}},
+                       {{"op", "at"}, {"index", 0}},
+                       {{"op", "reserve"}, {"new_cap", 8}},
+                       {{"op", "clear"}}}}};
+    const replay::Trace trace = replay::parse_case(tc);
+    REQUIRE(trace.operations.size() == 5);
+    REQUIRE(trace.operations[0].code == replay::OpCode::PushBack);
+    REQUIRE(trace.operations[0].value == -3);
+    REQUIRE(replay::to_json(trace) == tc);
+
+    REQUIRE_THROWS_AS(replay::parse_case(json{{"operations", {{{"op", "pop_back"}}}}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(replay::parse_case(json{{"operations", {{{"op", "at"}, {"index", -1}}}}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(replay::parse_traces(json::object()), std::invalid_argument);
+
+    // Malformed initial values name the case instead of leaking a json::type_error
+    for (const json& values : {json{1, "2"}, json{1, 2.5}, json{1, 3000000000LL}, json(7)}) {
+        std::string message;
+        try {
+            replay::parse_case(json{{"name", "bad values"}, {"initial_values", values}});
+        } catch (const std::invalid_argument& e) {
+            message = e.what();
+        }
+        REQUIRE(message.find("\"bad values\"") != std::string::npos);
+    }
+
+    // The same for push_back values beyond int and for malformed expectations
+    const json malformed[] = {
+        {{"name", "bad op"}, {"operations", {{{"op", "push_back"}, {"value", 3000000000LL}}}}},
+        {{"name", "bad op"}, {"operations", {{{"op", "push_back"}, {"value", 18446744073709551615ULL}}}}},
+        {{"name", "bad op"}, {"expect", {{"final_size", "3"}}}},
+        {{"name", "bad op"}, {"expect", {{"final_size", 1}, {"min_capacity", -4}}}},
+        {{"name", "bad op"}, {"expect", {1, 2}}},
+    };
+    for (const json& bad : malformed) {
+        std::string message;
+        try {
+            replay::parse_case(bad);
+        } catch (const std::invalid_argument& e) {
+            message = e.what();
+        }
+        REQUIRE(message.find("\"bad op\"") != std::string::npos);
+    }
+}
+
+TEST_CASE("Generated traces replay identically on MyVector and std::vector") {
+    replay::GeneratorOptions generator;
+    generator.operations = 20000;
+    generator.max_size = 512;
+    for (std::uint32_t seed = 1; seed <= 5; ++seed) {
+        generator.seed = seed;
+        const replay::Trace trace = replay::generate(generator);
+        REQUIRE(trace.operations.size() == generator.operations);
+        const replay::Mismatch mismatch = replay::differential(trace);
+        INFO(mismatch.detail);
+        REQUIRE_FALSE(mismatch.found);
+    }
+
+    // the same seed gives the same trace
+    generator.seed = 7;
+    REQUIRE(replay::to_json(replay::generate(generator)) == replay::to_json(replay::generate(generator)));
+}
+
+TEST_CASE("Replay measurements and allocation counts") {
+    replay::GeneratorOptions generator;
+    generator.operations = 10000;
+    const replay::Trace trace = replay::generate(generator);
+
+    using Counted = MyVector<int, replay::CountingAllocator<int>>;
+    using CountedStd = std::vector<int, replay::CountingAllocator<int>>;
+    const replay::ReplayResult mine = replay::run<Counted>(trace, "MyVector");
+    const replay::ReplayResult reference = replay::run<CountedStd>(trace, "std::vector");
+
+    REQUIRE(mine.operations == 10000);
+    REQUIRE(mine.checksum == reference.checksum);
+    REQUIRE(mine.errors == reference.errors);
+    REQUIRE(mine.errors > 0); // the generator mixes in out-of-range reads
+    REQUIRE(mine.allocations.allocations > 0);
+    REQUIRE(mine.allocations.allocations == mine.allocations.deallocations);
+    REQUIRE(mine.latency.p50 <= mine.latency.p99);
+    REQUIRE(mine.latency.p99 <= mine.latency.max);
+    REQUIRE(mine.ops_per_second > 0);
+}